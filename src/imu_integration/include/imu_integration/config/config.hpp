@@ -50,6 +50,62 @@ struct IMUConfig {
     double acc_noise_stddev;
 };
 
+// runtime reconfigurable subset of IMUConfig, trivially copyable:
+struct IMUParams {
+    // gravity constant:
+    struct {
+        double x;
+        double y;
+        double z;
+    } gravity;
+
+    // bias:
+    struct {
+        struct {
+            double x;
+            double y;
+            double z;
+        } angular_velocity;
+        struct {
+            double x;
+            double y;
+            double z;
+        } linear_acceleration;
+    } bias;
+
+    // noises:
+    double gyro_bias_stddev;
+    double gyro_noise_stddev;
+    double acc_bias_stddev;
+    double acc_noise_stddev;
+};
+
+struct ExtrinsicsConfig {
+    // IMU to body rotation as roll, pitch and yaw in radians:
+    struct {
+        double roll;
+        double pitch;
+        double yaw;
+    } rotation;
+    // IMU origin in body frame, in meters:
+    struct {
+        double x;
+        double y;
+        double z;
+    } lever_arm;
+    // time constant of angular acceleration low-pass in seconds:
+    double angular_acc_time_constant;
+};
+
+struct NonHolonomicConfig {
+    bool enable;
+    // minimum time between updates in seconds:
+    double period;
+    // zero body velocity pseudo-measurement noise in m/s:
+    double lateral_stddev;
+    double vertical_stddev;
+};
+
 struct OdomConfig {
     // general info:
     std::string frame_id;
@@ -57,6 +113,193 @@ struct OdomConfig {
         std::string ground_truth;
         std::string estimation;
     } topic_name;
+    // publish estimation from a pre-serialized buffer:
+    bool preserialized;
+};
+
+struct SyncConfig {
+    // ring buffer capacity per stream:
+    int capacity;
+    // largest distance in seconds from IMU stamp to bracketing odometry:
+    double max_gap;
+    // longest time in seconds an IMU measurement waits for odometry:
+    double max_latency;
+};
+
+struct GroundTruthSplineConfig {
+    bool enable;
+    // knot spacing in seconds:
+    double knot_spacing;
+    // ground truth gap in seconds that restarts the spline:
+    double max_gap;
+    // history kept in seconds:
+    double duration;
+};
+
+struct TimeOffsetConfig {
+    bool enable;
+    // sliding window length in seconds:
+    double window;
+    // resampling rate of angular rate magnitude in Hz:
+    double sample_rate;
+    // largest offset searched, in seconds:
+    double max_offset;
+    // estimation period in seconds:
+    double period;
+    // estimates below this normalized correlation are discarded:
+    double min_correlation;
+    // weight of new estimate in exponential smoothing:
+    double smoothing;
+};
+
+struct WindowConfig {
+    bool enable;
+    std::string topic_name;
+    // minimum time between keyframes in seconds:
+    double keyframe_period;
+    int window_size;
+    int max_iterations;
+    // optimization time budget per keyframe in seconds:
+    double time_budget;
+    // pose factor noise:
+    double position_stddev;
+    double orientation_stddev;
+};
+
+struct HealthConfig {
+    bool enable;
+    // measurement plausibility:
+    double max_linear_acc;
+    double max_angular_vel;
+    // largest |R' * R - I| entry before re-orthonormalization:
+    double max_orthonormality_error;
+};
+
+struct SharedStateConfig {
+    bool enable;
+    // POSIX shared memory object name:
+    std::string name;
+};
+
+struct FlightRecorderConfig {
+    bool enable;
+    // recorded history in seconds:
+    double duration;
+    // upper bound of any recorded stream rate in Hz:
+    double max_rate;
+    // anomaly thresholds:
+    double max_position_jump;
+    double max_imu_gap;
+    // minimum time between anomaly dumps in seconds:
+    double min_dump_interval;
+    std::string directory;
+};
+
+struct TraceConfig {
+    bool enable;
+    std::string file_path;
+    // flush period in seconds:
+    double flush_period;
+};
+
+struct DiagnosticsConfig {
+    bool enable;
+    std::string topic_name;
+    // publish period in seconds:
+    double period;
+};
+
+struct MetricsConfig {
+    bool enable;
+    // localhost HTTP port, 0 disables the endpoint:
+    int port;
+    // textfile-collector output, empty disables the file:
+    std::string textfile_path;
+    // textfile rewrite period in seconds:
+    double period;
+};
+
+struct StressConfig {
+    bool enable;
+    std::string profile;
+    // measurement rate in Hz:
+    double rate;
+    // measurements published back to back per cycle:
+    int burst_size;
+    double reorder_probability;
+    // wall time in seconds a message held for reordering waits for its successor:
+    double max_hold;
+    double duplicate_probability;
+    double drop_probability;
+    // IMU stream is published on this many topics:
+    int num_topics;
+};
+
+struct SensorsConfig {
+    // rates in Hz, 0 disables a sensor:
+    double imu_rate;
+    double ground_truth_rate;
+
+    // position fix in navigation frame:
+    struct {
+        double rate;
+        std::string topic_name;
+        double stddev;
+    } position;
+
+    // magnetometer in IMU frame:
+    struct {
+        double rate;
+        std::string topic_name;
+        // earth magnetic field in navigation frame, in tesla:
+        struct {
+            double x;
+            double y;
+            double z;
+        } field;
+        // take field from magnetic model at ground truth position instead of the constant above:
+        bool use_magnetic_model;
+        double stddev;
+    } magnetometer;
+};
+
+struct MagneticModelConfig {
+    // NOAA .COF file, empty for built-in WMM-2015:
+    std::string cof_file;
+    // navigation frame origin in degrees and meters above WGS-84 ellipsoid:
+    double latitude;
+    double longitude;
+    double altitude;
+    // decimal year at time 0:
+    double decimal_year;
+    // re-evaluation thresholds, in meters and years:
+    double max_distance;
+    double max_time;
+};
+
+struct MagnetometerConfig {
+    bool enable;
+    std::string topic_name;
+    // measurement noise per axis in tesla:
+    double stddev;
+    // largest relative deviation of field magnitude from model before a measurement counts as disturbed:
+    double max_field_error;
+    // normalized heading innovation gate:
+    double max_innovation;
+    double initial_yaw_stddev;
+};
+
+struct SimClockConfig {
+    bool enable;
+    // simulated time before the first measurement in seconds:
+    double start_time;
+    // simulated duration in seconds, 0 runs until shutdown:
+    double duration;
+    // node names that acknowledge every step:
+    std::vector<std::string> consumers;
+    std::string ack_topic;
+    // wall time in seconds to wait for acknowledgements, 0 waits forever:
+    double ack_timeout;
 };
 
 } // namespace imu_integration
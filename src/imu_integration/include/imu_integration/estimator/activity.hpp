@@ -7,6 +7,8 @@
 #define IMU_INTEGRATION_ACTIVITY_HPP_
 
 // common:
+#include <fstream>
+
 #include <ros/ros.h>
 
 #include <Eigen/Dense>
@@ -18,8 +20,53 @@
 // subscribers:
 #include "imu_integration/subscriber/imu_subscriber.hpp"
 #include "imu_integration/subscriber/odom_subscriber.hpp"
+#include "imu_integration/subscriber/magnetometer_subscriber.hpp"
+
+// publishers:
+#include "imu_integration/publisher/odom_publisher.hpp"
 
 #include <nav_msgs/Odometry.h>
+#include <diagnostic_msgs/DiagnosticArray.h>
+
+// synchronization:
+#include "imu_integration/sensor_data/synchronizer.hpp"
+
+// continuous-time ground truth:
+#include "imu_integration/tools/bspline_trajectory.hpp"
+
+// IMU to body extrinsics:
+#include "imu_integration/estimator/extrinsics.hpp"
+
+// non-holonomic constraint:
+#include "imu_integration/estimator/non_holonomic_constraint.hpp"
+
+// magnetometer heading aiding:
+#include "imu_integration/estimator/magnetometer_heading.hpp"
+
+// sliding window optimization:
+#include "imu_integration/estimator/sliding_window_optimizer.hpp"
+
+// numerical health:
+#include "imu_integration/estimator/health_monitor.hpp"
+
+// black-box recording:
+#include "imu_integration/estimator/flight_recorder.hpp"
+
+// time offset estimation:
+#include "imu_integration/estimator/time_offset_estimator.hpp"
+
+// runtime stats:
+#include "imu_integration/tools/runtime_stats.hpp"
+#include "imu_integration/tools/metrics.hpp"
+
+// latest state for local processes:
+#include "imu_integration/tools/shared_state.hpp"
+
+// runtime reconfiguration:
+#include "imu_integration/tools/param_watcher.hpp"
+
+// lockstep simulated time:
+#include "imu_integration/tools/sim_clock.hpp"
 
 namespace imu_integration {
 
@@ -28,16 +75,41 @@ namespace estimator {
 class Activity {
   public:
     Activity(void);
+    ~Activity(void);
     void Init(void);
     bool Run(void);
+    // log throughput & latency summary:
+    void Report(void);
+    // acknowledges every cycle to a simulated clock server, the node should not throttle Run:
+    bool IsOnSimClock(void) const { return static_cast<bool>(sim_clock_ack_ptr_); }
   private:
     // workflow:
     bool ReadData(void);
     bool HasData(void);
     bool UpdatePose(void);
+    /**
+     * @brief  recover from non-finite state within the current cycle, from latest ground truth
+     *         if it is finite, from static alignment otherwise
+     * @param  imu_data, current IMU measurement
+     * @return void
+     */
+    void Reinitialize(const IMUData &imu_data);
+    void UpdateIMUParams(void);
+    bool UpdateWindow(void);
+    void WriteSharedState(void);
     bool PublishPose(void);
+    void PublishMessage(const ros::Time &stamp);
     bool SaveTrajectoryKitti();
     bool SaveTrajectoryTum();
+    /**
+     * @brief  write held back estimates the ground truth spline covers, paired with it
+     * @param  min_pending_time, uncovered estimates before this stamp are dropped, the rest keep waiting
+     * @return void
+     */
+    void WritePendingEstimates(double min_pending_time);
+    void WritePoseTum(std::ofstream &ofs, double time, const Eigen::Matrix4d &pose);
+    void PublishDiagnostics(const ros::WallTimerEvent &event);
+    void RegisterMetrics(void);
 
     // utils:
     /**
@@ -108,6 +180,12 @@ class Activity {
      * @return void
      */
     void UpdatePosition(const double &delta_t, const Eigen::Vector3d &velocity_delta);
+    /**
+     * @brief  get body pose from integrated pose
+     * @param  pose, integrated pose in IMU axes
+     * @return body pose
+     */
+    Eigen::Matrix4d GetBodyPose(const Eigen::Matrix4d &pose) const;
 
   private:
     // node handler:
@@ -115,18 +193,58 @@ class Activity {
 
     // subscriber:
     std::shared_ptr<IMUSubscriber> imu_sub_ptr_;
+    std::shared_ptr<IMUParamsWatcher> imu_params_watcher_ptr_;
     std::shared_ptr<OdomSubscriber> odom_ground_truth_sub_ptr;
     ros::Publisher odom_estimation_pub_;
+    std::shared_ptr<ApproximateTimeSynchronizer<IMUData, OdomData>> synchronizer_ptr_;
+    std::shared_ptr<BSplineTrajectory> ground_truth_spline_ptr_;
+    std::shared_ptr<TimeOffsetEstimator> time_offset_estimator_ptr_;
+    std::shared_ptr<IMUExtrinsics> imu_extrinsics_ptr_;
+    std::shared_ptr<NonHolonomicConstraint> non_holonomic_constraint_ptr_;
+    std::shared_ptr<MagnetometerSubscriber> magnetometer_sub_ptr_;
+    std::shared_ptr<MagnetometerHeading> magnetometer_heading_ptr_;
+    std::shared_ptr<SlidingWindowOptimizer> window_optimizer_ptr_;
+    std::shared_ptr<OdomPublisher> odom_optimized_pub_ptr_;
+    std::shared_ptr<OdomPublisher> odom_estimation_serialized_pub_ptr_;
+    std::shared_ptr<SharedStateWriter> shared_state_writer_ptr_;
+    std::shared_ptr<FlightRecorder> flight_recorder_ptr_;
+    std::shared_ptr<HealthMonitor> health_monitor_ptr_;
+    std::shared_ptr<SimClockAck> sim_clock_ack_ptr_;
 
     // data buffer:
     std::deque<IMUData> imu_data_buff_;
     std::deque<OdomData> odom_data_buff_;
+    std::deque<MagnetometerData> magnetometer_data_buff_;
+    // saved estimates waiting for ground truth spline to cover their stamps, in odometry clock:
+    std::deque<OdomData> pending_estimates_;
+    // saved trajectories in TUM format:
+    std::ofstream ground_truth_ofs_;
+    std::ofstream laser_odom_ofs_;
+    // latest stamps parsed, acknowledged to simulated clock:
+    double last_imu_time_ = 0.0;
+    double last_odom_time_ = 0.0;
+    double last_magnetometer_time_ = 0.0;
 
     // config:
     bool initialized_ = false;
 
     IMUConfig imu_config_;
+    ExtrinsicsConfig extrinsics_config_;
+    NonHolonomicConfig non_holonomic_config_;
+    MagneticModelConfig magnetic_model_config_;
+    MagnetometerConfig magnetometer_config_;
     OdomConfig odom_config_;
+    SyncConfig sync_config_;
+    GroundTruthSplineConfig ground_truth_spline_config_;
+    TimeOffsetConfig time_offset_config_;
+    WindowConfig window_config_;
+    HealthConfig health_config_;
+    SharedStateConfig shared_state_config_;
+    FlightRecorderConfig flight_recorder_config_;
+    TraceConfig trace_config_;
+    DiagnosticsConfig diagnostics_config_;
+    MetricsConfig metrics_config_;
+    SimClockConfig sim_clock_config_;
 
     // a. gravity constant:
     Eigen::Vector3d G_;
@@ -135,13 +253,51 @@ class Activity {
     // c. linear acceleration:
     Eigen::Vector3d linear_acc_bias_;
 
-    // IMU pose estimation:
+    // pose of body reference point in IMU axes:
     Eigen::Matrix4d pose_ = Eigen::Matrix4d::Identity();
     Eigen::Vector3d vel_ = Eigen::Vector3d::Zero();
+    // last state that passed health checks:
+    Eigen::Matrix4d healthy_pose_ = Eigen::Matrix4d::Identity();
     
     nav_msgs::Odometry message_odom_;
     
     double init_time_;
+    // IMU stamp - odometry stamp, applied on synchronization:
+    double time_offset_ = 0.0;
+
+    // runtime stats:
+    struct {
+        LatencyHistogram parse_data;
+        LatencyHistogram update_pose;
+        LatencyHistogram publish_pose;
+        LatencyHistogram save_trajectory;
+    } stage_cpu_time_;
+    // stage timers are only read by diagnostics and metrics:
+    bool stage_timing_ = false;
+    ShardedCounter num_integrated_;
+    ShardedCounter num_dropped_;
+    ShardedCounter num_published_;
+    // delay from IMU measurement stamp to estimation publishing:
+    LatencyHistogram publish_lag_;
+    double start_time_ = 0.0;
+
+    // diagnostics:
+    ros::Publisher diagnostics_pub_;
+    ros::WallTimer diagnostics_timer_;
+    struct {
+        double time = 0.0;
+        uint64_t num_received = 0;
+        uint64_t num_integrated = 0;
+        uint64_t num_dropped = 0;
+        LatencyHistogram::Snapshot parse_data;
+        LatencyHistogram::Snapshot update_pose;
+        LatencyHistogram::Snapshot publish_pose;
+        LatencyHistogram::Snapshot save_trajectory;
+    } diagnostics_prev_;
+
+    // metrics:
+    MetricsRegistry metrics_registry_;
+    std::shared_ptr<MetricsExporter> metrics_exporter_ptr_;
 };
 
 } // namespace estimator
@@ -0,0 +1,115 @@
+/*
+ * @Description: IMU integration over whole measurement arrays, free of ROS
+ * @Date: 2026-10-18 10:52:31
+ */
+#ifndef IMU_INTEGRATION_BATCH_INTEGRATION_HPP_
+#define IMU_INTEGRATION_BATCH_INTEGRATION_HPP_
+
+#include <cstddef>
+
+#include <Eigen/Dense>
+#include <Eigen/Core>
+
+#include "imu_integration/estimator/integration.hpp"
+
+namespace imu_integration {
+
+namespace estimator {
+
+struct BatchIntegrationParams {
+    IntegrationScheme scheme = IntegrationScheme::MIDPOINT;
+    Eigen::Vector3d gravity = Eigen::Vector3d(0.0, 0.0, -9.7942164704);
+    Eigen::Vector3d angular_vel_bias = Eigen::Vector3d::Zero();
+    Eigen::Vector3d linear_acc_bias = Eigen::Vector3d::Zero();
+};
+
+/**
+ * @brief  integrate measurements with the estimator's kernels, every measurement is used.
+ *         Arrays are row-major with one row per measurement, orientation as x, y, z, w,
+ *         so that NumPy arrays can be passed without copies
+ * @param  params, integration params
+ * @param  num_samples, number of measurements
+ * @param  time, stamps, num_samples
+ * @param  angular_velocity, num_samples x 3
+ * @param  linear_acceleration, num_samples x 3
+ * @param  init_pose, pose at first stamp
+ * @param  init_vel, velocity at first stamp
+ * @param  position, output, num_samples x 3
+ * @param  orientation, output, num_samples x 4
+ * @param  velocity, output, num_samples x 3
+ * @return void
+ */
+void IntegrateBatch(
+    const BatchIntegrationParams &params,
+    size_t num_samples, const double *time,
+    const double *angular_velocity, const double *linear_acceleration,
+    const Eigen::Matrix4d &init_pose, const Eigen::Vector3d &init_vel,
+    double *position, double *orientation, double *velocity
+);
+
+// packed sample, time, angular velocity x, y, z, linear acceleration x, y, z:
+static const size_t kPackedSampleSize = 7;
+// packed state, position x, y, z, orientation x, y, z, w, velocity x, y, z:
+static const size_t kPackedStateSize = 10;
+
+/**
+ * @brief  integrate packed measurements with the estimator's kernels, every measurement is used.
+ *         Nothing is allocated, so short windows take microseconds
+ * @param  params, integration params
+ * @param  num_samples, number of measurements
+ * @param  samples, num_samples x kPackedSampleSize
+ * @param  init_pose, pose at first stamp
+ * @param  init_vel, velocity at first stamp
+ * @param  pose, output, pose at last stamp
+ * @param  vel, output, velocity at last stamp
+ * @param  states, optional output, num_samples x kPackedStateSize, skipped if null
+ * @return void
+ */
+void IntegratePacked(
+    const BatchIntegrationParams &params,
+    size_t num_samples, const double *samples,
+    const Eigen::Matrix4d &init_pose, const Eigen::Vector3d &init_vel,
+    Eigen::Matrix4d &pose, Eigen::Vector3d &vel,
+    double *states = nullptr
+);
+
+// sensitivity params, angular velocity bias, linear acceleration bias, gravity and IMU clock scale:
+static const int kIndexParamAngularVelBias = 0;
+static const int kIndexParamLinearAccBias = 3;
+static const int kIndexParamGravity = 6;
+static const int kIndexParamTimeScale = 9;
+static const int kNumSensitivityParams = 10;
+
+// final position, velocity and orientation error applied on the left by sensitivity params:
+typedef Eigen::Matrix<double, 9, kNumSensitivityParams> SensitivityJacobian;
+
+/**
+ * @brief  integrate measurements like IntegrateBatch and differentiate the final state by
+ *         all integration params in the same pass, with forward-mode automatic differentiation
+ *         through the estimator's kernels. Clock scale enters as stamp deltas times (1 + scale error)
+ * @param  params, integration params, the point of linearization
+ * @param  num_samples, number of measurements
+ * @param  time, stamps, num_samples
+ * @param  angular_velocity, num_samples x 3
+ * @param  linear_acceleration, num_samples x 3
+ * @param  init_pose, pose at first stamp
+ * @param  init_vel, velocity at first stamp
+ * @param  pose, output, pose at last stamp
+ * @param  vel, output, velocity at last stamp
+ * @param  jacobian, output, rows position, velocity and orientation, columns in param index order
+ * @return void
+ */
+void IntegrateSensitivity(
+    const BatchIntegrationParams &params,
+    size_t num_samples, const double *time,
+    const double *angular_velocity, const double *linear_acceleration,
+    const Eigen::Matrix4d &init_pose, const Eigen::Vector3d &init_vel,
+    Eigen::Matrix4d &pose, Eigen::Vector3d &vel,
+    SensitivityJacobian &jacobian
+);
+
+} // namespace estimator
+
+} // namespace imu_integration
+
+#endif
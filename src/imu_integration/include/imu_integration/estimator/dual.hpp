@@ -0,0 +1,156 @@
+/*
+ * @Description: fixed-size dual numbers for forward-mode automatic differentiation
+ * @Date: 2026-10-18 10:05:43
+ */
+#ifndef IMU_INTEGRATION_DUAL_HPP_
+#define IMU_INTEGRATION_DUAL_HPP_
+
+#include <cmath>
+#include <limits>
+
+#include <Eigen/Dense>
+#include <Eigen/Core>
+
+namespace imu_integration {
+
+namespace estimator {
+
+//
+// a + v * eps with eps^2 = 0, v holding the partial derivatives by N parameters. Any code
+// generic over its scalar type then yields value and gradient together. Comparisons only
+// look at the value, so branches take the same path as with double
+//
+template <int N>
+struct Dual {
+    typedef Eigen::Matrix<double, N, 1, Eigen::DontAlign> Gradient;
+
+    double a;
+    Gradient v;
+
+    Dual(void) : a(0.0), v(Gradient::Zero()) {}
+    // constant:
+    Dual(double value) : a(value), v(Gradient::Zero()) {}
+    Dual(double value, const Gradient &gradient) : a(value), v(gradient) {}
+
+    /**
+     * @brief  seed an independent variable
+     * @param  value, parameter value
+     * @param  index, parameter index
+     * @return dual with unit partial derivative by itself
+     */
+    static Dual Variable(double value, int index) {
+        Dual x(value);
+        x.v(index) = 1.0;
+        return x;
+    }
+
+    Dual &operator+=(const Dual &y) { a += y.a; v += y.v; return *this; }
+    Dual &operator-=(const Dual &y) { a -= y.a; v -= y.v; return *this; }
+    Dual &operator*=(const Dual &y) { v = y.a * v + a * y.v; a *= y.a; return *this; }
+    Dual &operator/=(const Dual &y) { *this = *this / y; return *this; }
+    Dual &operator+=(double y) { a += y; return *this; }
+    Dual &operator-=(double y) { a -= y; return *this; }
+    Dual &operator*=(double y) { a *= y; v *= y; return *this; }
+    Dual &operator/=(double y) { a /= y; v /= y; return *this; }
+
+    friend Dual operator+(const Dual &x) { return x; }
+    friend Dual operator-(const Dual &x) { return Dual(-x.a, -x.v); }
+
+    friend Dual operator+(const Dual &x, const Dual &y) { return Dual(x.a + y.a, x.v + y.v); }
+    friend Dual operator+(const Dual &x, double y) { return Dual(x.a + y, x.v); }
+    friend Dual operator+(double x, const Dual &y) { return Dual(x + y.a, y.v); }
+
+    friend Dual operator-(const Dual &x, const Dual &y) { return Dual(x.a - y.a, x.v - y.v); }
+    friend Dual operator-(const Dual &x, double y) { return Dual(x.a - y, x.v); }
+    friend Dual operator-(double x, const Dual &y) { return Dual(x - y.a, -y.v); }
+
+    friend Dual operator*(const Dual &x, const Dual &y) { return Dual(x.a * y.a, y.a * x.v + x.a * y.v); }
+    friend Dual operator*(const Dual &x, double y) { return Dual(x.a * y, y * x.v); }
+    friend Dual operator*(double x, const Dual &y) { return Dual(x * y.a, x * y.v); }
+
+    friend Dual operator/(const Dual &x, const Dual &y) {
+        const double a = x.a / y.a;
+        return Dual(a, (x.v - a * y.v) / y.a);
+    }
+    friend Dual operator/(const Dual &x, double y) { return Dual(x.a / y, x.v / y); }
+    friend Dual operator/(double x, const Dual &y) {
+        const double a = x / y.a;
+        return Dual(a, (-a / y.a) * y.v);
+    }
+
+    friend bool operator<(const Dual &x, const Dual &y) { return x.a < y.a; }
+    friend bool operator>(const Dual &x, const Dual &y) { return x.a > y.a; }
+    friend bool operator<=(const Dual &x, const Dual &y) { return x.a <= y.a; }
+    friend bool operator>=(const Dual &x, const Dual &y) { return x.a >= y.a; }
+    friend bool operator==(const Dual &x, const Dual &y) { return x.a == y.a; }
+    friend bool operator!=(const Dual &x, const Dual &y) { return x.a != y.a; }
+
+    // elementary functions, found through argument-dependent lookup by Eigen and generic code:
+    friend Dual sqrt(const Dual &x) {
+        const double a = std::sqrt(x.a);
+        return Dual(a, (0.5 / a) * x.v);
+    }
+    friend Dual sin(const Dual &x) { return Dual(std::sin(x.a), std::cos(x.a) * x.v); }
+    friend Dual cos(const Dual &x) { return Dual(std::cos(x.a), -std::sin(x.a) * x.v); }
+    friend Dual atan2(const Dual &y, const Dual &x) {
+        const double inv = 1.0 / (x.a * x.a + y.a * y.a);
+        return Dual(std::atan2(y.a, x.a), inv * (x.a * y.v - y.a * x.v));
+    }
+    friend Dual acos(const Dual &x) {
+        return Dual(std::acos(x.a), (-1.0 / std::sqrt(1.0 - x.a * x.a)) * x.v);
+    }
+    friend Dual abs(const Dual &x) { return (x.a < 0.0) ? -x : x; }
+    friend Dual fabs(const Dual &x) { return abs(x); }
+    friend bool isfinite(const Dual &x) { return std::isfinite(x.a) && x.v.allFinite(); }
+};
+
+// values and gradients of double and dual scalars alike:
+inline double GetValue(double x) { return x; }
+
+template <int N>
+inline double GetValue(const Dual<N> &x) { return x.a; }
+
+} // namespace estimator
+
+} // namespace imu_integration
+
+namespace Eigen {
+
+template <int N>
+struct NumTraits<imu_integration::estimator::Dual<N>> : GenericNumTraits<double> {
+    typedef imu_integration::estimator::Dual<N> Real;
+    typedef imu_integration::estimator::Dual<N> NonInteger;
+    typedef imu_integration::estimator::Dual<N> Nested;
+    typedef imu_integration::estimator::Dual<N> Literal;
+
+    enum {
+        IsComplex = 0,
+        IsInteger = 0,
+        IsSigned = 1,
+        RequireInitialization = 1,
+        ReadCost = 1 + N,
+        AddCost = 1 + N,
+        MulCost = 1 + 2 * N
+    };
+
+    static inline Real epsilon(void) { return Real(std::numeric_limits<double>::epsilon()); }
+    static inline Real dummy_precision(void) { return Real(1.0e-12); }
+    static inline Real highest(void) { return Real(std::numeric_limits<double>::max()); }
+    static inline Real lowest(void) { return Real(std::numeric_limits<double>::lowest()); }
+    static inline int digits10(void) { return std::numeric_limits<double>::digits10; }
+};
+
+// mixed double and dual expressions:
+template <int N, typename BinaryOp>
+struct ScalarBinaryOpTraits<imu_integration::estimator::Dual<N>, double, BinaryOp> {
+    typedef imu_integration::estimator::Dual<N> ReturnType;
+};
+
+template <int N, typename BinaryOp>
+struct ScalarBinaryOpTraits<double, imu_integration::estimator::Dual<N>, BinaryOp> {
+    typedef imu_integration::estimator::Dual<N> ReturnType;
+};
+
+} // namespace Eigen
+
+#endif
@@ -0,0 +1,129 @@
+/*
+ * @Description: error-state Kalman filter over IMU integration with position updates
+ * @Date: 2026-10-18 10:27:15
+ */
+#ifndef IMU_INTEGRATION_ERROR_STATE_FILTER_HPP_
+#define IMU_INTEGRATION_ERROR_STATE_FILTER_HPP_
+
+#include <Eigen/Dense>
+#include <Eigen/Core>
+
+#include "imu_integration/sensor_data/imu_data.hpp"
+#include "imu_integration/sensor_data/odom_data.hpp"
+
+namespace imu_integration {
+
+namespace estimator {
+
+// error state, position, velocity and orientation in navigation frame:
+static const int kErrorStateDim = 9;
+static const int kIndexErrorPos = 0;
+static const int kIndexErrorVel = 3;
+static const int kIndexErrorOri = 6;
+
+typedef Eigen::Matrix<double, kErrorStateDim, 1> ErrorState;
+typedef Eigen::Matrix<double, kErrorStateDim, kErrorStateDim> ErrorStateCovariance;
+
+struct FilterState {
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    double time = 0.0;
+    Eigen::Matrix3d R = Eigen::Matrix3d::Identity();
+    Eigen::Vector3d t = Eigen::Vector3d::Zero();
+    Eigen::Vector3d v = Eigen::Vector3d::Zero();
+    ErrorStateCovariance P = ErrorStateCovariance::Identity();
+
+    /**
+     * @brief  inject error state, orientation error is applied on the left, R = Exp(dtheta) * R
+     * @param  dx, error state
+     * @return void
+     */
+    void Inject(const ErrorState &dx);
+    /**
+     * @brief  error state from other to this
+     * @param  other, reference state
+     * @return error state dx such that other.Inject(dx) equals this
+     */
+    ErrorState Minus(const FilterState &other) const;
+};
+
+class ErrorStateFilter {
+  public:
+    struct Params {
+        Eigen::Vector3d gravity = Eigen::Vector3d(0.0, 0.0, -9.7942164704);
+        Eigen::Vector3d angular_vel_bias = Eigen::Vector3d::Zero();
+        Eigen::Vector3d linear_acc_bias = Eigen::Vector3d::Zero();
+        // per measurement noise:
+        double gyro_noise_stddev = 0.015;
+        double acc_noise_stddev = 0.019;
+        // position measurement noise:
+        double position_stddev = 0.01;
+    };
+
+    explicit ErrorStateFilter(const Params &params);
+
+    /**
+     * @brief  initialize state from odometry
+     * @param  odom_data, odometry synchronized to imu_data
+     * @param  imu_data, first IMU measurement
+     * @param  P, initial error state covariance
+     * @return void
+     */
+    void Init(const OdomData &odom_data, const IMUData &imu_data, const ErrorStateCovariance &P);
+    /**
+     * @brief  propagate state and covariance to the stamp of new IMU measurement
+     * @param  imu_data, new IMU measurement
+     * @return void
+     */
+    void Predict(const IMUData &imu_data);
+    /**
+     * @brief  position update at current state stamp
+     * @param  position, measured position in navigation frame
+     * @return void
+     */
+    void Correct(const Eigen::Vector3d &position);
+
+    const FilterState &GetState(void) const { return state_; }
+    const IMUData &GetIMUData(void) const { return imu_data_; }
+
+    /**
+     * @brief  mid-value propagation shared by filter and smoother
+     * @param  params, filter params
+     * @param  state, state at imu_data_prev
+     * @param  imu_data_prev, IMU measurement at state stamp
+     * @param  imu_data_curr, IMU measurement at predicted stamp
+     * @param  state_pred, output, predicted state and covariance
+     * @param  F, output, error state transition
+     * @return void
+     */
+    static void Propagate(
+        const Params &params,
+        const FilterState &state, const IMUData &imu_data_prev, const IMUData &imu_data_curr,
+        FilterState &state_pred, ErrorStateCovariance &F
+    );
+    /**
+     * @brief  error state transition and process noise of one mid-value step
+     * @param  params, filter params
+     * @param  delta_t, step length
+     * @param  specific_force, mean specific force over the step in navigation frame
+     * @param  F, output, error state transition
+     * @param  Q, output, process noise
+     * @return void
+     */
+    static void GetTransition(
+        const Params &params, double delta_t, const Eigen::Vector3d &specific_force,
+        ErrorStateCovariance &F, ErrorStateCovariance &Q
+    );
+
+  private:
+    const Params params_;
+
+    FilterState state_;
+    IMUData imu_data_;
+};
+
+} // namespace estimator
+
+} // namespace imu_integration
+
+#endif
@@ -0,0 +1,99 @@
+/*
+ * @Description: IMU to body extrinsics, lever arm compensation of measurements
+ * @Date: 2026-10-18 10:12:37
+ */
+#ifndef IMU_INTEGRATION_EXTRINSICS_HPP_
+#define IMU_INTEGRATION_EXTRINSICS_HPP_
+
+#include <Eigen/Dense>
+#include <Eigen/Core>
+
+#include "imu_integration/sensor_data/imu_data.hpp"
+
+namespace imu_integration {
+
+namespace estimator {
+
+//
+// The lever arm is removed from the measurements, so that integration tracks the body
+// reference point, still in IMU axes. What is left for output is a constant rotation,
+// applied to the 3-by-3 block of the pose only
+//
+class IMUExtrinsics {
+  public:
+    /**
+     * @brief  precompute transforms
+     * @param  R_body_imu, IMU to body rotation
+     * @param  lever_arm, IMU origin in body frame
+     * @param  angular_acc_time_constant, time constant of angular acceleration low-pass in seconds
+     */
+    IMUExtrinsics(
+        const Eigen::Matrix3d &R_body_imu, const Eigen::Vector3d &lever_arm,
+        double angular_acc_time_constant
+    ) : R_imu_body_(R_body_imu.transpose()),
+        // from IMU origin to body reference point, in IMU axes:
+        lever_arm_(-R_body_imu.transpose() * lever_arm),
+        angular_acc_time_constant_(angular_acc_time_constant) {}
+
+    /**
+     * @brief  move linear acceleration measurement from IMU origin to body reference point
+     * @param  angular_vel_bias, angular velocity bias
+     * @param  imu_data, IMU measurement, compensated in place
+     * @return void
+     */
+    void Compensate(const Eigen::Vector3d &angular_vel_bias, IMUData &imu_data) {
+        const Eigen::Vector3d angular_vel = imu_data.angular_velocity - angular_vel_bias;
+
+        // angular acceleration from backward difference, low-passed against gyro noise:
+        const double delta_t = imu_data.time - prev_time_;
+        if (initialized_ && delta_t > 0.0) {
+            const double gain = delta_t / (angular_acc_time_constant_ + delta_t);
+            angular_acc_ += gain * ((angular_vel - prev_angular_vel_) / delta_t - angular_acc_);
+        }
+        prev_time_ = imu_data.time;
+        prev_angular_vel_ = angular_vel;
+        initialized_ = true;
+
+        // tangential and centripetal terms:
+        imu_data.linear_acceleration += angular_acc_.cross(lever_arm_) + angular_vel.cross(angular_vel.cross(lever_arm_));
+    }
+
+    /**
+     * @brief  get body pose from integrated pose in IMU axes
+     * @param  pose, integrated pose of body reference point in IMU axes
+     * @return body pose
+     */
+    Eigen::Matrix4d GetBodyPose(const Eigen::Matrix4d &pose) const {
+        Eigen::Matrix4d body_pose = pose;
+        body_pose.block<3, 3>(0, 0) = pose.block<3, 3>(0, 0) * R_imu_body_;
+        return body_pose;
+    }
+
+    /**
+     * @brief  get pose of body reference point in IMU axes from body pose
+     * @param  body_pose, body pose
+     * @return pose in IMU axes
+     */
+    Eigen::Matrix4d GetIMUPose(const Eigen::Matrix4d &body_pose) const {
+        Eigen::Matrix4d pose = body_pose;
+        pose.block<3, 3>(0, 0) = body_pose.block<3, 3>(0, 0) * R_imu_body_.transpose();
+        return pose;
+    }
+
+  private:
+    Eigen::Matrix3d R_imu_body_;
+    Eigen::Vector3d lever_arm_;
+    double angular_acc_time_constant_;
+
+    // angular rate differentiation:
+    bool initialized_ = false;
+    double prev_time_ = 0.0;
+    Eigen::Vector3d prev_angular_vel_ = Eigen::Vector3d::Zero();
+    Eigen::Vector3d angular_acc_ = Eigen::Vector3d::Zero();
+};
+
+} // namespace estimator
+
+} // namespace imu_integration
+
+#endif
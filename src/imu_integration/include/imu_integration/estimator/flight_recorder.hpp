@@ -0,0 +1,200 @@
+/*
+ * @Description: black-box recorder of raw measurements and estimator states
+ * @Date: 2026-10-18 10:23:46
+ */
+#ifndef IMU_INTEGRATION_FLIGHT_RECORDER_HPP_
+#define IMU_INTEGRATION_FLIGHT_RECORDER_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ros/ros.h>
+#include <std_srvs/Trigger.h>
+
+#include <Eigen/Dense>
+#include <Eigen/Core>
+
+#include "imu_integration/sensor_data/imu_data.hpp"
+#include "imu_integration/sensor_data/odom_data.hpp"
+#include "imu_integration/tools/runtime_stats.hpp"
+
+namespace imu_integration {
+
+namespace estimator {
+
+//
+// dump file layout, little endian:
+//   FlightRecorder::FileHeader
+//   FlightRecorder::IMURecord  x num_imu_records
+//   FlightRecorder::PoseRecord x num_odom_records, ground truth odometry
+//   FlightRecorder::PoseRecord x num_state_records, estimator states
+//
+class FlightRecorder {
+  public:
+    struct Params {
+        // recorded history in seconds:
+        double duration = 10.0;
+        // upper bound of any recorded stream rate in Hz, sizes the rings:
+        double max_rate = 1000.0;
+        // anomaly detectors:
+        double max_position_jump = 1.0;
+        double max_imu_gap = 0.1;
+        // triggers closer than this to the previous dump, in seconds, are ignored:
+        double min_dump_interval = 10.0;
+        std::string directory = "/tmp";
+    };
+
+    enum class Trigger : uint32_t {
+        NONE = 0,
+        NAN_STATE,
+        POSITION_JUMP,
+        IMU_GAP,
+        REQUEST
+    };
+
+    struct IMURecord {
+        double time;
+        double angular_velocity[3];
+        double linear_acceleration[3];
+    };
+
+    struct PoseRecord {
+        double time;
+        double position[3];
+        // x, y, z, w:
+        double orientation[4];
+        double velocity[3];
+    };
+
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t trigger;
+        double trigger_time;
+        uint64_t num_imu_records;
+        uint64_t num_odom_records;
+        uint64_t num_state_records;
+    };
+
+    FlightRecorder(ros::NodeHandle &nh, const Params &params);
+    ~FlightRecorder(void);
+    FlightRecorder(const FlightRecorder &) = delete;
+    FlightRecorder &operator=(const FlightRecorder &) = delete;
+
+    /**
+     * @brief  record raw IMU measurement, checks for stamp gaps, estimator thread only
+     * @param  imu_data, raw IMU measurement
+     * @return void
+     */
+    void AddIMUData(const IMUData &imu_data);
+    void AddOdomData(const OdomData &odom_data);
+    /**
+     * @brief  record estimator state, checks for NaN and position jumps, estimator thread only
+     * @param  time, state stamp
+     * @param  pose, body pose
+     * @param  vel, velocity in navigation frame
+     * @return void
+     */
+    void AddState(double time, const Eigen::Matrix4d &pose, const Eigen::Vector3d &vel);
+    /**
+     * @brief  report anomaly detected elsewhere, estimator thread only
+     * @param  trigger, anomaly
+     * @param  time, anomaly stamp
+     * @return void
+     */
+    void SetTrigger(Trigger trigger, double time);
+    /**
+     * @brief  hand a snapshot over to the dump thread if an anomaly or a request is pending,
+     *         estimator thread only
+     * @return true if a dump was started false otherwise
+     */
+    bool Update(void);
+
+    const ShardedCounter &GetNumTriggers(void) const { return num_triggers_; }
+    const ShardedCounter &GetNumDumps(void) const { return num_dumps_; }
+
+  private:
+    template <typename T>
+    class RecordRing {
+      public:
+        explicit RecordRing(size_t capacity) : records_(capacity) {}
+
+        void Push(const T &record) {
+            records_[count_ % records_.size()] = record;
+            ++count_;
+        }
+
+        /**
+         * @brief  copy records not older than start_time, oldest first
+         * @param  start_time, oldest stamp copied
+         * @param  output, preallocated to capacity, records are written from the front
+         * @return number of records copied
+         */
+        size_t Copy(double start_time, std::vector<T> &output) const {
+            const size_t size = std::min<uint64_t>(count_, records_.size());
+            size_t num_copied = 0;
+            for (uint64_t i = count_ - size; i < count_; ++i) {
+                const T &record = records_[i % records_.size()];
+                if (record.time >= start_time) {
+                    output[num_copied++] = record;
+                }
+            }
+            return num_copied;
+        }
+
+      private:
+        std::vector<T> records_;
+        uint64_t count_ = 0;
+    };
+
+    bool DumpCallback(std_srvs::Trigger::Request &request, std_srvs::Trigger::Response &response);
+    void Loop(void);
+    void WriteDump(void);
+
+    static const char *GetTriggerName(Trigger trigger);
+
+    const Params params_;
+
+    ros::NodeHandle nh_;
+    ros::ServiceServer service_;
+    std::atomic<bool> dump_requested_{false};
+
+    // estimator thread:
+    RecordRing<IMURecord> imu_records_;
+    RecordRing<PoseRecord> odom_records_;
+    RecordRing<PoseRecord> state_records_;
+    double latest_time_ = 0.0;
+    double prev_imu_time_ = -1.0;
+    Eigen::Vector3d prev_position_ = Eigen::Vector3d::Zero();
+    bool has_state_ = false;
+    Trigger trigger_ = Trigger::NONE;
+    double trigger_time_ = 0.0;
+    double prev_dump_time_ = -1.0e9;
+
+    // snapshot owned by the dump thread while dump_pending_ is set:
+    FileHeader snapshot_header_;
+    std::vector<IMURecord> snapshot_imu_;
+    std::vector<PoseRecord> snapshot_odom_;
+    std::vector<PoseRecord> snapshot_state_;
+    std::atomic<bool> dump_pending_{false};
+
+    std::atomic<bool> running_{true};
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::thread thread_;
+
+    ShardedCounter num_triggers_;
+    ShardedCounter num_dumps_;
+};
+
+} // namespace estimator
+
+} // namespace imu_integration
+
+#endif
@@ -0,0 +1,142 @@
+/*
+ * @Description: per-sample numerical health checks of measurements and integrated state
+ * @Date: 2026-10-18 15:37:02
+ */
+#ifndef IMU_INTEGRATION_HEALTH_MONITOR_HPP_
+#define IMU_INTEGRATION_HEALTH_MONITOR_HPP_
+
+#include <cstdint>
+
+#include <Eigen/Dense>
+#include <Eigen/Core>
+
+#include "imu_integration/sensor_data/imu_data.hpp"
+#include "imu_integration/tools/runtime_stats.hpp"
+
+namespace imu_integration {
+
+namespace estimator {
+
+//
+// Every check is evaluated unconditionally and folded into a bit mask, so a healthy sample
+// costs one well-predicted branch on the mask. Non-finite values are detected through
+// x - x, which is 0 for finite x and NaN otherwise
+//
+class HealthMonitor {
+  public:
+    struct Params {
+        // measurement plausibility:
+        double max_linear_acc = 160.0;
+        double max_angular_vel = 35.0;
+        // largest |R' * R - I| entry before re-orthonormalization:
+        double max_orthonormality_error = 1.0e-9;
+    };
+
+    enum Flag : uint32_t {
+        NON_FINITE_INPUT = 1u << 0,
+        IMPLAUSIBLE_INPUT = 1u << 1,
+        NON_FINITE_STATE = 1u << 2,
+        ORTHONORMALITY_DRIFT = 1u << 3
+    };
+
+    explicit HealthMonitor(const Params &params)
+        : params_(params),
+        max_linear_acc_squared_(params.max_linear_acc * params.max_linear_acc),
+        max_angular_vel_squared_(params.max_angular_vel * params.max_angular_vel) {}
+
+    /**
+     * @brief  check raw measurement
+     * @param  imu_data, IMU measurement
+     * @return mask of NON_FINITE_INPUT and IMPLAUSIBLE_INPUT, 0 if healthy
+     */
+    uint32_t CheckInput(const IMUData &imu_data) const {
+        const double linear_acc_squared = imu_data.linear_acceleration.squaredNorm();
+        const double angular_vel_squared = imu_data.angular_velocity.squaredNorm();
+        const double sum = linear_acc_squared + angular_vel_squared;
+
+        // non-finite input is not reported as implausible too:
+        const bool finite = (sum - sum == 0.0);
+        return
+            (static_cast<uint32_t>(!finite) * NON_FINITE_INPUT) |
+            (static_cast<uint32_t>(
+                finite & ((linear_acc_squared > max_linear_acc_squared_) | (angular_vel_squared > max_angular_vel_squared_))
+            ) * IMPLAUSIBLE_INPUT);
+    }
+
+    /**
+     * @brief  check integration step and resulting state
+     * @param  angular_delta, effective rotation of the step
+     * @param  velocity_delta, effective velocity change of the step
+     * @param  pose, integrated pose
+     * @param  vel, integrated velocity
+     * @return mask of NON_FINITE_STATE and ORTHONORMALITY_DRIFT, 0 if healthy
+     */
+    uint32_t CheckState(
+        const Eigen::Vector3d &angular_delta, const Eigen::Vector3d &velocity_delta,
+        const Eigen::Matrix4d &pose, const Eigen::Vector3d &vel
+    ) const {
+        const double sum = angular_delta.sum() + velocity_delta.sum() + pose.sum() + vel.sum();
+
+        const Eigen::Matrix3d R = pose.block<3, 3>(0, 0);
+        const double orthonormality_error =
+            (R.transpose() * R - Eigen::Matrix3d::Identity()).cwiseAbs().maxCoeff();
+
+        return
+            (static_cast<uint32_t>(!(sum - sum == 0.0)) * NON_FINITE_STATE) |
+            (static_cast<uint32_t>(orthonormality_error > params_.max_orthonormality_error) * ORTHONORMALITY_DRIFT);
+    }
+
+    /**
+     * @brief  count triggers of an unhealthy mask
+     * @param  flags, mask from CheckInput or CheckState
+     * @return void
+     */
+    void Count(uint32_t flags) {
+        if (flags & NON_FINITE_INPUT) {
+            num_non_finite_input_.Add();
+        }
+        if (flags & IMPLAUSIBLE_INPUT) {
+            num_implausible_input_.Add();
+        }
+        if (flags & NON_FINITE_STATE) {
+            num_non_finite_state_.Add();
+        }
+        if (flags & ORTHONORMALITY_DRIFT) {
+            num_orthonormality_drift_.Add();
+        }
+    }
+
+    void CountReinitialization(void) { num_reinitializations_.Add(); }
+
+    /**
+     * @brief  project onto SO(3) through the closest unit quaternion
+     * @param  R, rotation, orthonormalized in place
+     * @return void
+     */
+    static void Orthonormalize(Eigen::Matrix3d &R) {
+        R = Eigen::Quaterniond(R).normalized().toRotationMatrix();
+    }
+
+    const ShardedCounter &GetNumNonFiniteInput(void) const { return num_non_finite_input_; }
+    const ShardedCounter &GetNumImplausibleInput(void) const { return num_implausible_input_; }
+    const ShardedCounter &GetNumNonFiniteState(void) const { return num_non_finite_state_; }
+    const ShardedCounter &GetNumOrthonormalityDrift(void) const { return num_orthonormality_drift_; }
+    const ShardedCounter &GetNumReinitializations(void) const { return num_reinitializations_; }
+
+  private:
+    const Params params_;
+    const double max_linear_acc_squared_;
+    const double max_angular_vel_squared_;
+
+    ShardedCounter num_non_finite_input_;
+    ShardedCounter num_implausible_input_;
+    ShardedCounter num_non_finite_state_;
+    ShardedCounter num_orthonormality_drift_;
+    ShardedCounter num_reinitializations_;
+};
+
+} // namespace estimator
+
+} // namespace imu_integration
+
+#endif
@@ -0,0 +1,172 @@
+/*
+ * @Description: IMU integration kernels shared by the estimator and its benchmarks
+ * @Date: 2026-10-18 09:40:12
+ */
+#ifndef IMU_INTEGRATION_INTEGRATION_HPP_
+#define IMU_INTEGRATION_INTEGRATION_HPP_
+
+#include <cmath>
+
+#include <Eigen/Dense>
+#include <Eigen/Core>
+
+namespace imu_integration {
+
+namespace estimator {
+
+enum class IntegrationScheme {
+    MIDPOINT,
+    EULER
+};
+
+//
+// Kernels are generic over the scalar type T, double for estimation and a dual number from
+// dual.hpp to differentiate a replay by its parameters, see IntegrateSensitivity
+//
+template <typename T>
+using Vector3 = Eigen::Matrix<T, 3, 1>;
+
+template <typename T>
+using Matrix3 = Eigen::Matrix<T, 3, 3>;
+
+// T is deduced from scalar and in-out arguments only, so that Eigen expressions convert to the rest:
+template <typename T>
+struct NonDeduced {
+    typedef T Type;
+};
+
+/**
+ * @brief  get unbiased angular velocity in body frame
+ * @param  angular_vel, angular velocity measurement
+ * @param  angular_vel_bias, angular velocity bias
+ * @return unbiased angular velocity in body frame
+ */
+template <typename T>
+inline Vector3<T> GetUnbiasedAngularVel(
+    const typename NonDeduced<Vector3<T>>::Type &angular_vel, const Vector3<T> &angular_vel_bias
+) {
+    return angular_vel - angular_vel_bias;
+}
+
+/**
+ * @brief  get unbiased linear acceleration in navigation frame
+ * @param  linear_acc, linear acceleration measurement
+ * @param  R, corresponding orientation of measurement
+ * @param  linear_acc_bias, linear acceleration bias
+ * @param  G, gravity in navigation frame
+ * @return unbiased linear acceleration in navigation frame
+ */
+template <typename T>
+inline Vector3<T> GetUnbiasedLinearAcc(
+    const typename NonDeduced<Vector3<T>>::Type &linear_acc, const typename NonDeduced<Matrix3<T>>::Type &R,
+    const Vector3<T> &linear_acc_bias, const Vector3<T> &G
+) {
+    return R*(linear_acc - linear_acc_bias) - G;
+}
+
+/**
+ * @brief  get angular delta between two measurements
+ * @param  scheme, integration scheme
+ * @param  angular_vel_curr, unbiased angular velocity of current measurement
+ * @param  angular_vel_prev, unbiased angular velocity of previous measurement
+ * @param  delta_t, timestamp delta
+ * @return angular delta
+ */
+template <typename T>
+inline Vector3<T> GetAngularDelta(
+    const IntegrationScheme scheme,
+    const typename NonDeduced<Vector3<T>>::Type &angular_vel_curr,
+    const typename NonDeduced<Vector3<T>>::Type &angular_vel_prev,
+    const T &delta_t
+) {
+    if (IntegrationScheme::EULER == scheme) {
+        return delta_t*angular_vel_prev;
+    }
+
+    return 0.5*delta_t*(angular_vel_curr + angular_vel_prev);
+}
+
+/**
+ * @brief  get velocity delta between two measurements
+ * @param  scheme, integration scheme
+ * @param  linear_acc_curr, unbiased linear acceleration in navigation frame of current measurement
+ * @param  linear_acc_prev, unbiased linear acceleration in navigation frame of previous measurement
+ * @param  delta_t, timestamp delta
+ * @return velocity delta
+ */
+template <typename T>
+inline Vector3<T> GetVelocityDelta(
+    const IntegrationScheme scheme,
+    const typename NonDeduced<Vector3<T>>::Type &linear_acc_curr,
+    const typename NonDeduced<Vector3<T>>::Type &linear_acc_prev,
+    const T &delta_t
+) {
+    if (IntegrationScheme::EULER == scheme) {
+        return delta_t*linear_acc_prev;
+    }
+
+    return 0.5*delta_t*(linear_acc_curr + linear_acc_prev);
+}
+
+/**
+ * @brief  update orientation with effective rotation angular_delta
+ * @param  angular_delta, effective rotation
+ * @param  R, orientation, updated in place
+ * @return void
+ */
+template <typename T>
+inline void UpdateOrientation(const typename NonDeduced<Vector3<T>>::Type &angular_delta, Matrix3<T> &R) {
+    using std::cos;
+    using std::sin;
+    using std::sqrt;
+
+    // magnitude:
+    const T angular_delta_mag2 = angular_delta.squaredNorm();
+
+    // build delta q, sin(|phi|/2)/|phi| by its series near zero, where |phi| has no derivative:
+    T angular_delta_cos, angular_delta_sinc;
+    if (angular_delta_mag2 < T(1.0e-12)) {
+        angular_delta_cos = 1.0 - angular_delta_mag2/8.0;
+        angular_delta_sinc = 0.5 - angular_delta_mag2/48.0;
+    } else {
+        const T angular_delta_mag = sqrt(angular_delta_mag2);
+        angular_delta_cos = cos(angular_delta_mag/2.0);
+        angular_delta_sinc = sin(angular_delta_mag/2.0)/angular_delta_mag;
+    }
+    Eigen::Quaternion<T> dq(
+        angular_delta_cos,
+        angular_delta_sinc*angular_delta.x(),
+        angular_delta_sinc*angular_delta.y(),
+        angular_delta_sinc*angular_delta.z()
+    );
+    Eigen::Quaternion<T> q(R);
+
+    // update:
+    q = q*dq;
+
+    // write back:
+    R = q.normalized().toRotationMatrix();
+}
+
+/**
+ * @brief  update position and velocity with effective velocity change velocity_delta
+ * @param  delta_t, timestamp delta
+ * @param  velocity_delta, effective velocity change
+ * @param  t, position, updated in place
+ * @param  v, velocity, updated in place
+ * @return void
+ */
+template <typename T>
+inline void UpdatePosition(
+    const typename NonDeduced<T>::Type &delta_t, const typename NonDeduced<Vector3<T>>::Type &velocity_delta,
+    Vector3<T> &t, Vector3<T> &v
+) {
+    t += delta_t*v + 0.5*delta_t*velocity_delta;
+    v += velocity_delta;
+}
+
+} // namespace estimator
+
+} // namespace imu_integration
+
+#endif
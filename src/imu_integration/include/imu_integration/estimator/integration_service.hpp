@@ -0,0 +1,62 @@
+/*
+ * @Description: stateless IMU integration as a ROS service
+ * @Date: 2026-10-18 14:08:52
+ */
+#ifndef IMU_INTEGRATION_INTEGRATION_SERVICE_HPP_
+#define IMU_INTEGRATION_INTEGRATION_SERVICE_HPP_
+
+#include <string>
+
+#include <ros/ros.h>
+
+#include "imu_integration/IntegrateIMU.h"
+#include "imu_integration/estimator/batch_integration.hpp"
+#include "imu_integration/tools/runtime_stats.hpp"
+
+namespace imu_integration {
+
+namespace estimator {
+
+/**
+ * @brief  advertises imu_integration/IntegrateIMU on top of IntegratePacked. Calls share
+ *         no state, so the service may be served from any number of spinner threads
+ */
+class IntegrationService {
+  public:
+    IntegrationService(ros::NodeHandle &nh, const std::string &service_name);
+
+    const ShardedCounter &GetNumCalls(void) const { return num_calls_; }
+    const ShardedCounter &GetNumFailures(void) const { return num_failures_; }
+    const LatencyHistogram &GetCallCPUTime(void) const { return call_cpu_time_; }
+
+  private:
+    bool IntegrateCallback(IntegrateIMU::Request &request, IntegrateIMU::Response &response);
+
+    /**
+     * @brief  check and convert request
+     * @param  request, service request
+     * @param  params, integration params output
+     * @param  init_pose, pose at first stamp output
+     * @param  init_vel, velocity at first stamp output
+     * @param  message, reason of rejection output
+     * @return true if valid false otherwise
+     */
+    static bool ParseRequest(
+        const IntegrateIMU::Request &request, 
+        BatchIntegrationParams &params, Eigen::Matrix4d &init_pose, Eigen::Vector3d &init_vel,
+        std::string &message
+    );
+
+    ros::NodeHandle nh_;
+    ros::ServiceServer service_;
+
+    ShardedCounter num_calls_;
+    ShardedCounter num_failures_;
+    LatencyHistogram call_cpu_time_;
+};
+
+} // namespace estimator
+
+} // namespace imu_integration
+
+#endif
@@ -0,0 +1,122 @@
+/*
+ * @Description: magnetometer heading aiding against the World Magnetic Model
+ * @Date: 2026-10-18 15:20:37
+ */
+#ifndef IMU_INTEGRATION_MAGNETOMETER_HEADING_HPP_
+#define IMU_INTEGRATION_MAGNETOMETER_HEADING_HPP_
+
+#include <cmath>
+
+#include <Eigen/Dense>
+#include <Eigen/Core>
+
+#include "imu_integration/estimator/non_holonomic_constraint.hpp"
+#include "imu_integration/sensor_data/magnetometer_data.hpp"
+#include "imu_integration/tools/runtime_stats.hpp"
+#include "imu_integration/tools/world_magnetic_model.hpp"
+
+namespace imu_integration {
+
+namespace estimator {
+
+//
+// The measured field is rotated into the navigation frame with the integrated orientation and
+// its horizontal direction compared against the model's. Only yaw is observable this way, so
+// yaw uncertainty is carried as a scalar alongside integration and each measurement is a
+// scalar update. With the non-holonomic constraint enabled the update goes to its error state
+// instead, so yaw stays consistent with velocity and position there. The model is evaluated
+// through a spatial cache, so once warmed up an update is a rotation, an atan2 and a few
+// multiplications
+//
+class MagnetometerHeading {
+  public:
+    struct Params {
+        LocalMagneticField::Params field;
+        // gyro noise driving yaw uncertainty, in the error state filter's convention:
+        double gyro_noise_stddev = 0.015;
+        // measurement noise per axis in tesla:
+        double stddev = 5.0e-7;
+        // largest relative deviation of field magnitude from model, disturbed ones are rejected:
+        double max_field_error = 0.15;
+        // normalized innovation gate:
+        double max_innovation = 3.0;
+        // yaw uncertainty on initialization in radians:
+        double initial_yaw_stddev = 0.01;
+    };
+
+    explicit MagnetometerHeading(const Params &params);
+
+    /**
+     * @brief  reset yaw uncertainty on estimator initialization
+     * @return void
+     */
+    void Init(void);
+    /**
+     * @brief  propagate yaw uncertainty over one integration step
+     * @param  delta_t, step length
+     * @return void
+     */
+    void Predict(double delta_t);
+    /**
+     * @brief  correct yaw with one magnetometer measurement
+     * @param  magnetometer_data, measurement in IMU frame
+     * @param  pose, integrated pose in IMU axes, corrected in place
+     * @return true if applied false if rejected
+     */
+    bool Correct(const MagnetometerData &magnetometer_data, Eigen::Matrix4d &pose);
+    /**
+     * @brief  correct yaw with one magnetometer measurement on the non-holonomic constraint's
+     *         error state, the own yaw variance is not used
+     * @param  magnetometer_data, measurement in IMU frame
+     * @param  constraint, non-holonomic constraint holding the error state covariance
+     * @param  pose, integrated pose in IMU axes, corrected in place
+     * @param  vel, integrated velocity in navigation frame, corrected in place
+     * @return true if applied false if rejected
+     */
+    bool Correct(
+        const MagnetometerData &magnetometer_data, NonHolonomicConstraint &constraint,
+        Eigen::Matrix4d &pose, Eigen::Vector3d &vel
+    );
+
+    /**
+     * @brief  update gyro noise, applied from the next prediction on
+     * @param  gyro_noise_stddev, gyro noise
+     * @return void
+     */
+    void SetNoise(double gyro_noise_stddev) { params_.gyro_noise_stddev = gyro_noise_stddev; }
+
+    double GetYawStddev(void) const { return std::sqrt(P_); }
+    const MagneticFieldCache &GetCache(void) const { return field_.GetCache(); }
+    const ShardedCounter &GetNumUpdates(void) const { return num_updates_; }
+    const ShardedCounter &GetNumRejected(void) const { return num_rejected_; }
+
+  private:
+    /**
+     * @brief  heading innovation of one measurement, disturbed measurements are rejected
+     * @param  magnetometer_data, measurement in IMU frame
+     * @param  pose, integrated pose in IMU axes
+     * @param  innovation, output, rotation about navigation z from estimated to measured heading
+     * @param  variance, output, heading measurement variance
+     * @return true if valid false if rejected
+     */
+    bool GetInnovation(
+        const MagnetometerData &magnetometer_data, const Eigen::Matrix4d &pose,
+        double &innovation, double &variance
+    );
+
+    Params params_;
+
+    LocalMagneticField field_;
+
+    // yaw error variance:
+    double P_ = 0.0;
+
+    ShardedCounter num_updates_;
+    ShardedCounter num_rejected_;
+};
+
+} // namespace estimator
+
+} // namespace imu_integration
+
+#endif
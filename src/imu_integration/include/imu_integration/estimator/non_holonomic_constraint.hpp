@@ -0,0 +1,132 @@
+/*
+ * @Description: non-holonomic constraint pseudo-measurements for ground vehicles
+ * @Date: 2026-10-18 14:06:52
+ */
+#ifndef IMU_INTEGRATION_NON_HOLONOMIC_CONSTRAINT_HPP_
+#define IMU_INTEGRATION_NON_HOLONOMIC_CONSTRAINT_HPP_
+
+#include <Eigen/Dense>
+#include <Eigen/Core>
+
+#include "imu_integration/estimator/error_state_filter.hpp"
+#include "imu_integration/tools/runtime_stats.hpp"
+
+namespace imu_integration {
+
+namespace estimator {
+
+//
+// Error state covariance is carried along the estimator's own integration, and at a low
+// rate lateral and vertical body velocity are constrained to zero. Each axis is a scalar
+// update, so the gain needs no matrix inverse and covariance takes a rank-one downdate
+//
+class NonHolonomicConstraint {
+  public:
+    struct Params {
+        ErrorStateFilter::Params filter;
+        // body axes in IMU frame, forward, lateral and vertical as columns:
+        Eigen::Matrix3d R_imu_body = Eigen::Matrix3d::Identity();
+        // minimum time between updates in seconds:
+        double period = 0.1;
+        // pseudo-measurement noise in m/s:
+        double lateral_stddev = 0.1;
+        double vertical_stddev = 0.05;
+        // initial uncertainty of ground truth initialization:
+        double initial_vel_stddev = 0.01;
+        double initial_ori_stddev = 0.001;
+    };
+
+    explicit NonHolonomicConstraint(const Params &params);
+
+    /**
+     * @brief  reset covariance on estimator initialization
+     * @param  time, initialization stamp
+     * @return void
+     */
+    void Init(double time);
+    /**
+     * @brief  propagate covariance over one integration step
+     * @param  delta_t, step length
+     * @param  specific_force, mean specific force over the step in navigation frame
+     * @return void
+     */
+    void Predict(double delta_t, const Eigen::Vector3d &specific_force);
+    /**
+     * @brief  apply constraint if period has elapsed since last update
+     * @param  time, current stamp
+     * @param  pose, integrated pose in IMU axes, corrected in place
+     * @param  vel, integrated velocity in navigation frame, corrected in place
+     * @return true if constraint was applied false otherwise
+     */
+    bool Correct(double time, Eigen::Matrix4d &pose, Eigen::Vector3d &vel);
+    /**
+     * @brief  heading update on the constraint's error state, so that heading aiding and the constraint
+     *         share one covariance instead of running as independent filters
+     * @param  innovation, rotation about navigation z from estimated to measured heading, in radians
+     * @param  variance, heading measurement variance
+     * @param  max_innovation, normalized innovation gate
+     * @param  pose, integrated pose in IMU axes, corrected in place
+     * @param  vel, integrated velocity in navigation frame, corrected in place
+     * @return true if applied false if gated out
+     */
+    bool CorrectHeading(
+        double innovation, double variance, double max_innovation,
+        Eigen::Matrix4d &pose, Eigen::Vector3d &vel
+    );
+
+    /**
+     * @brief  update IMU noise, applied from the next prediction on
+     * @param  gyro_noise_stddev, gyro noise
+     * @param  acc_noise_stddev, accelerometer noise
+     * @return void
+     */
+    void SetNoise(double gyro_noise_stddev, double acc_noise_stddev) {
+        params_.filter.gyro_noise_stddev = gyro_noise_stddev;
+        params_.filter.acc_noise_stddev = acc_noise_stddev;
+    }
+
+    const ErrorStateCovariance &GetCovariance(void) const { return P_; }
+    const ShardedCounter &GetNumUpdates(void) const { return num_updates_; }
+
+  private:
+    /**
+     * @brief  scalar update of zero velocity along one body axis
+     * @param  axis, unit body axis in IMU frame
+     * @param  stddev, pseudo-measurement noise
+     * @param  R, orientation, corrected in place
+     * @param  t, position, corrected in place
+     * @param  v, velocity, corrected in place
+     * @return void
+     */
+    void CorrectAxis(
+        const Eigen::Vector3d &axis, double stddev,
+        Eigen::Matrix3d &R, Eigen::Vector3d &t, Eigen::Vector3d &v
+    );
+    /**
+     * @brief  scalar error state update, orientation error applied on the left
+     * @param  H, measurement Jacobian by error state
+     * @param  residual, measurement minus prediction
+     * @param  S, innovation variance
+     * @param  R, orientation, corrected in place
+     * @param  t, position, corrected in place
+     * @param  v, velocity, corrected in place
+     * @return void
+     */
+    void Update(
+        const Eigen::Matrix<double, 1, kErrorStateDim> &H, double residual, double S,
+        Eigen::Matrix3d &R, Eigen::Vector3d &t, Eigen::Vector3d &v
+    );
+
+    Params params_;
+
+    ErrorStateCovariance P_ = ErrorStateCovariance::Zero();
+    double prev_update_time_ = 0.0;
+
+    ShardedCounter num_updates_;
+};
+
+} // namespace estimator
+
+} // namespace imu_integration
+
+#endif
@@ -0,0 +1,66 @@
+/*
+ * @Description: IMU preintegration between keyframes
+ * @Date: 2026-10-18 10:02:31
+ */
+#ifndef IMU_INTEGRATION_PREINTEGRATION_HPP_
+#define IMU_INTEGRATION_PREINTEGRATION_HPP_
+
+#include <Eigen/Dense>
+#include <Eigen/Core>
+
+#include "imu_integration/estimator/error_state_filter.hpp"
+#include "imu_integration/sensor_data/imu_data.hpp"
+
+namespace imu_integration {
+
+namespace estimator {
+
+/**
+ * @brief  relative motion in the body frame of the first measurement, gravity excluded.
+ *         Increments use the same mid-value kernels as the estimator.
+ *         Covariance is ordered as the error state, position, velocity then orientation
+ */
+class IMUPreintegration {
+  public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    struct Params {
+        Eigen::Vector3d angular_vel_bias = Eigen::Vector3d::Zero();
+        Eigen::Vector3d linear_acc_bias = Eigen::Vector3d::Zero();
+        // per measurement noise:
+        double gyro_noise_stddev = 0.015;
+        double acc_noise_stddev = 0.019;
+    };
+
+    IMUPreintegration(void) = default;
+    IMUPreintegration(const Params &params, const IMUData &imu_data);
+
+    /**
+     * @brief  integrate new measurement
+     * @param  imu_data, IMU measurement, later than the last one
+     * @return void
+     */
+    void Integrate(const IMUData &imu_data);
+
+    double GetDeltaTime(void) const { return delta_t_; }
+    const Eigen::Matrix3d &GetDeltaR(void) const { return delta_R_; }
+    const Eigen::Vector3d &GetDeltaV(void) const { return delta_v_; }
+    const Eigen::Vector3d &GetDeltaP(void) const { return delta_p_; }
+    const ErrorStateCovariance &GetCovariance(void) const { return covariance_; }
+
+  private:
+    Params params_;
+    IMUData imu_data_;
+
+    double delta_t_ = 0.0;
+    Eigen::Matrix3d delta_R_ = Eigen::Matrix3d::Identity();
+    Eigen::Vector3d delta_v_ = Eigen::Vector3d::Zero();
+    Eigen::Vector3d delta_p_ = Eigen::Vector3d::Zero();
+    ErrorStateCovariance covariance_ = ErrorStateCovariance::Zero();
+};
+
+} // namespace estimator
+
+} // namespace imu_integration
+
+#endif
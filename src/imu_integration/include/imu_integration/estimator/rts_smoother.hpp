@@ -0,0 +1,91 @@
+/*
+ * @Description: out-of-core Rauch-Tung-Striebel smoother over error-state filter output
+ * @Date: 2026-10-18 15:52:40
+ */
+#ifndef IMU_INTEGRATION_RTS_SMOOTHER_HPP_
+#define IMU_INTEGRATION_RTS_SMOOTHER_HPP_
+
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "imu_integration/estimator/error_state_filter.hpp"
+
+namespace imu_integration {
+
+namespace estimator {
+
+/**
+ * @brief  filtered states are spilled to disk in fixed size blocks during the forward pass.
+ *         The backward pass reads blocks in reverse order, re-derives predictions from the stored
+ *         IMU measurements and writes smoothed blocks in place, which are then streamed forward.
+ *         Memory use is bounded by two blocks regardless of trajectory length
+ */
+class RTSSmoother {
+  public:
+    /**
+     * @brief  constructor
+     * @param  params, params of the filter which produced the states
+     * @param  spill_path, prefix of spill files
+     * @param  block_size, number of states per block
+     */
+    RTSSmoother(const ErrorStateFilter::Params &params, const std::string &spill_path, size_t block_size);
+    ~RTSSmoother(void);
+    RTSSmoother(const RTSSmoother &) = delete;
+    RTSSmoother &operator=(const RTSSmoother &) = delete;
+
+    bool Open(void);
+    /**
+     * @brief  append filtered state, states must be consecutive filter outputs
+     * @param  state, filtered state
+     * @param  imu_data, IMU measurement at state stamp
+     * @return true if success false otherwise
+     */
+    bool Add(const FilterState &state, const IMUData &imu_data);
+    /**
+     * @brief  run backward pass
+     * @param  callback, receives smoothed states in time order
+     * @return true if success false otherwise
+     */
+    bool Smooth(const std::function<void(const FilterState &)> &callback);
+
+    size_t GetNumStates(void) const { return num_states_; }
+
+  private:
+    // fixed size on-disk record:
+    struct Record {
+        double time;
+        double q[4];
+        double t[3];
+        double v[3];
+        // upper triangle, row major:
+        double P[kErrorStateDim * (kErrorStateDim + 1) / 2];
+        double imu_time;
+        double linear_acceleration[3];
+        double angular_velocity[3];
+    };
+
+    static void Pack(const FilterState &state, const IMUData &imu_data, Record &record);
+    static void Unpack(const Record &record, FilterState &state, IMUData &imu_data);
+
+    bool FlushBlock(void);
+    bool ReadBlock(FILE *file, size_t index, std::vector<Record> &block);
+    bool WriteBlock(FILE *file, size_t index, const std::vector<Record> &block);
+
+    const ErrorStateFilter::Params params_;
+    const std::string spill_path_;
+    const size_t block_size_;
+
+    FILE *filtered_file_ = nullptr;
+    FILE *smoothed_file_ = nullptr;
+
+    std::vector<Record> block_;
+    size_t num_states_ = 0;
+};
+
+} // namespace estimator
+
+} // namespace imu_integration
+
+#endif
@@ -0,0 +1,172 @@
+/*
+ * @Description: fixed-lag smoother over keyframes linked by IMU preintegration and pose factors
+ * @Date: 2026-10-18 14:36:08
+ */
+#ifndef IMU_INTEGRATION_SLIDING_WINDOW_OPTIMIZER_HPP_
+#define IMU_INTEGRATION_SLIDING_WINDOW_OPTIMIZER_HPP_
+
+#include <deque>
+#include <vector>
+
+#include <Eigen/Dense>
+#include <Eigen/Core>
+#include <Eigen/StdDeque>
+#include <Eigen/StdVector>
+
+#include "imu_integration/estimator/preintegration.hpp"
+#include "imu_integration/sensor_data/imu_data.hpp"
+#include "imu_integration/sensor_data/odom_data.hpp"
+#include "imu_integration/tools/runtime_stats.hpp"
+
+namespace imu_integration {
+
+namespace estimator {
+
+/**
+ * @brief  keyframes are created at pose measurements, at most one per keyframe period.
+ *         Consecutive keyframes are linked by preintegrated IMU factors, so the normal equations
+ *         are block tridiagonal and are solved by block elimination, one 9x9 Schur complement per keyframe.
+ *         The oldest keyframe is marginalized into a prior on its successor once the window is full.
+ *         Gauss-Newton iterations stop early when the next one would exceed the time budget
+ */
+class SlidingWindowOptimizer {
+  public:
+    struct Params {
+        IMUPreintegration::Params preintegration;
+        Eigen::Vector3d gravity = Eigen::Vector3d(0.0, 0.0, -9.7942164704);
+        // minimum time between keyframes in seconds:
+        double keyframe_period = 0.1;
+        // number of keyframes in window:
+        int window_size = 10;
+        int max_iterations = 5;
+        // optimization time budget per keyframe in seconds:
+        double time_budget = 0.01;
+        // pose measurement noise:
+        double position_stddev = 0.01;
+        double orientation_stddev = 0.01;
+    };
+
+    struct Keyframe {
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        double time = 0.0;
+        Eigen::Matrix3d R = Eigen::Matrix3d::Identity();
+        Eigen::Vector3d t = Eigen::Vector3d::Zero();
+        Eigen::Vector3d v = Eigen::Vector3d::Zero();
+        // pose measurement:
+        Eigen::Matrix3d R_meas = Eigen::Matrix3d::Identity();
+        Eigen::Vector3d t_meas = Eigen::Vector3d::Zero();
+    };
+
+    explicit SlidingWindowOptimizer(const Params &params);
+
+    void AddIMUData(const IMUData &imu_data);
+    void AddPose(const OdomData &odom_data);
+
+    /**
+     * @brief  create keyframes from buffered measurements and optimize
+     * @return true if a new keyframe was optimized
+     */
+    bool Update(void);
+
+    bool HasKeyframe(void) const { return !keyframes_.empty(); }
+    const Keyframe &GetLatestKeyframe(void) const { return keyframes_.back(); }
+    /**
+     * @brief  update gravity and biases, applied from the next keyframe interval on
+     * @param  gravity, gravity
+     * @param  angular_vel_bias, gyro bias
+     * @param  linear_acc_bias, accelerometer bias
+     * @return void
+     */
+    void SetIMUParams(
+        const Eigen::Vector3d &gravity, 
+        const Eigen::Vector3d &angular_vel_bias, const Eigen::Vector3d &linear_acc_bias
+    ) {
+        params_.gravity = gravity;
+        params_.preintegration.angular_vel_bias = angular_vel_bias;
+        params_.preintegration.linear_acc_bias = linear_acc_bias;
+    }
+    /**
+     * @brief  update IMU noise, applied from the next keyframe interval on
+     * @param  gyro_noise_stddev, gyro noise
+     * @param  acc_noise_stddev, accelerometer noise
+     * @return void
+     */
+    void SetNoise(double gyro_noise_stddev, double acc_noise_stddev) {
+        params_.preintegration.gyro_noise_stddev = gyro_noise_stddev;
+        params_.preintegration.acc_noise_stddev = acc_noise_stddev;
+    }
+
+    const LatencyHistogram &GetSolveTime(void) const { return solve_time_; }
+    const ShardedCounter &GetNumKeyframes(void) const { return num_keyframes_; }
+    const ShardedCounter &GetNumBudgetOverruns(void) const { return num_budget_overruns_; }
+
+  private:
+    typedef Eigen::Matrix<double, kErrorStateDim, kErrorStateDim> Block;
+    typedef Eigen::Matrix<double, kErrorStateDim, 1> Vector;
+
+    void AddKeyframe(const OdomData &odom_data);
+    void Optimize(void);
+    /**
+     * @brief  build block tridiagonal normal equations at current estimates
+     * @param  D, diagonal blocks
+     * @param  U, upper off-diagonal blocks, U[k] couples keyframes k and k + 1
+     * @param  g, gradient
+     * @return total cost
+     */
+    double Linearize(
+        std::vector<Block, Eigen::aligned_allocator<Block>> &D,
+        std::vector<Block, Eigen::aligned_allocator<Block>> &U,
+        std::vector<Vector, Eigen::aligned_allocator<Vector>> &g
+    ) const;
+    /**
+     * @brief  solve by block forward elimination and back substitution
+     * @param  D, diagonal blocks, overwritten by Schur complements
+     * @param  U, upper off-diagonal blocks
+     * @param  g, gradient
+     * @param  dx, output, increment of each keyframe
+     * @return void
+     */
+    static void Solve(
+        std::vector<Block, Eigen::aligned_allocator<Block>> &D,
+        const std::vector<Block, Eigen::aligned_allocator<Block>> &U,
+        const std::vector<Vector, Eigen::aligned_allocator<Vector>> &g,
+        std::vector<Vector, Eigen::aligned_allocator<Vector>> &dx
+    );
+    void Marginalize(void);
+
+    double LinearizeIMUFactor(
+        const Keyframe &keyframe_i, const Keyframe &keyframe_j, const IMUPreintegration &preintegration,
+        Block &H_ii, Block &H_ij, Block &H_jj, Vector &b_i, Vector &b_j
+    ) const;
+    double LinearizePoseFactor(const Keyframe &keyframe, Block &H, Vector &b) const;
+    double LinearizePrior(const Keyframe &keyframe, Block &H, Vector &b) const;
+
+    Params params_;
+
+    // measurements not yet assigned to a keyframe:
+    std::deque<IMUData> imu_data_buff_;
+    std::deque<OdomData> pose_buff_;
+    IMUData imu_data_;
+    IMUPreintegration preintegration_;
+
+    // window:
+    std::deque<Keyframe, Eigen::aligned_allocator<Keyframe>> keyframes_;
+    std::deque<IMUPreintegration, Eigen::aligned_allocator<IMUPreintegration>> preintegrations_;
+
+    // marginalization prior on the oldest keyframe:
+    bool has_prior_ = false;
+    Block prior_H_;
+    Vector prior_b_;
+    Keyframe prior_keyframe_;
+
+    LatencyHistogram solve_time_;
+    ShardedCounter num_keyframes_;
+    ShardedCounter num_budget_overruns_;
+};
+
+} // namespace estimator
+
+} // namespace imu_integration
+
+#endif
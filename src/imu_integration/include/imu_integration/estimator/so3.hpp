@@ -0,0 +1,58 @@
+/*
+ * @Description: SO(3) helpers shared by filtering and optimization
+ * @Date: 2026-10-18 09:18:44
+ */
+#ifndef IMU_INTEGRATION_SO3_HPP_
+#define IMU_INTEGRATION_SO3_HPP_
+
+#include <cmath>
+
+#include <Eigen/Dense>
+#include <Eigen/Core>
+
+namespace imu_integration {
+
+namespace estimator {
+
+inline Eigen::Matrix3d GetSkewSymmetric(const Eigen::Vector3d &v) {
+    Eigen::Matrix3d m;
+    m <<     0.0, -v.z(),  v.y(),
+           v.z(),    0.0, -v.x(),
+          -v.y(),  v.x(),    0.0;
+    return m;
+}
+
+inline Eigen::Matrix3d Exp(const Eigen::Vector3d &phi) {
+    const double angle = phi.norm();
+    if (angle < 1.0e-10) {
+        return Eigen::Matrix3d::Identity() + GetSkewSymmetric(phi);
+    }
+    return Eigen::AngleAxisd(angle, phi / angle).toRotationMatrix();
+}
+
+inline Eigen::Vector3d Log(const Eigen::Matrix3d &R) {
+    const Eigen::AngleAxisd angle_axis(R);
+    return angle_axis.angle() * angle_axis.axis();
+}
+
+/**
+ * @brief  inverse of SO(3) right Jacobian
+ * @param  phi, rotation vector
+ * @return Jr^-1(phi)
+ */
+inline Eigen::Matrix3d GetRightJacobianInverse(const Eigen::Vector3d &phi) {
+    const double angle = phi.norm();
+    const Eigen::Matrix3d phi_hat = GetSkewSymmetric(phi);
+    if (angle < 1.0e-5) {
+        return Eigen::Matrix3d::Identity() + 0.5 * phi_hat;
+    }
+
+    return Eigen::Matrix3d::Identity() + 0.5 * phi_hat + 
+        (1.0 / (angle * angle) - (1.0 + cos(angle)) / (2.0 * angle * sin(angle))) * phi_hat * phi_hat;
+}
+
+} // namespace estimator
+
+} // namespace imu_integration
+
+#endif
@@ -0,0 +1,105 @@
+/*
+ * @Description: online IMU to odometry time offset estimation through angular rate cross-correlation
+ * @Date: 2026-10-18 09:41:52
+ */
+#ifndef IMU_INTEGRATION_TIME_OFFSET_ESTIMATOR_HPP_
+#define IMU_INTEGRATION_TIME_OFFSET_ESTIMATOR_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "imu_integration/config/config.hpp"
+#include "imu_integration/sensor_data/imu_data.hpp"
+#include "imu_integration/sensor_data/odom_data.hpp"
+#include "imu_integration/tools/runtime_stats.hpp"
+
+namespace imu_integration {
+
+namespace estimator {
+
+/**
+ * @brief  estimates offset = IMU stamp - odometry stamp of the same physical instant.
+ *         Angular rate magnitudes of both streams are resampled on a common grid over a sliding window
+ *         and cross-correlated with FFT on a background thread. The integration thread only
+ *         appends measurements and reads the latest estimate
+ */
+class TimeOffsetEstimator {
+  public:
+    explicit TimeOffsetEstimator(const TimeOffsetConfig &config);
+    ~TimeOffsetEstimator(void);
+    TimeOffsetEstimator(const TimeOffsetEstimator &) = delete;
+    TimeOffsetEstimator &operator=(const TimeOffsetEstimator &) = delete;
+
+    void Start(void);
+    void Stop(void);
+
+    /**
+     * @brief  append new measurements, called from the integration thread
+     * @param  first, first new measurement
+     * @param  last, one past the last new measurement
+     * @return void
+     */
+    void AddIMUData(std::deque<IMUData>::const_iterator first, std::deque<IMUData>::const_iterator last);
+    void AddOdomData(std::deque<OdomData>::const_iterator first, std::deque<OdomData>::const_iterator last);
+
+    double GetOffset(void) const { return offset_.load(std::memory_order_relaxed); }
+    double GetCorrelation(void) const { return correlation_.load(std::memory_order_relaxed); }
+    const ShardedCounter &GetNumEstimates(void) const { return num_estimates_; }
+
+  private:
+    struct RateSample {
+        double time;
+        double rate;
+    };
+
+    void Loop(void);
+    /**
+     * @brief  estimate offset over the current window
+     * @param  offset, output offset in seconds
+     * @param  correlation, output normalized correlation at the peak
+     * @return true if both streams cover the window false otherwise
+     */
+    bool Estimate(double &offset, double &correlation);
+    /**
+     * @brief  resample angular rate magnitude on uniform grid, mean removed
+     * @param  samples, angular rate magnitude samples sorted by time
+     * @param  start_time, grid start
+     * @param  N, grid size
+     * @param  signal, output, zero padded to its size
+     * @return void
+     */
+    void Resample(
+        const std::vector<RateSample> &samples, double start_time, size_t N,
+        std::vector<double> &signal
+    ) const;
+
+    const TimeOffsetConfig config_;
+
+    // measurements shared with integration thread:
+    std::mutex buff_mutex_;
+    std::deque<RateSample> imu_rate_buff_;
+    std::deque<RateSample> odom_rate_buff_;
+    bool has_prev_odom_ = false;
+    OdomData prev_odom_;
+
+    // estimation:
+    std::atomic<double> offset_{0.0};
+    std::atomic<double> correlation_{0.0};
+    bool has_estimate_ = false;
+    ShardedCounter num_estimates_;
+
+    std::mutex loop_mutex_;
+    std::condition_variable loop_cond_;
+    bool running_ = false;
+    std::thread thread_;
+};
+
+} // namespace estimator
+
+} // namespace imu_integration
+
+#endif
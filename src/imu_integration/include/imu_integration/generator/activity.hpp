@@ -16,9 +16,20 @@
 #include <ros/ros.h>
 #include <sensor_msgs/Imu.h>
 #include <geometry_msgs/PoseStamped.h>
+#include <geometry_msgs/PointStamped.h>
+#include <sensor_msgs/MagneticField.h>
 #include <nav_msgs/Odometry.h>
 
 #include "imu_integration/config/config.hpp"
+#include "imu_integration/generator/motion_model.hpp"
+#include "imu_integration/generator/sensor_scheduler.hpp"
+#include "imu_integration/generator/stress_shaper.hpp"
+
+#include "imu_integration/tools/runtime_stats.hpp"
+#include "imu_integration/tools/metrics.hpp"
+#include "imu_integration/tools/param_watcher.hpp"
+#include "imu_integration/tools/sim_clock.hpp"
+#include "imu_integration/tools/world_magnetic_model.hpp"
 
 namespace imu_integration {
 
@@ -29,39 +40,74 @@ public:
     Activity();
     void Init(void);
     void Run(void);
+    // loop rate in Hz the node should call Run with, 0 if Run paces itself:
+    double GetLoopRate(void) const;
+    // simulated duration elapsed:
+    bool IsFinished(void) const;
+    // send messages still held back by stress shaping:
+    void Flush(void);
+    // log summary of published traffic:
+    void Report(void) const;
 private:
+    // stress mode, bursts of shaped messages:
+    void RunStress(void);
+    // lockstep mode, one step per consumer acknowledgement:
+    void RunSimClock(void);
+    // sensors, each evaluated only when due:
+    void PublishIMU(double time);
+    void PublishGroundTruth(double time);
+    void PublishPosition(double time);
+    void PublishMagnetometer(double time);
     // get groud truth from motion equation:
     void GetGroundTruth(void);
     // random walk & measurement noise generation:
     void AddNoise(double delta_t);
+    // apply reloaded bias, gravity & noise params:
+    void UpdateIMUParams(void);
     // convert to ROS messages:
     void SetIMUMessage(void);
     void SetOdometryMessage(void);
     // publish:
-    void PublishMessages(void);
+    void PublishIMUMessage(const sensor_msgs::Imu &message_imu);
+    void PublishOdometryMessage(const nav_msgs::Odometry &message_odom);
+    // metrics:
+    void RegisterMetrics(void);
+    // three standard normal samples:
+    Eigen::Vector3d GetStandardNormal(void);
 
-    // utilities:
-    Eigen::Vector3d GetGaussianNoise(double stddev);
-    static Eigen::Matrix3d EulerAnglesToRotation(const Eigen::Vector3d &euler_angles);
-    static Eigen::Vector3d EulerAngleRatesToBodyAngleRates(const Eigen::Vector3d &euler_angles, const Eigen::Vector3d &euler_angle_rates);
-    
     // node handler:
     ros::NodeHandle private_nh_;
 
+    std::shared_ptr<IMUParamsWatcher> imu_params_watcher_ptr_;
+
     ros::Publisher pub_imu_;
     // TODO: separate odometry estimation from IMU device
     ros::Publisher pub_odom_;
+    ros::Publisher pub_position_;
+    ros::Publisher pub_magnetometer_;
+    // additional IMU topics in stress mode:
+    std::vector<ros::Publisher> pub_imu_stress_;
 
     // config:
     IMUConfig imu_config_;
     OdomConfig odom_config_;
+    MetricsConfig metrics_config_;
+    SensorsConfig sensors_config_;
+    MagneticModelConfig magnetic_model_config_;
+    StressConfig stress_config_;
+    SimClockConfig sim_clock_config_;
 
     // noise generator:
     std::default_random_engine normal_generator_;
     std::normal_distribution<double> normal_distribution_;
 
+    // sensor events:
+    SensorScheduler scheduler_;
+
     // measurements:
     ros::Time timestamp_;
+    // latest IMU measurement stamp, for bias random walk:
+    double imu_time_;
     // a. gravity constant:
     Eigen::Vector3d G_;
     // b. pose:
@@ -77,6 +123,29 @@ private:
     // ROS IMU message:
     sensor_msgs::Imu message_imu_;
     nav_msgs::Odometry message_odom_;
+
+    // stress mode traffic shaping:
+    std::shared_ptr<StressShaper<sensor_msgs::Imu>> imu_shaper_ptr_;
+    std::shared_ptr<StressShaper<nav_msgs::Odometry>> odom_shaper_ptr_;
+
+    // magnetometer reference field:
+    std::shared_ptr<LocalMagneticField> magnetic_field_ptr_;
+
+    // simulated time server:
+    std::shared_ptr<SimClockServer> sim_clock_server_ptr_;
+
+    // runtime stats:
+    ShardedCounter num_imu_published_;
+    ShardedCounter num_odom_published_;
+    ShardedCounter num_position_published_;
+    ShardedCounter num_magnetometer_published_;
+    LatencyHistogram run_cpu_time_;
+    // delay from measurement stamp to publishing:
+    LatencyHistogram publish_lag_;
+
+    // metrics:
+    MetricsRegistry metrics_registry_;
+    std::shared_ptr<MetricsExporter> metrics_exporter_ptr_;
 };
 
 }  // namespace generator
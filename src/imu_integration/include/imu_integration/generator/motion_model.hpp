@@ -0,0 +1,119 @@
+/*
+ * @Description: ground truth motion equation and IMU noise model, free of ROS
+ * @Date: 2026-10-18 10:52:31
+ */
+#ifndef IMU_INTEGRATION_MOTION_MODEL_HPP_
+#define IMU_INTEGRATION_MOTION_MODEL_HPP_
+
+#include <cmath>
+#include <cstddef>
+#include <random>
+
+#include <Eigen/Core>
+#include <Eigen/Dense>
+
+namespace imu_integration {
+
+namespace generator {
+
+struct MotionState {
+    // pose:
+    Eigen::Matrix3d R = Eigen::Matrix3d::Identity();
+    Eigen::Vector3d t = Eigen::Vector3d::Zero();
+    Eigen::Vector3d v = Eigen::Vector3d::Zero();
+    // IMU measurement in body frame:
+    Eigen::Vector3d angular_vel = Eigen::Vector3d::Zero();
+    Eigen::Vector3d linear_acc = Eigen::Vector3d::Zero();
+};
+
+struct IMUNoise {
+    double gyro_bias_stddev = 5e-5;
+    double gyro_noise_stddev = 0.015;
+    double acc_bias_stddev = 5e-4;
+    double acc_noise_stddev = 0.019;
+};
+
+Eigen::Matrix3d EulerAnglesToRotation(const Eigen::Vector3d &euler_angles);
+Eigen::Vector3d EulerAngleRatesToBodyAngleRates(const Eigen::Vector3d &euler_angles, const Eigen::Vector3d &euler_angle_rates);
+
+/**
+ * @brief  get ground truth from motion equation
+ * @param  time, time in seconds
+ * @param  G, gravity constant
+ * @param  state, output, pose and noise free IMU measurement
+ * @return void
+ */
+void GetGroundTruth(double time, const Eigen::Vector3d &G, MotionState &state);
+
+/**
+ * @brief  bias random walk & measurement noise generation
+ * @param  noise, noise params
+ * @param  delta_t, time since previous measurement
+ * @param  engine, random engine
+ * @param  distribution, standard normal distribution
+ * @param  angular_vel_bias, angular velocity bias, random walk applied in place
+ * @param  linear_acc_bias, linear acceleration bias, random walk applied in place
+ * @param  angular_vel, angular velocity, bias and noise applied in place
+ * @param  linear_acc, linear acceleration, bias and noise applied in place
+ * @return void
+ */
+template <typename Engine>
+void AddNoise(
+    const IMUNoise &noise, double delta_t,
+    Engine &engine, std::normal_distribution<double> &distribution,
+    Eigen::Vector3d &angular_vel_bias, Eigen::Vector3d &linear_acc_bias,
+    Eigen::Vector3d &angular_vel, Eigen::Vector3d &linear_acc
+) {
+    auto GetGaussianNoise = [&engine, &distribution](double stddev) {
+        return Eigen::Vector3d(
+            stddev * distribution(engine),
+            stddev * distribution(engine),
+            stddev * distribution(engine)
+        );
+    };
+
+    double sqrt_delta_t = sqrt(delta_t);
+
+    // a. update bias:
+    angular_vel_bias += GetGaussianNoise(noise.gyro_bias_stddev * sqrt_delta_t);
+    linear_acc_bias += GetGaussianNoise(noise.acc_bias_stddev * sqrt_delta_t);
+
+    // b. get measurement noise:
+    Eigen::Vector3d angular_vel_noise = GetGaussianNoise(noise.gyro_noise_stddev / sqrt_delta_t);
+    Eigen::Vector3d linear_acc_noise = GetGaussianNoise(noise.acc_noise_stddev / sqrt_delta_t);
+
+    // apply to measurement:
+    angular_vel += angular_vel_bias + angular_vel_noise;
+    linear_acc += linear_acc_bias + linear_acc_noise;
+}
+
+/**
+ * @brief  generate ground truth and noisy measurements at given stamps, arrays are
+ *         row-major with one row per stamp, orientation as x, y, z, w
+ * @param  num_samples, number of stamps
+ * @param  time, stamps, num_samples
+ * @param  G, gravity constant
+ * @param  noise, noise params, measurements are noise free if null
+ * @param  seed, random engine seed
+ * @param  angular_vel_bias, initial angular velocity bias
+ * @param  linear_acc_bias, initial linear acceleration bias
+ * @param  position, output, num_samples x 3
+ * @param  orientation, output, num_samples x 4
+ * @param  velocity, output, num_samples x 3
+ * @param  angular_velocity, output, num_samples x 3
+ * @param  linear_acceleration, output, num_samples x 3
+ * @return void
+ */
+void GenerateBatch(
+    size_t num_samples, const double *time,
+    const Eigen::Vector3d &G, const IMUNoise *noise, unsigned int seed,
+    const Eigen::Vector3d &angular_vel_bias, const Eigen::Vector3d &linear_acc_bias,
+    double *position, double *orientation, double *velocity,
+    double *angular_velocity, double *linear_acceleration
+);
+
+}  // namespace generator
+
+}  // namespace imu_integration
+
+#endif  // IMU_INTEGRATION_MOTION_MODEL_HPP_
@@ -2,7 +2,6 @@
 #define IMU_INTEGRATION_NODE_CONSTANTS_HPP_
 
 #include <cmath>
-#include <ros/ros.h>
 
 namespace imu_integration {
 
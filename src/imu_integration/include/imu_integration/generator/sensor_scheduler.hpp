@@ -0,0 +1,120 @@
+/*
+ * @Description: min-heap event scheduler of simulated sensors at independent rates
+ * @Date: 2026-10-18 09:41:17
+ */
+#ifndef IMU_INTEGRATION_SENSOR_SCHEDULER_HPP_
+#define IMU_INTEGRATION_SENSOR_SCHEDULER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <string>
+#include <vector>
+
+namespace imu_integration {
+
+namespace generator {
+
+//
+// Every sensor has exactly one pending event in the heap. Fire times are derived from the
+// sensor's start time and event count rather than accumulated, so rates with non-integer
+// ratios keep their phase over arbitrarily long runs
+//
+class SensorScheduler {
+  public:
+    typedef std::function<void(double time)> Callback;
+
+    struct Sensor {
+        std::string name;
+        double rate;
+        double start_time;
+        uint64_t num_fired;
+        Callback callback;
+    };
+
+    /**
+     * @brief  add a sensor firing at start_time + k / rate, k = 1, 2, ...
+     * @param  name, sensor name
+     * @param  rate, rate in Hz, sensor is skipped if not positive
+     * @param  start_time, start time in seconds
+     * @param  callback, evaluates and publishes the measurement at given time
+     * @return true if added false otherwise
+     */
+    bool AddSensor(const std::string &name, double rate, double start_time, const Callback &callback) {
+        if (!(rate > 0.0)) {
+            return false;
+        }
+
+        sensors_.push_back(Sensor{name, rate, start_time, 0, callback});
+        events_.push(Event{GetFireTime(sensors_.back()), sensors_.size() - 1});
+
+        return true;
+    }
+
+    // time of the earliest pending event, infinity without sensors:
+    double GetNextTime(void) const {
+        return events_.empty() ? std::numeric_limits<double>::infinity() : events_.top().time;
+    }
+
+    /**
+     * @brief  fire every event due up to given time in time order, on ties sensors added first go first
+     * @param  time, time in seconds
+     * @return number of events fired
+     */
+    size_t RunUntil(double time) {
+        size_t num_fired = 0;
+
+        while (!events_.empty() && events_.top().time <= time) {
+            const Event event = events_.top();
+            events_.pop();
+
+            Sensor &sensor = sensors_.at(event.index);
+            ++sensor.num_fired;
+            sensor.callback(event.time);
+
+            events_.push(Event{GetFireTime(sensor), event.index});
+            ++num_fired;
+        }
+
+        return num_fired;
+    }
+
+    double GetMaxRate(void) const {
+        double max_rate = 0.0;
+        for (const Sensor &sensor: sensors_) {
+            max_rate = (sensor.rate > max_rate) ? sensor.rate : max_rate;
+        }
+
+        return max_rate;
+    }
+
+    const std::vector<Sensor> &GetSensors(void) const { return sensors_; }
+
+  private:
+    struct Event {
+        double time;
+        size_t index;
+    };
+
+    // min-heap order:
+    struct Later {
+        bool operator()(const Event &a, const Event &b) const {
+            return (a.time > b.time) || (a.time == b.time && a.index > b.index);
+        }
+    };
+
+    static double GetFireTime(const Sensor &sensor) {
+        return sensor.start_time + static_cast<double>(sensor.num_fired + 1) / sensor.rate;
+    }
+
+    std::vector<Sensor> sensors_;
+    std::priority_queue<Event, std::vector<Event>, Later> events_;
+};
+
+}  // namespace generator
+
+}  // namespace imu_integration
+
+#endif  // IMU_INTEGRATION_SENSOR_SCHEDULER_HPP_
@@ -0,0 +1,131 @@
+/*
+ * @Description: traffic shaping of generated messages for subscriber stress tests
+ * @Date: 2026-10-18 10:08:51
+ */
+#ifndef IMU_INTEGRATION_STRESS_SHAPER_HPP_
+#define IMU_INTEGRATION_STRESS_SHAPER_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+
+#include "imu_integration/config/config.hpp"
+
+namespace imu_integration {
+
+namespace generator {
+
+/**
+ * @brief  drops, duplicates and swaps adjacent messages of one stream with configured probabilities,
+ *         a message held for swapping goes out alone once its successor is overdue
+ */
+template <typename Msg>
+class StressShaper {
+  public:
+    StressShaper(std::default_random_engine &random_engine, const StressConfig &config)
+        : random_engine_(random_engine), config_(config), uniform_distribution_(0.0, 1.0) {}
+
+    /**
+     * @brief  shape one message
+     * @param  msg, message
+     * @param  publish, callable taking const Msg&, invoked for every message to send
+     * @return void
+     */
+    template <typename Publish>
+    void Push(const Msg &msg, Publish publish) {
+        ++num_in_;
+
+        if (GetUniform() < config_.drop_probability) {
+            ++num_dropped_;
+            return;
+        }
+
+        const int num_copies = (GetUniform() < config_.duplicate_probability) ? 2 : 1;
+        num_duplicated_ += num_copies - 1;
+
+        if (has_held_) {
+            // the held message goes out after its successor:
+            ++num_reordered_;
+            for (int i = 0; i < num_copies; ++i) {
+                Send(msg, publish);
+            }
+            Send(held_, publish);
+            has_held_ = false;
+        } else if (GetUniform() < config_.reorder_probability) {
+            held_ = msg;
+            held_since_ = std::chrono::steady_clock::now();
+            has_held_ = true;
+            // copies of a held message are not tracked, send the duplicate in order:
+            if (num_copies > 1) {
+                Send(msg, publish);
+            }
+        } else {
+            for (int i = 0; i < num_copies; ++i) {
+                Send(msg, publish);
+            }
+        }
+    }
+
+    /**
+     * @brief  send the held message if it has waited longer than the configured max hold in wall time
+     * @param  publish, callable taking const Msg&
+     * @return void
+     */
+    template <typename Publish>
+    void Release(Publish publish) {
+        if (
+            has_held_ && 
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - held_since_).count() >= config_.max_hold
+        ) {
+            Flush(publish);
+        }
+    }
+
+    /**
+     * @brief  send the held message, if any, e.g. before shutdown
+     * @param  publish, callable taking const Msg&
+     * @return void
+     */
+    template <typename Publish>
+    void Flush(Publish publish) {
+        if (has_held_) {
+            Send(held_, publish);
+            has_held_ = false;
+        }
+    }
+
+    uint64_t GetNumIn(void) const { return num_in_; }
+    uint64_t GetNumOut(void) const { return num_out_; }
+    uint64_t GetNumDropped(void) const { return num_dropped_; }
+    uint64_t GetNumDuplicated(void) const { return num_duplicated_; }
+    uint64_t GetNumReordered(void) const { return num_reordered_; }
+
+  private:
+    double GetUniform(void) { return uniform_distribution_(random_engine_); }
+
+    template <typename Publish>
+    void Send(const Msg &msg, Publish &publish) {
+        ++num_out_;
+        publish(msg);
+    }
+
+    std::default_random_engine &random_engine_;
+    const StressConfig &config_;
+    std::uniform_real_distribution<double> uniform_distribution_;
+
+    Msg held_;
+    std::chrono::steady_clock::time_point held_since_;
+    bool has_held_ = false;
+
+    uint64_t num_in_ = 0;
+    uint64_t num_out_ = 0;
+    uint64_t num_dropped_ = 0;
+    uint64_t num_duplicated_ = 0;
+    uint64_t num_reordered_ = 0;
+};
+
+}  // namespace generator
+
+}  // namespace imu_integration
+
+#endif  // IMU_INTEGRATION_STRESS_SHAPER_HPP_
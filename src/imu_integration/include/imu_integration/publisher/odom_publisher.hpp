@@ -0,0 +1,142 @@
+/*
+ * @Description: publish odometry from a pre-serialized, in-place patched buffer
+ * @Date: 2026-10-18 10:12:46
+ */
+#ifndef IMU_INTEGRATION_ODOM_PUBLISHER_HPP_
+#define IMU_INTEGRATION_ODOM_PUBLISHER_HPP_
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <ros/ros.h>
+#include <ros/serialization.h>
+#include <nav_msgs/Odometry.h>
+
+#include <Eigen/Core>
+#include <Eigen/Dense>
+
+namespace imu_integration {
+
+/**
+ * @brief  nav_msgs/Odometry in wire format. Frame ids and covariances are written once,
+ *         only stamp, pose and twist are patched before each publish
+ */
+struct SerializedOdometry {
+    /**
+     * @brief  lay out the message, identity orientation, zero twist and zero covariances
+     * @param  frame_id, header frame id
+     * @param  child_frame_id, child frame id
+     * @return void
+     */
+    void Init(const std::string &frame_id, const std::string &child_frame_id);
+    /**
+     * @brief  patch header, pose and linear velocity in place
+     * @param  seq, header sequence number
+     * @param  stamp, header stamp
+     * @param  pose, pose in frame_id
+     * @param  vel, linear velocity
+     * @return void
+     */
+    void Patch(uint32_t seq, const ros::Time &stamp, const Eigen::Matrix4d &pose, const Eigen::Vector3d &vel);
+
+    std::vector<uint8_t> buffer;
+
+  private:
+    template <typename T>
+    void Write(uint32_t offset, const T &value) {
+        memcpy(buffer.data() + offset, &value, sizeof(T));
+    }
+
+    void WriteString(uint32_t &offset, const std::string &value);
+
+    // offsets of patched fields:
+    uint32_t pose_offset_ = 0;
+    uint32_t twist_offset_ = 0;
+};
+
+class OdomPublisher {
+  public:
+    /**
+     * @brief  advertise topic and build the serialized message template
+     * @param  nh, node handle
+     * @param  topic_name, topic name
+     * @param  frame_id, header frame id
+     * @param  child_frame_id, child frame id
+     * @param  buff_size, publisher queue size
+     */
+    OdomPublisher(
+        ros::NodeHandle& nh, 
+        std::string topic_name, 
+        std::string frame_id, std::string child_frame_id, 
+        size_t buff_size
+    );
+    OdomPublisher() = default;
+
+    /**
+     * @brief  patch changed fields in place then publish
+     * @param  stamp, header stamp
+     * @param  pose, pose in frame_id
+     * @param  vel, linear velocity
+     * @return void
+     */
+    void Publish(const ros::Time &stamp, const Eigen::Matrix4d &pose, const Eigen::Vector3d &vel);
+
+  private:
+    ros::NodeHandle nh_;
+    ros::Publisher publisher_;
+
+    SerializedOdometry message_;
+    uint32_t seq_ = 0;
+};
+
+} // namespace imu_integration
+
+//
+// SerializedOdometry announces itself as nav_msgs/Odometry, so that it can be
+// published on a topic advertised with the full message type
+//
+namespace ros {
+
+namespace message_traits {
+
+template <>
+struct MD5Sum<imu_integration::SerializedOdometry> {
+    static const char *value() { return MD5Sum<nav_msgs::Odometry>::value(); }
+    static const char *value(const imu_integration::SerializedOdometry &) { return value(); }
+};
+
+template <>
+struct DataType<imu_integration::SerializedOdometry> {
+    static const char *value() { return DataType<nav_msgs::Odometry>::value(); }
+    static const char *value(const imu_integration::SerializedOdometry &) { return value(); }
+};
+
+template <>
+struct Definition<imu_integration::SerializedOdometry> {
+    static const char *value() { return Definition<nav_msgs::Odometry>::value(); }
+    static const char *value(const imu_integration::SerializedOdometry &) { return value(); }
+};
+
+} // namespace message_traits
+
+namespace serialization {
+
+template <>
+struct Serializer<imu_integration::SerializedOdometry> {
+    template <typename Stream>
+    inline static void write(Stream &stream, const imu_integration::SerializedOdometry &message) {
+        const uint32_t length = static_cast<uint32_t>(message.buffer.size());
+        memcpy(stream.advance(length), message.buffer.data(), length);
+    }
+
+    inline static uint32_t serializedLength(const imu_integration::SerializedOdometry &message) {
+        return static_cast<uint32_t>(message.buffer.size());
+    }
+};
+
+} // namespace serialization
+
+} // namespace ros
+
+#endif
@@ -15,6 +15,26 @@ struct IMUData {
     double time = 0.0;
     Eigen::Vector3d linear_acceleration = Eigen::Vector3d::Zero();
     Eigen::Vector3d angular_velocity = Eigen::Vector3d::Zero();
+
+    /**
+     * @brief  interpolate between two bracketing measurements
+     * @param  front_data, measurement before time
+     * @param  back_data, measurement after time
+     * @param  time, interpolation time
+     * @return interpolated IMU measurement
+     */
+    static IMUData Interpolate(const IMUData &front_data, const IMUData &back_data, double time) {
+        const double delta_t = back_data.time - front_data.time;
+        const double front_scale = (delta_t > 0.0) ? (back_data.time - time) / delta_t : 1.0;
+        const double back_scale = 1.0 - front_scale;
+
+        IMUData synced_data;
+        synced_data.time = time;
+        synced_data.linear_acceleration = front_scale * front_data.linear_acceleration + back_scale * back_data.linear_acceleration;
+        synced_data.angular_velocity = front_scale * front_data.angular_velocity + back_scale * back_data.angular_velocity;
+
+        return synced_data;
+    }
 };
 
 } // namespace imu_integration
@@ -0,0 +1,21 @@
+/*
+ * @Description: magnetometer data
+ * @Date: 2026-10-18 14:08:51
+ */
+#ifndef IMU_INTEGRATION_MAGNETOMETER_DATA_HPP_
+#define IMU_INTEGRATION_MAGNETOMETER_DATA_HPP_
+
+#include <Eigen/Dense>
+#include <Eigen/Core>
+
+namespace imu_integration {
+
+struct MagnetometerData {
+    double time = 0.0;
+    // in IMU frame, in tesla:
+    Eigen::Vector3d magnetic_field = Eigen::Vector3d::Zero();
+};
+
+} // namespace imu_integration
+
+#endif
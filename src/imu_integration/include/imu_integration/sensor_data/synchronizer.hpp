@@ -0,0 +1,259 @@
+/*
+ * @Description: approximate time synchronization of sensor streams against a reference stream
+ * @Date: 2026-10-18 16:08:33
+ */
+#ifndef IMU_INTEGRATION_SYNCHRONIZER_HPP_
+#define IMU_INTEGRATION_SYNCHRONIZER_HPP_
+
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include <Eigen/Core>
+#include <Eigen/StdVector>
+
+namespace imu_integration {
+
+/**
+ * @brief  fixed capacity ring of measurements sorted by time, the oldest is overwritten when full
+ */
+template <typename T>
+class TimeRingBuffer {
+  public:
+    explicit TimeRingBuffer(size_t capacity) : data_(capacity) {}
+
+    /**
+     * @brief  append measurement
+     * @param  data, measurement, must not be older than the latest one
+     * @return false if rejected as out of order or the oldest measurement was overwritten
+     */
+    bool Push(const T &data) {
+        if (size_ > 0 && data.time < Back().time) {
+            return false;
+        }
+
+        bool overwritten = false;
+        if (size_ == data_.size()) {
+            PopFront();
+            overwritten = true;
+        }
+
+        data_[(head_ + size_) % data_.size()] = data;
+        ++size_;
+
+        return !overwritten;
+    }
+
+    void PopFront(void) {
+        head_ = (head_ + 1) % data_.size();
+        --size_;
+    }
+
+    bool Empty(void) const { return size_ == 0; }
+    size_t Size(void) const { return size_; }
+    const T &At(size_t index) const { return data_[(head_ + index) % data_.size()]; }
+    const T &Front(void) const { return At(0); }
+    const T &Back(void) const { return At(size_ - 1); }
+
+    /**
+     * @brief  binary search
+     * @param  time, query time
+     * @return index of the first measurement later than time, Size() if none
+     */
+    size_t UpperBound(double time) const {
+        size_t lower = 0, upper = size_;
+        while (lower < upper) {
+            const size_t middle = lower + (upper - lower) / 2;
+            if (At(middle).time <= time) {
+                lower = middle + 1;
+            } else {
+                upper = middle;
+            }
+        }
+        return lower;
+    }
+
+  private:
+    std::vector<T, Eigen::aligned_allocator<T>> data_;
+    size_t head_ = 0;
+    size_t size_ = 0;
+};
+
+namespace synchronizer {
+
+// compile-time index list, std::index_sequence is not available in C++11:
+template <size_t... I>
+struct IndexSequence {};
+
+template <size_t N, size_t... I>
+struct MakeIndexSequence : MakeIndexSequence<N - 1, N - 1, I...> {};
+
+template <size_t... I>
+struct MakeIndexSequence<0, I...> {
+    typedef IndexSequence<I...> type;
+};
+
+} // namespace synchronizer
+
+/**
+ * @brief  aligns any number of streams to the stamps of a reference stream.
+ *         Each stream type provides member time and static T Interpolate(front, back, time).
+ *         A reference measurement is emitted once every stream brackets its stamp, and dropped
+ *         when a bracket is wider than max_gap or it has waited longer than max_latency.
+ *         Memory is bounded by per-stream ring buffers
+ */
+template <typename Reference, typename... Streams>
+class ApproximateTimeSynchronizer {
+  public:
+    typedef std::tuple<Reference, Streams...> Synced;
+
+    /**
+     * @brief  constructor
+     * @param  capacity, ring buffer capacity per stream
+     * @param  max_gap, largest distance in seconds from reference stamp to either bracketing measurement
+     * @param  max_latency, longest time in seconds a reference measurement waits for the other streams
+     */
+    ApproximateTimeSynchronizer(size_t capacity, double max_gap, double max_latency)
+        : references_(capacity), streams_(TimeRingBuffer<Streams>(capacity)...),
+          max_gap_(max_gap), max_latency_(max_latency) {}
+
+    void AddReference(const Reference &data) {
+        if (!references_.Push(data)) {
+            ++num_overwritten_;
+        }
+    }
+
+    template <size_t I>
+    void Add(const typename std::tuple_element<I, std::tuple<Streams...>>::type &data) {
+        if (!std::get<I>(streams_).Push(data)) {
+            ++num_overwritten_;
+        }
+    }
+
+    /**
+     * @brief  emit the oldest reference measurement that can be synchronized
+     * @param  synced, output, reference measurement followed by interpolated measurements of each stream
+     * @return true if success false if the oldest pending reference measurement still waits
+     */
+    bool Pop(Synced &synced) {
+        while (!references_.Empty()) {
+            const double time = references_.Front().time;
+            const Status status = Check(time, Indices());
+
+            if (status == Status::WAIT && references_.Back().time - time <= max_latency_) {
+                return false;
+            }
+
+            if (status != Status::READY) {
+                references_.PopFront();
+                ++num_dropped_;
+                continue;
+            }
+
+            std::get<0>(synced) = references_.Front();
+            Interpolate(time, synced, Indices());
+            references_.PopFront();
+            ++num_synced_;
+
+            return true;
+        }
+
+        return false;
+    }
+
+    uint64_t GetNumSynced(void) const { return num_synced_; }
+    uint64_t GetNumDropped(void) const { return num_dropped_; }
+    uint64_t GetNumOverwritten(void) const { return num_overwritten_; }
+
+  private:
+    enum class Status {
+        READY,
+        WAIT,
+        DROP
+    };
+
+    typedef typename synchronizer::MakeIndexSequence<sizeof...(Streams)>::type Indices;
+
+    template <size_t I>
+    Status Check(double time) const {
+        const auto &buffer = std::get<I>(streams_);
+
+        // streams arrive in order, a stream starting after the reference can never bracket it:
+        if (buffer.Empty()) {
+            return Status::WAIT;
+        }
+        if (buffer.Front().time > time) {
+            return Status::DROP;
+        }
+
+        const size_t index = buffer.UpperBound(time);
+        if (index == buffer.Size()) {
+            return (buffer.Back().time == time) ? Status::READY : Status::WAIT;
+        }
+
+        // measurements are lost if either neighbor is too far away:
+        if (
+            time - buffer.At(index - 1).time > max_gap_ || 
+            buffer.At(index).time - time > max_gap_
+        ) {
+            return Status::DROP;
+        }
+
+        return Status::READY;
+    }
+
+    template <size_t... I>
+    Status Check(double time, synchronizer::IndexSequence<I...>) const {
+        // leading READY keeps the array non-empty without streams:
+        const Status statuses[] = {Status::READY, Check<I>(time)...};
+
+        Status status = Status::READY;
+        for (const Status &s: statuses) {
+            if (s == Status::DROP) {
+                return Status::DROP;
+            }
+            if (s == Status::WAIT) {
+                status = Status::WAIT;
+            }
+        }
+
+        return status;
+    }
+
+    template <size_t I>
+    int Interpolate(double time, Synced &synced) {
+        typedef typename std::tuple_element<I, std::tuple<Streams...>>::type Type;
+        TimeRingBuffer<Type> &buffer = std::get<I>(streams_);
+
+        const size_t index = buffer.UpperBound(time);
+        const Type &back_data = (index == buffer.Size()) ? buffer.Back() : buffer.At(index);
+        std::get<I + 1>(synced) = Type::Interpolate(buffer.At(index - 1), back_data, time);
+
+        // reference stamps increase, keep only the measurement just before this one:
+        while (buffer.Size() > 1 && buffer.At(1).time <= time) {
+            buffer.PopFront();
+        }
+
+        return 0;
+    }
+
+    template <size_t... I>
+    void Interpolate(double time, Synced &synced, synchronizer::IndexSequence<I...>) {
+        const int expand[] = {0, Interpolate<I>(time, synced)...};
+        (void)expand;
+    }
+
+    TimeRingBuffer<Reference> references_;
+    std::tuple<TimeRingBuffer<Streams>...> streams_;
+
+    const double max_gap_;
+    const double max_latency_;
+
+    uint64_t num_synced_ = 0;
+    uint64_t num_dropped_ = 0;
+    uint64_t num_overwritten_ = 0;
+};
+
+} // namespace imu_integration
+
+#endif
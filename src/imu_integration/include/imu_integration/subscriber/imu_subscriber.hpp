@@ -14,17 +14,28 @@
 #include <sensor_msgs/Imu.h>
 
 #include "imu_integration/sensor_data/imu_data.hpp"
+#include "imu_integration/tools/runtime_stats.hpp"
 
 namespace imu_integration {
 
 class IMUSubscriber {
   public:
-    IMUSubscriber(ros::NodeHandle& nh, std::string topic_name, size_t buff_size);
+    /**
+     * @brief  subscribe to topic
+     * @param  nh, node handle
+     * @param  topic_name, topic name
+     * @param  buff_size, subscriber queue size
+     * @param  lightweight, decode IMUData straight from the wire buffer instead of the full ROS message
+     */
+    IMUSubscriber(ros::NodeHandle& nh, std::string topic_name, size_t buff_size, bool lightweight = true);
     IMUSubscriber() = default;
     void ParseData(std::deque<IMUData>& imu_data);
+    const SubscriberStats& GetStats(void) const { return stats_; }
 
   private:
     void msg_callback(const sensor_msgs::ImuConstPtr& imu_msg_ptr);
+    void data_callback(const boost::shared_ptr<const IMUData>& imu_data_ptr);
+    void AddData(const IMUData& imu_data);
 
   private:
     ros::NodeHandle nh_;
@@ -32,6 +43,8 @@ class IMUSubscriber {
     std::deque<IMUData> imu_data_;
 
     std::mutex buff_mutex_; 
+
+    SubscriberStats stats_;
 };
 
 } // namespace imu_integration
@@ -0,0 +1,42 @@
+/*
+ * @Description: Subscribe to ROS magnetic field message
+ * @Date: 2026-10-18 14:08:51
+ */
+#ifndef IMU_INTEGRATION_MAGNETOMETER_SUBSCRIBER_HPP_
+#define IMU_INTEGRATION_MAGNETOMETER_SUBSCRIBER_HPP_
+
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include <ros/ros.h>
+#include <sensor_msgs/MagneticField.h>
+
+#include "imu_integration/sensor_data/magnetometer_data.hpp"
+#include "imu_integration/tools/runtime_stats.hpp"
+
+namespace imu_integration {
+
+class MagnetometerSubscriber {
+  public:
+    MagnetometerSubscriber(ros::NodeHandle& nh, std::string topic_name, size_t buff_size);
+    MagnetometerSubscriber() = default;
+    void ParseData(std::deque<MagnetometerData>& magnetometer_data);
+    const SubscriberStats& GetStats(void) const { return stats_; }
+
+  private:
+    void msg_callback(const sensor_msgs::MagneticFieldConstPtr& magnetic_field_msg_ptr);
+
+  private:
+    ros::NodeHandle nh_;
+    ros::Subscriber subscriber_;
+    std::deque<MagnetometerData> magnetometer_data_;
+
+    std::mutex buff_mutex_; 
+
+    SubscriberStats stats_;
+};
+
+} // namespace imu_integration
+
+#endif
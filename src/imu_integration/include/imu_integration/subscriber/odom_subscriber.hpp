@@ -14,17 +14,28 @@
 #include <nav_msgs/Odometry.h>
 
 #include "imu_integration/sensor_data/odom_data.hpp"
+#include "imu_integration/tools/runtime_stats.hpp"
 
 namespace imu_integration {
 
 class OdomSubscriber {
   public:
-    OdomSubscriber(ros::NodeHandle& nh, std::string topic_name, size_t buff_size);
+    /**
+     * @brief  subscribe to topic
+     * @param  nh, node handle
+     * @param  topic_name, topic name
+     * @param  buff_size, subscriber queue size
+     * @param  lightweight, decode OdomData straight from the wire buffer instead of the full ROS message
+     */
+    OdomSubscriber(ros::NodeHandle& nh, std::string topic_name, size_t buff_size, bool lightweight = true);
     OdomSubscriber() = default;
     void ParseData(std::deque<OdomData>& odom_data);
+    const SubscriberStats& GetStats(void) const { return stats_; }
 
   private:
     void msg_callback(const nav_msgs::OdometryConstPtr& odom_msg_ptr);
+    void data_callback(const boost::shared_ptr<const OdomData>& odom_data_ptr);
+    void AddData(const OdomData& odom_data);
 
   private:
     ros::NodeHandle nh_;
@@ -32,6 +43,8 @@ class OdomSubscriber {
     std::deque<OdomData> odom_data_;
 
     std::mutex buff_mutex_; 
+
+    SubscriberStats stats_;
 };
 
 } // namespace imu_integration
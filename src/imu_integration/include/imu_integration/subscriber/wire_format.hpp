@@ -0,0 +1,164 @@
+/*
+ * @Description: deserialize IMU and odometry messages straight from the wire buffer
+ * @Date: 2026-10-18 14:36:19
+ */
+#ifndef IMU_INTEGRATION_WIRE_FORMAT_HPP_
+#define IMU_INTEGRATION_WIRE_FORMAT_HPP_
+
+#include <ros/ros.h>
+#include <ros/serialization.h>
+#include <sensor_msgs/Imu.h>
+#include <nav_msgs/Odometry.h>
+
+#include "imu_integration/sensor_data/imu_data.hpp"
+#include "imu_integration/sensor_data/odom_data.hpp"
+
+//
+// IMUData and OdomData announce themselves as sensor_msgs/Imu and nav_msgs/Odometry,
+// so that they can be subscribed to directly. Only the fields the estimator reads are
+// decoded, covariances are skipped and frame ids are never copied into std::string
+//
+namespace ros {
+
+namespace message_traits {
+
+template <>
+struct MD5Sum<imu_integration::IMUData> {
+    static const char *value() { return MD5Sum<sensor_msgs::Imu>::value(); }
+    static const char *value(const imu_integration::IMUData &) { return value(); }
+};
+
+template <>
+struct DataType<imu_integration::IMUData> {
+    static const char *value() { return DataType<sensor_msgs::Imu>::value(); }
+    static const char *value(const imu_integration::IMUData &) { return value(); }
+};
+
+template <>
+struct Definition<imu_integration::IMUData> {
+    static const char *value() { return Definition<sensor_msgs::Imu>::value(); }
+    static const char *value(const imu_integration::IMUData &) { return value(); }
+};
+
+template <>
+struct MD5Sum<imu_integration::OdomData> {
+    static const char *value() { return MD5Sum<nav_msgs::Odometry>::value(); }
+    static const char *value(const imu_integration::OdomData &) { return value(); }
+};
+
+template <>
+struct DataType<imu_integration::OdomData> {
+    static const char *value() { return DataType<nav_msgs::Odometry>::value(); }
+    static const char *value(const imu_integration::OdomData &) { return value(); }
+};
+
+template <>
+struct Definition<imu_integration::OdomData> {
+    static const char *value() { return Definition<nav_msgs::Odometry>::value(); }
+    static const char *value(const imu_integration::OdomData &) { return value(); }
+};
+
+} // namespace message_traits
+
+namespace serialization {
+
+namespace wire_format {
+
+template <typename Stream>
+inline double ReadStamp(Stream &stream) {
+    // seq, stamp.sec, stamp.nsec:
+    uint32_t seq, sec, nsec;
+    stream.next(seq);
+    stream.next(sec);
+    stream.next(nsec);
+
+    return ros::Time(sec, nsec).toSec();
+}
+
+template <typename Stream>
+inline void SkipString(Stream &stream) {
+    uint32_t length;
+    stream.next(length);
+    stream.advance(length);
+}
+
+template <typename Stream>
+inline void SkipDoubles(Stream &stream, uint32_t n) {
+    stream.advance(n * static_cast<uint32_t>(sizeof(double)));
+}
+
+template <typename Stream>
+inline void ReadVector3(Stream &stream, Eigen::Vector3d &v) {
+    stream.next(v.x());
+    stream.next(v.y());
+    stream.next(v.z());
+}
+
+} // namespace wire_format
+
+template <>
+struct Serializer<imu_integration::IMUData> {
+    /**
+     * @brief  decode sensor_msgs/Imu wire format
+     * @param  stream, serialized sensor_msgs/Imu
+     * @param  imu_data, output
+     * @return void
+     */
+    template <typename Stream>
+    inline static void read(Stream &stream, imu_integration::IMUData &imu_data) {
+        // a. header:
+        imu_data.time = wire_format::ReadStamp(stream);
+        wire_format::SkipString(stream);
+
+        // b. orientation and orientation covariance:
+        wire_format::SkipDoubles(stream, 4 + 9);
+
+        // c. angular velocity, skip covariance:
+        wire_format::ReadVector3(stream, imu_data.angular_velocity);
+        wire_format::SkipDoubles(stream, 9);
+
+        // d. linear acceleration, skip covariance:
+        wire_format::ReadVector3(stream, imu_data.linear_acceleration);
+        wire_format::SkipDoubles(stream, 9);
+    }
+};
+
+template <>
+struct Serializer<imu_integration::OdomData> {
+    /**
+     * @brief  decode nav_msgs/Odometry wire format
+     * @param  stream, serialized nav_msgs/Odometry
+     * @param  odom_data, output
+     * @return void
+     */
+    template <typename Stream>
+    inline static void read(Stream &stream, imu_integration::OdomData &odom_data) {
+        // a. header and child frame id:
+        odom_data.time = wire_format::ReadStamp(stream);
+        wire_format::SkipString(stream);
+        wire_format::SkipString(stream);
+
+        // b. pose, skip covariance:
+        Eigen::Vector3d t;
+        wire_format::ReadVector3(stream, t);
+        double qx, qy, qz, qw;
+        stream.next(qx);
+        stream.next(qy);
+        stream.next(qz);
+        stream.next(qw);
+        wire_format::SkipDoubles(stream, 36);
+
+        odom_data.pose.block<3, 3>(0, 0) = Eigen::Quaterniond(qw, qx, qy, qz).toRotationMatrix();
+        odom_data.pose.block<3, 1>(0, 3) = t;
+
+        // c. linear velocity, skip angular velocity and covariance:
+        wire_format::ReadVector3(stream, odom_data.vel);
+        wire_format::SkipDoubles(stream, 3 + 36);
+    }
+};
+
+} // namespace serialization
+
+} // namespace ros
+
+#endif
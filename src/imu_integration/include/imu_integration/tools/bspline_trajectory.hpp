@@ -0,0 +1,117 @@
+/*
+ * @Description: continuous-time trajectory as a cumulative cubic B-spline, built from a pose stream
+ * @Date: 2026-10-18 09:26:14
+ */
+#ifndef IMU_INTEGRATION_BSPLINE_TRAJECTORY_HPP_
+#define IMU_INTEGRATION_BSPLINE_TRAJECTORY_HPP_
+
+#include <cstddef>
+#include <deque>
+
+#include <Eigen/Dense>
+#include <Eigen/Core>
+
+namespace imu_integration {
+
+//
+// Split cumulative cubic B-spline on uniform knots, SO(3) for orientation and R^3 for position.
+// Incoming poses are resampled onto the knots, and each knot is prefiltered with its neighbors
+// so that the spline passes through the samples up to O(h^4) instead of smoothing them.
+// Control point differences are cached per knot interval when it becomes complete, about three
+// knots behind the latest sample, so an evaluation is a cubic basis and three SO(3) exponentials
+//
+class BSplineTrajectory {
+  public:
+    struct Params {
+        // knot spacing in seconds, about the pose sample period:
+        double knot_spacing = 0.01;
+        // a gap between samples longer than this in seconds restarts the spline:
+        double max_gap = 0.1;
+        // knot intervals kept, oldest are dropped first, 0 keeps all:
+        size_t max_segments = 0;
+        // prefilter knots so the spline passes through them, false for a smoother approximating spline:
+        bool interpolate = true;
+    };
+
+    struct State {
+        // orientation and position in navigation frame:
+        Eigen::Matrix3d R = Eigen::Matrix3d::Identity();
+        Eigen::Vector3d t = Eigen::Vector3d::Zero();
+        // velocity and acceleration in navigation frame:
+        Eigen::Vector3d v = Eigen::Vector3d::Zero();
+        Eigen::Vector3d a = Eigen::Vector3d::Zero();
+        // angular velocity in body frame:
+        Eigen::Vector3d angular_vel = Eigen::Vector3d::Zero();
+    };
+
+    explicit BSplineTrajectory(const Params &params);
+
+    /**
+     * @brief  append a pose sample
+     * @param  time, sample stamp, after the previous one
+     * @param  pose, pose in navigation frame
+     * @return true if appended false if out of order
+     */
+    bool AddPose(double time, const Eigen::Matrix4d &pose);
+
+    void Reset(void);
+
+    // evaluable time range, empty while start time is not before end time:
+    double GetStartTime(void) const { return GetKnotTime(first_segment_); }
+    double GetEndTime(void) const { return GetKnotTime(first_segment_ + segments_.size()); }
+    bool IsInRange(double time) const {
+        return !segments_.empty() && time >= GetStartTime() && time <= GetEndTime();
+    }
+
+    /**
+     * @brief  evaluate pose and its derivatives in O(1)
+     * @param  time, evaluation time
+     * @param  state, output
+     * @return true if time is in range false otherwise
+     */
+    bool Evaluate(double time, State &state) const;
+
+    size_t GetNumSegments(void) const { return segments_.size(); }
+
+  private:
+    struct Knot {
+        Eigen::Matrix3d R;
+        Eigen::Vector3d t;
+    };
+
+    // cached per knot interval, from its four control points:
+    struct Segment {
+        Eigen::Matrix3d R;
+        Eigen::Vector3d t;
+        // consecutive control point differences:
+        Eigen::Vector3d delta_t[3];
+        Eigen::Vector3d delta_phi[3];
+    };
+
+    double GetKnotTime(size_t index) const { return start_time_ + index * params_.knot_spacing; }
+    void AddKnot(const Knot &knot);
+    void AddControlPoint(const Knot &control_point);
+
+    const Params params_;
+
+    // latest sample, knots are interpolated between it and the next:
+    bool has_sample_ = false;
+    double sample_time_ = 0.0;
+    Knot sample_;
+
+    // time of knot 0:
+    double start_time_ = 0.0;
+    size_t num_knots_ = 0;
+    size_t num_control_points_ = 0;
+    // neighbors of the knot being prefiltered and the control points of the next segment:
+    std::deque<Knot> knots_;
+    std::deque<Knot> control_points_;
+
+    // segment i spans knot i to knot i + 1:
+    std::deque<Segment> segments_;
+    size_t first_segment_ = 0;
+};
+
+} // namespace imu_integration
+
+#endif
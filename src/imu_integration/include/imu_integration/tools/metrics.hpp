@@ -0,0 +1,113 @@
+/*
+ * @Description: Prometheus text exposition of runtime counters and histograms
+ * @Date: 2026-10-18 11:21:05
+ */
+#ifndef IMU_INTEGRATION_METRICS_HPP_
+#define IMU_INTEGRATION_METRICS_HPP_
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "imu_integration/tools/runtime_stats.hpp"
+
+namespace imu_integration {
+
+/**
+ * @brief  read-only view of counters and histograms owned by an activity.
+ *         Register everything before the exporter starts, rendering only reads relaxed atomics
+ */
+class MetricsRegistry {
+  public:
+    /**
+     * @brief  register counter
+     * @param  name, metric name, should end with _total
+     * @param  help, help text
+     * @param  labels, label set without braces, e.g. stage="UpdatePose", may be empty
+     * @param  counter, counter, must outlive the registry
+     * @return void
+     */
+    void AddCounter(
+        const std::string &name, const std::string &help, const std::string &labels,
+        const ShardedCounter *counter
+    );
+    void AddGauge(
+        const std::string &name, const std::string &help, const std::string &labels,
+        const std::function<double(void)> &getter
+    );
+    /**
+     * @brief  register histogram, exported in seconds
+     * @param  name, metric name, should end with _seconds
+     * @param  help, help text
+     * @param  labels, label set without braces, may be empty
+     * @param  histogram, histogram of nanosecond durations, must outlive the registry
+     * @return void
+     */
+    void AddHistogram(
+        const std::string &name, const std::string &help, const std::string &labels,
+        const LatencyHistogram *histogram
+    );
+
+    std::string Render(void) const;
+
+  private:
+    enum class Type {
+        COUNTER,
+        GAUGE,
+        HISTOGRAM
+    };
+
+    struct Metric {
+        Type type;
+        std::string name;
+        std::string help;
+        std::string labels;
+        const ShardedCounter *counter = nullptr;
+        std::function<double(void)> getter;
+        const LatencyHistogram *histogram = nullptr;
+    };
+
+    std::vector<Metric> metrics_;
+};
+
+/**
+ * @brief  serves a registry on a localhost HTTP endpoint and/or rewrites a
+ *         node-exporter textfile-collector file, both from one background thread
+ */
+class MetricsExporter {
+  public:
+    explicit MetricsExporter(const MetricsRegistry &registry);
+    ~MetricsExporter(void);
+    MetricsExporter(const MetricsExporter &) = delete;
+    MetricsExporter &operator=(const MetricsExporter &) = delete;
+
+    /**
+     * @brief  start exporting
+     * @param  port, localhost HTTP port, 0 to disable the endpoint
+     * @param  textfile_path, textfile-collector output, empty to disable
+     * @param  period, textfile rewrite period in seconds
+     * @return true if success false otherwise
+     */
+    bool Start(int port, const std::string &textfile_path, double period);
+    void Stop(void);
+
+  private:
+    void Loop(void);
+    void ServeClient(int client_fd);
+    void WriteTextfile(void);
+
+    const MetricsRegistry &registry_;
+
+    int listen_fd_ = -1;
+    std::string textfile_path_;
+    double period_ = 1.0;
+
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+};
+
+} // namespace imu_integration
+
+#endif
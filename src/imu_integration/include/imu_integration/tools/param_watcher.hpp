@@ -0,0 +1,58 @@
+/*
+ * @Description: runtime reload of IMU bias, gravity and noise parameters
+ * @Date: 2026-10-18 16:45:30
+ */
+#ifndef IMU_INTEGRATION_PARAM_WATCHER_HPP_
+#define IMU_INTEGRATION_PARAM_WATCHER_HPP_
+
+#include <ros/ros.h>
+#include <std_srvs/Trigger.h>
+
+#include "imu_integration/config/config.hpp"
+#include "imu_integration/tools/seqlock.hpp"
+
+namespace imu_integration {
+
+/**
+ * @brief  advertises ~reload_imu_params. On call the imu gravity, bias and noise
+ *         parameters are re-read from the parameter server and published through a seqlock,
+ *         so the integration thread picks them up at its next sample without locking
+ */
+class IMUParamsWatcher {
+  public:
+    IMUParamsWatcher(ros::NodeHandle& nh, const IMUParams& params);
+
+    /**
+     * @brief  get latest parameters if they changed since the previous call, integration thread only
+     * @param  params, latest parameters output
+     * @return true if updated false otherwise
+     */
+    bool GetUpdate(IMUParams& params) {
+        if (params_.GetVersion() == version_) {
+            return false;
+        }
+        version_ = params_.Load(params);
+        return true;
+    }
+
+    static IMUParams GetParams(const IMUConfig& config);
+    static void SetParams(const IMUParams& params, IMUConfig& config);
+
+  private:
+    bool ReloadCallback(std_srvs::Trigger::Request& request, std_srvs::Trigger::Response& response);
+
+  private:
+    ros::NodeHandle nh_;
+    ros::ServiceServer service_;
+
+    // writer side, defaults for parameters missing from the parameter server:
+    IMUParams params_curr_;
+    SeqLock<IMUParams> params_;
+
+    // reader side:
+    uint64_t version_ = 0;
+};
+
+} // namespace imu_integration
+
+#endif
@@ -0,0 +1,57 @@
+/*
+ * @Description: hardware performance counters through perf_event_open
+ * @Date: 2026-10-18 09:40:12
+ */
+#ifndef IMU_INTEGRATION_PERF_COUNTERS_HPP_
+#define IMU_INTEGRATION_PERF_COUNTERS_HPP_
+
+#include <cstdint>
+#include <string>
+
+namespace imu_integration {
+
+struct PerfCounterValues {
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+    uint64_t cache_misses = 0;
+    uint64_t branch_misses = 0;
+    // wall clock, always available:
+    uint64_t elapsed_ns = 0;
+};
+
+/**
+ * @brief  counter group of cycles, instructions, cache misses and branch misses for the calling thread.
+ *         When the kernel refuses the counters (no PMU, perf_event_paranoid, containers)
+ *         only the wall clock is measured
+ */
+class PerfCounters {
+  public:
+    PerfCounters(void);
+    ~PerfCounters(void);
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+
+    bool IsAvailable(void) const { return group_fd_ >= 0; }
+    const std::string &GetError(void) const { return error_; }
+
+    void Start(void);
+    /**
+     * @brief  stop counting and read counter values since last Start
+     * @param  values, counter values output
+     * @return true if hardware counters were read false if only wall clock is valid
+     */
+    bool Stop(PerfCounterValues &values);
+
+  private:
+    enum { CYCLES = 0, INSTRUCTIONS, CACHE_MISSES, BRANCH_MISSES, NUM_COUNTERS };
+
+    int fds_[NUM_COUNTERS];
+    int group_fd_ = -1;
+    std::string error_;
+
+    uint64_t start_ns_ = 0;
+};
+
+} // namespace imu_integration
+
+#endif
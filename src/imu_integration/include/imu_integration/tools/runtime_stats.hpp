@@ -0,0 +1,152 @@
+/*
+ * @Description: lock-free runtime counters and latency histograms
+ * @Date: 2026-10-18 15:02:27
+ */
+#ifndef IMU_INTEGRATION_RUNTIME_STATS_HPP_
+#define IMU_INTEGRATION_RUNTIME_STATS_HPP_
+
+#include <time.h>
+
+#include <atomic>
+#include <cstdint>
+
+namespace imu_integration {
+
+/**
+ * @brief  raise high-water mark to value if it is larger
+ * @param  high_water_mark, target
+ * @param  value, candidate
+ * @return void
+ */
+inline void UpdateHighWaterMark(std::atomic<uint64_t> &high_water_mark, uint64_t value) {
+    uint64_t curr = high_water_mark.load(std::memory_order_relaxed);
+    while (
+        curr < value &&
+        !high_water_mark.compare_exchange_weak(curr, value, std::memory_order_relaxed)
+    ) {}
+}
+
+/**
+ * @brief  CPU time consumed by the calling thread
+ * @return CPU time in nanoseconds
+ */
+inline uint64_t GetThreadCPUTime(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+/**
+ * @brief  monotonic counter split into per-thread shards on separate cache lines,
+ *         so that writers never share a line with each other or with readers' sums
+ */
+class ShardedCounter {
+  public:
+    static constexpr int kNumShards = 16;
+
+    ShardedCounter(void) = default;
+    ShardedCounter(const ShardedCounter &) = delete;
+    ShardedCounter &operator=(const ShardedCounter &) = delete;
+
+    void Add(uint64_t n = 1) {
+        shards_[GetShardIndex()].value.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    uint64_t Get(void) const {
+        uint64_t sum = 0;
+        for (int i = 0; i < kNumShards; ++i) {
+            sum += shards_[i].value.load(std::memory_order_relaxed);
+        }
+        return sum;
+    }
+
+  private:
+    struct Shard {
+        std::atomic<uint64_t> value{0};
+        char pad[64 - sizeof(std::atomic<uint64_t>)];
+    };
+
+    // threads are assigned shards round robin on first use:
+    static int GetShardIndex(void);
+
+    Shard shards_[kNumShards];
+};
+
+/**
+ * @brief  log-linear histogram of nanosecond durations, 4 sub-buckets per power of two.
+ *         Record is wait-free and may be called from any thread
+ */
+class LatencyHistogram {
+  public:
+    static constexpr int kNumBuckets = 252;
+
+    struct Snapshot {
+        uint64_t counts[kNumBuckets] = {};
+        uint64_t sum = 0;
+
+        uint64_t GetTotal(void) const;
+        /**
+         * @brief  get percentile as bucket upper bound
+         * @param  p, percentile in [0, 1]
+         * @return duration in nanoseconds, 0 if no samples
+         */
+        double GetPercentile(double p) const;
+        /**
+         * @brief  get counts recorded since previous snapshot
+         * @param  prev, previous snapshot
+         * @return difference
+         */
+        Snapshot operator-(const Snapshot &prev) const;
+    };
+
+    LatencyHistogram(void);
+
+    void Record(uint64_t duration_ns) {
+        counts_[GetBucketIndex(duration_ns)].fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(duration_ns, std::memory_order_relaxed);
+    }
+
+    void GetSnapshot(Snapshot &snapshot) const;
+
+    static int GetBucketIndex(uint64_t duration_ns);
+    static uint64_t GetBucketLowerBound(int index);
+
+  private:
+    std::atomic<uint64_t> counts_[kNumBuckets];
+    std::atomic<uint64_t> sum_{0};
+};
+
+/**
+ * @brief  records the thread CPU time of its enclosing scope into a histogram,
+ *         a null histogram skips both clock reads
+ */
+class ScopedCPUTimer {
+  public:
+    explicit ScopedCPUTimer(LatencyHistogram *histogram)
+        : histogram_(histogram), begin_ns_(histogram ? GetThreadCPUTime() : 0) {}
+    explicit ScopedCPUTimer(LatencyHistogram &histogram) : ScopedCPUTimer(&histogram) {}
+
+    ~ScopedCPUTimer(void) {
+        if (histogram_) {
+            histogram_->Record(GetThreadCPUTime() - begin_ns_);
+        }
+    }
+
+    ScopedCPUTimer(const ScopedCPUTimer &) = delete;
+    ScopedCPUTimer &operator=(const ScopedCPUTimer &) = delete;
+
+  private:
+    LatencyHistogram *histogram_;
+    uint64_t begin_ns_;
+};
+
+struct SubscriberStats {
+    // number of received messages:
+    ShardedCounter num_received;
+    // largest backlog waiting for ParseData:
+    std::atomic<uint64_t> buffer_high_water_mark{0};
+};
+
+} // namespace imu_integration
+
+#endif
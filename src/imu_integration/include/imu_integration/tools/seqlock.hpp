@@ -0,0 +1,131 @@
+/*
+ * @Description: single-writer sequence lock for small trivially copyable snapshots
+ * @Date: 2026-10-18 16:45:30
+ */
+#ifndef IMU_INTEGRATION_SEQLOCK_HPP_
+#define IMU_INTEGRATION_SEQLOCK_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace imu_integration {
+
+/**
+ * @brief  readers never block the writer and the writer never blocks readers, a reader
+ *         retries only if it overlapped a write. The payload is stored as relaxed atomic
+ *         words, so torn reads are detected rather than being data races
+ */
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock payload must be trivially copyable");
+
+  public:
+    SeqLock(void) {
+        T value;
+        memset(&value, 0, sizeof(T));
+        Store(value);
+        sequence_.store(0, std::memory_order_relaxed);
+    }
+
+    explicit SeqLock(const T &value) : SeqLock() {
+        Store(value);
+    }
+
+    SeqLock(const SeqLock &) = delete;
+    SeqLock &operator=(const SeqLock &) = delete;
+
+    /**
+     * @brief  publish new value, single writer only
+     * @param  value, new value
+     * @return void
+     */
+    void Store(const T &value) {
+        uint64_t words[kNumWords] = {};
+        memcpy(words, &value, sizeof(T));
+
+        const uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+        // odd sequence marks a write in progress:
+        sequence_.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < kNumWords; ++i) {
+            words_[i].store(words[i], std::memory_order_relaxed);
+        }
+        sequence_.store(sequence + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief  read a consistent value, any number of readers
+     * @param  value, output
+     * @return version of the value read, even
+     */
+    uint64_t Load(T &value) const {
+        uint64_t words[kNumWords];
+        uint64_t sequence_begin, sequence_end;
+
+        do {
+            sequence_begin = sequence_.load(std::memory_order_acquire);
+            for (size_t i = 0; i < kNumWords; ++i) {
+                words[i] = words_[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            sequence_end = sequence_.load(std::memory_order_relaxed);
+        } while ((sequence_begin & 1) || sequence_begin != sequence_end);
+
+        memcpy(&value, words, sizeof(T));
+
+        return sequence_begin;
+    }
+
+    /**
+     * @brief  single read attempt, for readers that must not spin on a writer that may have died
+     * @param  value, output, only valid on success
+     * @return true if a consistent value was read false otherwise
+     */
+    bool TryLoad(T &value) const {
+        uint64_t words[kNumWords];
+
+        const uint64_t sequence_begin = sequence_.load(std::memory_order_acquire);
+        if (sequence_begin & 1) {
+            return false;
+        }
+        for (size_t i = 0; i < kNumWords; ++i) {
+            words[i] = words_[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence_.load(std::memory_order_relaxed) != sequence_begin) {
+            return false;
+        }
+
+        memcpy(&value, words, sizeof(T));
+
+        return true;
+    }
+
+    /**
+     * @brief  get current version, cheap check whether a reload is needed
+     * @return version, changes on every Store
+     */
+    uint64_t GetVersion(void) const {
+        return sequence_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief  required when the lock is shared between processes
+     * @return true if no hidden mutex is involved
+     */
+    bool IsLockFree(void) const {
+        return sequence_.is_lock_free() && words_[0].is_lock_free();
+    }
+
+  private:
+    static constexpr size_t kNumWords = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    std::atomic<uint64_t> sequence_{0};
+    std::atomic<uint64_t> words_[kNumWords];
+};
+
+} // namespace imu_integration
+
+#endif
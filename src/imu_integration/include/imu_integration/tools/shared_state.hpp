@@ -0,0 +1,151 @@
+/*
+ * @Description: latest navigation state broadcast through a shared memory seqlock
+ * @Date: 2026-10-18 09:41:18
+ */
+#ifndef IMU_INTEGRATION_SHARED_STATE_HPP_
+#define IMU_INTEGRATION_SHARED_STATE_HPP_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "imu_integration/tools/seqlock.hpp"
+
+//
+// Reader side is header only and needs neither ROS nor Eigen, local processes include this
+// header and link against librt. The writer lives in the utils library
+//
+namespace imu_integration {
+
+static const char kSharedStateDefaultName[] = "/imu_integration_state";
+
+// body pose and velocity in navigation frame:
+struct SharedNavState {
+    // IMU measurement stamp in seconds:
+    double time;
+    double position[3];
+    // x, y, z, w:
+    double orientation[4];
+    double velocity[3];
+};
+
+struct SharedStateSegment {
+    static const uint64_t kMagic = 0x494d55494e544731ULL;
+
+    // set once the seqlock below has been constructed:
+    std::atomic<uint64_t> magic;
+    SeqLock<SharedNavState> state;
+};
+
+class SharedStateReader {
+  public:
+    explicit SharedStateReader(const std::string &name = kSharedStateDefaultName)
+        : name_(name) {}
+    ~SharedStateReader(void) { Close(); }
+    SharedStateReader(const SharedStateReader &) = delete;
+    SharedStateReader &operator=(const SharedStateReader &) = delete;
+
+    /**
+     * @brief  map the segment, retry later if the estimator has not created it yet
+     * @return true if success false otherwise
+     */
+    bool Open(void) {
+        if (segment_) {
+            return true;
+        }
+
+        const int fd = shm_open(name_.c_str(), O_RDONLY, 0);
+        if (fd < 0) {
+            return false;
+        }
+        void *address = mmap(nullptr, sizeof(SharedStateSegment), PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (address == MAP_FAILED) {
+            return false;
+        }
+
+        const SharedStateSegment *segment = static_cast<const SharedStateSegment *>(address);
+        if (segment->magic.load(std::memory_order_acquire) != SharedStateSegment::kMagic) {
+            munmap(address, sizeof(SharedStateSegment));
+            return false;
+        }
+
+        segment_ = segment;
+
+        return true;
+    }
+
+    void Close(void) {
+        if (segment_) {
+            munmap(const_cast<SharedStateSegment *>(segment_), sizeof(SharedStateSegment));
+            segment_ = nullptr;
+        }
+    }
+
+    /**
+     * @brief  read latest state, never blocks
+     * @param  state, output
+     * @param  max_attempts, attempts before giving up on overlapping writes
+     * @return true if a consistent state was read false otherwise
+     */
+    bool Read(SharedNavState &state, int max_attempts = 16) const {
+        if (!segment_ || segment_->state.GetVersion() == 0) {
+            return false;
+        }
+
+        for (int i = 0; i < max_attempts; ++i) {
+            if (segment_->state.TryLoad(state)) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief  get state version, changes on every estimation
+     * @return version, 0 if nothing has been written
+     */
+    uint64_t GetVersion(void) const {
+        return segment_ ? segment_->state.GetVersion() : 0;
+    }
+
+  private:
+    std::string name_;
+    const SharedStateSegment *segment_ = nullptr;
+};
+
+class SharedStateWriter {
+  public:
+    explicit SharedStateWriter(const std::string &name = kSharedStateDefaultName);
+    // unlinks the segment, readers that have it mapped keep the last state:
+    ~SharedStateWriter(void);
+    SharedStateWriter(const SharedStateWriter &) = delete;
+    SharedStateWriter &operator=(const SharedStateWriter &) = delete;
+
+    /**
+     * @brief  create and map the segment
+     * @return true if success false otherwise
+     */
+    bool Open(void);
+    /**
+     * @brief  publish new state, single writer only
+     * @param  state, latest state
+     * @return void
+     */
+    void Write(const SharedNavState &state) {
+        segment_->state.Store(state);
+    }
+
+  private:
+    std::string name_;
+    SharedStateSegment *segment_ = nullptr;
+};
+
+} // namespace imu_integration
+
+#endif
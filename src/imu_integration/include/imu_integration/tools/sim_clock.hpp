@@ -0,0 +1,144 @@
+/*
+ * @Description: lockstep simulated time, /clock server and consumer acknowledgement
+ * @Date: 2026-10-18 10:14:26
+ */
+#ifndef IMU_INTEGRATION_SIM_CLOCK_HPP_
+#define IMU_INTEGRATION_SIM_CLOCK_HPP_
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <ros/ros.h>
+#include <ros/callback_queue.h>
+#include <std_msgs/Header.h>
+
+#include "imu_integration/tools/runtime_stats.hpp"
+
+namespace imu_integration {
+
+//
+// Lockstep protocol: the server publishes all measurements of a step, then /clock at the step
+// time, and waits until every registered consumer has acknowledged each topic it consumes up
+// to the latest stamp published on it. An acknowledgement is a std_msgs/Header on the ack topic
+// with "<node name>:<topic>" as frame_id and the latest consumed stamp of that topic as stamp.
+// Topics a consumer does not acknowledge are not waited for, so streams at unrelated rates never
+// stall each other. Consumers repeat their acknowledgements while idle, so neither a late
+// connection nor a lost message stalls the loop
+//
+class SimClockServer {
+  public:
+    struct Params {
+        // fully qualified node names that must acknowledge every step:
+        std::vector<std::string> consumers;
+        std::string ack_topic;
+        // simulated time before the first step in seconds:
+        double start_time;
+        // wall time in seconds to wait for a step's acknowledgements, 0 waits forever:
+        double ack_timeout;
+    };
+
+    SimClockServer(ros::NodeHandle &nh, const Params &params);
+
+    /**
+     * @brief  block until every consumer has acknowledged once and every measurement publisher
+     *         has a subscriber, republishing the start time meanwhile
+     * @param  publishers, measurement publishers
+     * @return true if ready false on shutdown
+     */
+    bool WaitForConsumers(const std::vector<ros::Publisher> &publishers);
+
+    // simulated time of the current step:
+    ros::Time GetTime(void) const { return ros::Time(time_); }
+
+    /**
+     * @brief  record a published measurement, call for every message of the next step
+     * @param  topic, resolved topic name
+     * @param  time, measurement stamp
+     * @return void
+     */
+    void SetPublished(const std::string &topic, double time) { published_[topic] = time; }
+
+    /**
+     * @brief  advance to the next step and publish it on /clock
+     * @param  time, simulated time of the step, after the current one
+     * @return void
+     */
+    void Advance(double time);
+
+    /**
+     * @brief  block until every consumer has acknowledged what was published up to the current step
+     * @return true if acknowledged false on timeout or shutdown
+     */
+    bool WaitForAcks(void);
+
+    const ShardedCounter &GetNumSteps(void) const { return num_steps_; }
+    const ShardedCounter &GetNumTimeouts(void) const { return num_timeouts_; }
+    const LatencyHistogram &GetAckWait(void) const { return ack_wait_; }
+
+  private:
+    void PublishClock(void);
+    void AckCallback(const std_msgs::HeaderConstPtr &ack_ptr);
+    bool HasAllConsumers(void) const;
+    bool HasAllAcks(void) const;
+
+    const Params params_;
+
+    ros::NodeHandle nh_;
+    // acknowledgements are only dispatched while waiting for them:
+    ros::CallbackQueue ack_queue_;
+    ros::Publisher pub_clock_;
+    ros::Subscriber sub_ack_;
+
+    double time_;
+    // latest stamp published on each topic:
+    std::map<std::string, double> published_;
+    // latest acknowledged stamp of each topic of each consumer, absent until it registers:
+    std::map<std::string, std::map<std::string, double>> acks_;
+
+    ShardedCounter num_steps_;
+    ShardedCounter num_timeouts_;
+    LatencyHistogram ack_wait_;
+};
+
+class SimClockAck {
+  public:
+    /**
+     * @param  nh, node handle
+     * @param  ack_topic, acknowledgement topic of the server
+     * @param  topics, consumed topics, indexed in this order by Update
+     * @param  heartbeat_period, wall time in seconds between repeated acknowledgements while idle
+     */
+    SimClockAck(
+        ros::NodeHandle &nh, const std::string &ack_topic,
+        const std::vector<std::string> &topics, double heartbeat_period = 0.1
+    );
+
+    /**
+     * @brief  record that a topic is consumed up to given stamp
+     * @param  index, topic index
+     * @param  time, latest consumed stamp, 0 before any message
+     * @return void
+     */
+    void Update(size_t index, double time);
+
+    /**
+     * @brief  publish acknowledgements if any changed or once per heartbeat period while idle.
+     *         Call after every processing cycle
+     * @return void
+     */
+    void Publish(void);
+
+  private:
+    ros::Publisher pub_ack_;
+    std::vector<std_msgs::Header> acks_;
+    bool updated_ = false;
+
+    const double heartbeat_period_;
+    double last_publish_wall_time_ = 0.0;
+};
+
+} // namespace imu_integration
+
+#endif
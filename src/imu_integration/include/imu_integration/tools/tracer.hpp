@@ -0,0 +1,184 @@
+/*
+ * @Description: scoped trace points exported in Chrome trace-event format
+ * @Date: 2026-10-18 10:12:41
+ */
+#ifndef IMU_INTEGRATION_TRACER_HPP_
+#define IMU_INTEGRATION_TRACER_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace imu_integration {
+
+struct TraceEvent {
+    // must point to a string literal, only the address is recorded:
+    const char *name = nullptr;
+    uint64_t begin_ns = 0;
+    uint64_t end_ns = 0;
+};
+
+/**
+ * @brief  single-producer single-consumer event ring owned by one thread
+ */
+class TraceBuffer {
+  public:
+    static constexpr size_t kCapacity = 1 << 14;
+
+    explicit TraceBuffer(uint32_t tid) : tid_(tid) {}
+
+    /**
+     * @brief  append event, called by the owning thread only
+     * @param  event, event to append
+     * @return true if success false if the ring is full and the event was dropped
+     */
+    bool Push(const TraceEvent &event) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) >= kCapacity) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        events_[head & (kCapacity - 1)] = event;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief  move all pending events to output, called by the flush thread only
+     * @param  events, output buffer
+     * @return number of events moved
+     */
+    size_t Drain(std::vector<TraceEvent> &events) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t head = head_.load(std::memory_order_acquire);
+        for (size_t i = tail; i != head; ++i) {
+            events.push_back(events_[i & (kCapacity - 1)]);
+        }
+        tail_.store(head, std::memory_order_release);
+        return head - tail;
+    }
+
+    uint32_t GetTid(void) const { return tid_; }
+    uint64_t GetDropped(void) const { return dropped_.load(std::memory_order_relaxed); }
+
+  private:
+    const uint32_t tid_;
+    std::atomic<uint64_t> dropped_{0};
+
+    // keep producer and consumer indices on separate cache lines.
+    // padding instead of alignas, over-aligned new is not available before C++17:
+    char pad_head_[64];
+    std::atomic<size_t> head_{0};
+    char pad_tail_[64];
+    std::atomic<size_t> tail_{0};
+    char pad_events_[64];
+    TraceEvent events_[kCapacity];
+};
+
+/**
+ * @brief  process-wide trace collector. Threads record into their own TraceBuffer,
+ *         a background thread periodically drains all buffers into a JSON file
+ *         loadable by chrome://tracing and Perfetto
+ */
+class Tracer {
+  public:
+    static Tracer &GetInstance(void);
+
+    /**
+     * @brief  open trace file and start the flush thread
+     * @param  file_path, output trace-event JSON file
+     * @param  flush_period, flush period in seconds
+     * @return true if success false otherwise
+     */
+    bool Start(const std::string &file_path, double flush_period);
+    /**
+     * @brief  stop recording, flush pending events and close the trace file
+     * @return void
+     */
+    void Stop(void);
+
+    static bool IsEnabled(void) { return enabled_.load(std::memory_order_relaxed); }
+
+    static uint64_t Now(void) {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()
+            ).count()
+        );
+    }
+
+    void Record(const char *name, uint64_t begin_ns, uint64_t end_ns);
+
+  private:
+    Tracer(void) = default;
+    ~Tracer(void);
+    Tracer(const Tracer &) = delete;
+    Tracer &operator=(const Tracer &) = delete;
+
+    TraceBuffer *GetThreadBuffer(void);
+    void FlushLoop(void);
+    void Flush(void);
+
+    static std::atomic<bool> enabled_;
+
+    // registered thread buffers, kept alive until exit so that late flushes stay valid:
+    std::mutex buffers_mutex_;
+    std::vector<std::unique_ptr<TraceBuffer>> buffers_;
+
+    // flush thread:
+    std::mutex flush_mutex_;
+    std::condition_variable flush_cond_;
+    std::thread flush_thread_;
+    bool running_ = false;
+    double flush_period_ = 0.5;
+
+    // output:
+    std::ofstream ofs_;
+    bool is_first_event_ = true;
+    std::vector<TraceEvent> scratch_;
+};
+
+/**
+ * @brief  RAII trace point, records one complete event for its enclosing scope
+ */
+class ScopedTrace {
+  public:
+    explicit ScopedTrace(const char *name)
+        : name_(Tracer::IsEnabled() ? name : nullptr),
+          begin_ns_(name_ ? Tracer::Now() : 0) {}
+
+    ~ScopedTrace(void) {
+        if (name_) {
+            Tracer::GetInstance().Record(name_, begin_ns_, Tracer::Now());
+        }
+    }
+
+    ScopedTrace(const ScopedTrace &) = delete;
+    ScopedTrace &operator=(const ScopedTrace &) = delete;
+
+  private:
+    const char *name_;
+    uint64_t begin_ns_;
+};
+
+} // namespace imu_integration
+
+#define IMU_INTEGRATION_TRACE_CONCAT_IMPL(a, b) a##b
+#define IMU_INTEGRATION_TRACE_CONCAT(a, b) IMU_INTEGRATION_TRACE_CONCAT_IMPL(a, b)
+
+// trace points compile to nothing unless enabled at build time:
+#ifdef IMU_INTEGRATION_ENABLE_TRACE
+#define IMU_INTEGRATION_TRACE_SCOPE(name) \
+    ::imu_integration::ScopedTrace IMU_INTEGRATION_TRACE_CONCAT(imu_integration_trace_, __LINE__)(name)
+#else
+#define IMU_INTEGRATION_TRACE_SCOPE(name) do {} while (0)
+#endif
+
+#endif
@@ -0,0 +1,147 @@
+/*
+ * @Description: World Magnetic Model spherical harmonic evaluation with a spatial cache
+ * @Date: 2026-10-18 10:32:08
+ */
+#ifndef IMU_INTEGRATION_WORLD_MAGNETIC_MODEL_HPP_
+#define IMU_INTEGRATION_WORLD_MAGNETIC_MODEL_HPP_
+
+#include <istream>
+#include <string>
+
+#include <Eigen/Dense>
+#include <Eigen/Core>
+
+#include "imu_integration/tools/runtime_stats.hpp"
+
+namespace imu_integration {
+
+//
+// Port of NOAA geomagc as found in gnss_ins_sim/geoparams/geomag.py. Schmidt semi-normalized
+// Gauss coefficients are unnormalized once on load, so an evaluation is a single pass of the
+// associated Legendre recursion up to degree 12, about 90 terms
+//
+class WorldMagneticModel {
+  public:
+    static const int kMaxDegree = 12;
+
+    // built-in WMM-2015 coefficients:
+    WorldMagneticModel(void);
+
+    /**
+     * @brief  load coefficients in NOAA .COF format, e.g. gnss_ins_sim/geoparams/WMM2010.COF
+     * @param  cof_path, coefficient file path
+     * @return true if success false otherwise, the model is unchanged on failure
+     */
+    bool Load(const std::string &cof_path);
+
+    /**
+     * @brief  evaluate main field
+     * @param  latitude, geodetic latitude in degrees
+     * @param  longitude, longitude in degrees
+     * @param  altitude, height above WGS-84 ellipsoid in meters
+     * @param  decimal_year, e.g. 2015.5 for July 2nd 2015
+     * @return magnetic field in local north, east and down axes in nanotesla
+     */
+    Eigen::Vector3d Evaluate(double latitude, double longitude, double altitude, double decimal_year) const;
+
+    double GetEpoch(void) const { return epoch_; }
+    const std::string &GetName(void) const { return name_; }
+
+  private:
+    bool Load(std::istream &cof);
+
+    std::string name_;
+    double epoch_ = 0.0;
+
+    // unnormalized Gauss coefficients and secular variation per year, indexed [n][m]:
+    double g_[kMaxDegree + 1][kMaxDegree + 1];
+    double h_[kMaxDegree + 1][kMaxDegree + 1];
+    double dg_[kMaxDegree + 1][kMaxDegree + 1];
+    double dh_[kMaxDegree + 1][kMaxDegree + 1];
+    // Legendre recursion constants:
+    double k_[kMaxDegree + 1][kMaxDegree + 1];
+};
+
+//
+// Main field changes by a few nanotesla per kilometer and per month, well below magnetometer
+// noise, so the model is only re-evaluated once position or time has moved by the thresholds
+//
+class MagneticFieldCache {
+  public:
+    struct Params {
+        // horizontal or vertical distance in meters that triggers re-evaluation:
+        double max_distance = 1000.0;
+        // time in years that triggers re-evaluation:
+        double max_time = 1.0 / 365.0;
+    };
+
+    MagneticFieldCache(const WorldMagneticModel &model, const Params &params);
+
+    /**
+     * @brief  get main field, re-evaluated only if far from the last evaluation
+     * @param  latitude, geodetic latitude in degrees
+     * @param  longitude, longitude in degrees
+     * @param  altitude, height above WGS-84 ellipsoid in meters
+     * @param  decimal_year, decimal year
+     * @return magnetic field in local north, east and down axes in nanotesla
+     */
+    const Eigen::Vector3d &GetField(double latitude, double longitude, double altitude, double decimal_year);
+
+    const ShardedCounter &GetNumEvaluations(void) const { return num_evaluations_; }
+    const ShardedCounter &GetNumHits(void) const { return num_hits_; }
+
+  private:
+    const WorldMagneticModel &model_;
+    const Params params_;
+
+    bool valid_ = false;
+    double latitude_ = 0.0;
+    double cos_latitude_ = 1.0;
+    double longitude_ = 0.0;
+    double altitude_ = 0.0;
+    double decimal_year_ = 0.0;
+    Eigen::Vector3d field_ = Eigen::Vector3d::Zero();
+
+    ShardedCounter num_evaluations_;
+    ShardedCounter num_hits_;
+};
+
+// main field along a local trajectory, in the ENU navigation frame anchored at a geodetic origin:
+class LocalMagneticField {
+  public:
+    struct Params {
+        // NOAA .COF file, empty for built-in WMM-2015:
+        std::string cof_file;
+        // navigation frame origin, in degrees and meters above WGS-84 ellipsoid:
+        double latitude = 0.0;
+        double longitude = 0.0;
+        double altitude = 0.0;
+        // decimal year at time 0:
+        double decimal_year = 2015.0;
+        MagneticFieldCache::Params cache;
+    };
+
+    explicit LocalMagneticField(const Params &params);
+    LocalMagneticField(const LocalMagneticField &) = delete;
+    LocalMagneticField &operator=(const LocalMagneticField &) = delete;
+
+    /**
+     * @brief  get main field
+     * @param  position, position in navigation frame
+     * @param  time, time in seconds
+     * @return magnetic field in navigation frame in tesla
+     */
+    Eigen::Vector3d GetField(const Eigen::Vector3d &position, double time);
+
+    const MagneticFieldCache &GetCache(void) const { return cache_; }
+
+  private:
+    const Params params_;
+
+    WorldMagneticModel model_;
+    MagneticFieldCache cache_;
+};
+
+} // namespace imu_integration
+
+#endif
@@ -0,0 +1,214 @@
+/*
+ * @Description: hardware counter benchmark of the IMU integration kernels
+ * @Date: 2026-10-18 09:40:12
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "imu_integration/sensor_data/imu_data.hpp"
+#include "imu_integration/estimator/integration.hpp"
+#include "imu_integration/tools/perf_counters.hpp"
+
+namespace imu_integration {
+
+namespace benchmark {
+
+using estimator::IntegrationScheme;
+
+// gravity along z of the estimator and generator configs, for representative magnitudes:
+const double kGravityZ = -9.7942164704;
+
+// structure of arrays layout of the IMU measurement buffer:
+struct IMUDataSoA {
+    std::vector<double> time;
+    std::vector<double> acc_x, acc_y, acc_z;
+    std::vector<double> gyro_x, gyro_y, gyro_z;
+
+    size_t size(void) const { return time.size(); }
+
+    void push_back(const IMUData &imu_data) {
+        time.push_back(imu_data.time);
+        acc_x.push_back(imu_data.linear_acceleration.x());
+        acc_y.push_back(imu_data.linear_acceleration.y());
+        acc_z.push_back(imu_data.linear_acceleration.z());
+        gyro_x.push_back(imu_data.angular_velocity.x());
+        gyro_y.push_back(imu_data.angular_velocity.y());
+        gyro_z.push_back(imu_data.angular_velocity.z());
+    }
+};
+
+// uniform accessors over the three layouts:
+template <typename Buffer>
+inline double GetTime(const Buffer &buffer, size_t i) { return buffer[i].time; }
+template <typename Buffer>
+inline Eigen::Vector3d GetLinearAcc(const Buffer &buffer, size_t i) { return buffer[i].linear_acceleration; }
+template <typename Buffer>
+inline Eigen::Vector3d GetAngularVel(const Buffer &buffer, size_t i) { return buffer[i].angular_velocity; }
+
+template <>
+inline double GetTime(const IMUDataSoA &buffer, size_t i) { return buffer.time[i]; }
+template <>
+inline Eigen::Vector3d GetLinearAcc(const IMUDataSoA &buffer, size_t i) {
+    return Eigen::Vector3d(buffer.acc_x[i], buffer.acc_y[i], buffer.acc_z[i]);
+}
+template <>
+inline Eigen::Vector3d GetAngularVel(const IMUDataSoA &buffer, size_t i) {
+    return Eigen::Vector3d(buffer.gyro_x[i], buffer.gyro_y[i], buffer.gyro_z[i]);
+}
+
+struct State {
+    Eigen::Matrix3d R = Eigen::Matrix3d::Identity();
+    Eigen::Vector3d t = Eigen::Vector3d::Zero();
+    Eigen::Vector3d v = Eigen::Vector3d::Zero();
+};
+
+/**
+ * @brief  the estimator's per-sample integration loop over a whole buffer
+ * @param  scheme, integration scheme
+ * @param  buffer, IMU measurements
+ * @param  state, navigation state, updated in place
+ * @return void
+ */
+template <typename Buffer>
+void Integrate(const IntegrationScheme scheme, const Buffer &buffer, State &state) {
+    const Eigen::Vector3d G(0.0, 0.0, kGravityZ);
+    const Eigen::Vector3d angular_vel_bias(1.0e-4, -2.0e-4, 5.0e-5);
+    const Eigen::Vector3d linear_acc_bias(1.0e-3, 2.0e-3, -1.0e-3);
+
+    for (size_t i = 1; i < buffer.size(); ++i) {
+        const double delta_t = GetTime(buffer, i) - GetTime(buffer, i - 1);
+
+        // orientation:
+        Eigen::Vector3d angular_delta = estimator::GetAngularDelta(
+            scheme,
+            GetAngularVel(buffer, i) - angular_vel_bias,
+            GetAngularVel(buffer, i - 1) - angular_vel_bias,
+            delta_t
+        );
+        const Eigen::Matrix3d R_prev = state.R;
+        estimator::UpdateOrientation(angular_delta, state.R);
+
+        // position:
+        Eigen::Vector3d velocity_delta = estimator::GetVelocityDelta(
+            scheme,
+            state.R*(GetLinearAcc(buffer, i) - linear_acc_bias) - G,
+            R_prev*(GetLinearAcc(buffer, i - 1) - linear_acc_bias) - G,
+            delta_t
+        );
+        estimator::UpdatePosition(delta_t, velocity_delta, state.t, state.v);
+    }
+}
+
+IMUData GetSample(size_t i) {
+    const double t = 0.01*i;
+
+    IMUData imu_data;
+    imu_data.time = t;
+    imu_data.angular_velocity = Eigen::Vector3d(0.1*sin(t), 0.2*cos(t), M_PI/10.0);
+    imu_data.linear_acceleration = Eigen::Vector3d(0.3*cos(0.3*t), 0.4*sin(0.3*t), -kGravityZ + 0.1*sin(3.0*t));
+
+    return imu_data;
+}
+
+template <typename Buffer>
+void RunCase(
+    const std::string &layout, const IntegrationScheme scheme,
+    const Buffer &buffer, const int num_repeats
+) {
+    PerfCounters perf_counters;
+    PerfCounterValues total, values;
+    bool has_counters = perf_counters.IsAvailable();
+
+    State state;
+    for (int i = 0; i < num_repeats; ++i) {
+        perf_counters.Start();
+        Integrate(scheme, buffer, state);
+        has_counters = perf_counters.Stop(values) && has_counters;
+
+        total.cycles += values.cycles;
+        total.instructions += values.instructions;
+        total.cache_misses += values.cache_misses;
+        total.branch_misses += values.branch_misses;
+        total.elapsed_ns += values.elapsed_ns;
+    }
+
+    const double num_samples = static_cast<double>(num_repeats) * (buffer.size() - 1);
+    const char *scheme_name = (IntegrationScheme::EULER == scheme) ? "euler" : "midpoint";
+
+    if (has_counters) {
+        printf(
+            "%-8s %-8s %10.2f %10.2f %10.2f %8.3f %12.4f %12.4f\n",
+            layout.c_str(), scheme_name,
+            total.elapsed_ns / num_samples,
+            total.cycles / num_samples,
+            total.instructions / num_samples,
+            total.cycles ? static_cast<double>(total.instructions) / total.cycles : 0.0,
+            total.cache_misses / num_samples,
+            total.branch_misses / num_samples
+        );
+    } else {
+        printf(
+            "%-8s %-8s %10.2f %10s %10s %8s %12s %12s\n",
+            layout.c_str(), scheme_name,
+            total.elapsed_ns / num_samples,
+            "n/a", "n/a", "n/a", "n/a", "n/a"
+        );
+    }
+
+    // keep the result alive:
+    if (!state.t.allFinite()) {
+        printf("non-finite integration result for %s/%s\n", layout.c_str(), scheme_name);
+    }
+}
+
+} // namespace benchmark
+
+} // namespace imu_integration
+
+int main(int argc, char** argv) {
+    using namespace imu_integration;
+    using namespace imu_integration::benchmark;
+
+    const size_t num_samples = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 100000;
+    const int num_repeats = (argc > 2) ? atoi(argv[2]) : 10;
+
+    if (num_samples < 2 || num_repeats < 1) {
+        fprintf(stderr, "usage: %s [num_samples >= 2] [num_repeats >= 1]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // the estimator's buffer type, a contiguous AoS and a SoA layout:
+    std::deque<IMUData> deque_aos;
+    std::vector<IMUData> vector_aos;
+    IMUDataSoA soa;
+    for (size_t i = 0; i < num_samples; ++i) {
+        IMUData imu_data = GetSample(i);
+        deque_aos.push_back(imu_data);
+        vector_aos.push_back(imu_data);
+        soa.push_back(imu_data);
+    }
+
+    {
+        PerfCounters perf_counters;
+        if (!perf_counters.IsAvailable()) {
+            printf("hardware counters unavailable (%s), reporting wall clock only\n", perf_counters.GetError().c_str());
+        }
+    }
+
+    printf("%zu samples x %d repeats, values per sample:\n", num_samples, num_repeats);
+    printf(
+        "%-8s %-8s %10s %10s %10s %8s %12s %12s\n",
+        "layout", "scheme", "ns", "cycles", "instr", "IPC", "cache-miss", "branch-miss"
+    );
+    const IntegrationScheme schemes[] = {IntegrationScheme::MIDPOINT, IntegrationScheme::EULER};
+    for (const IntegrationScheme scheme: schemes) {
+        RunCase("deque", scheme, deque_aos, num_repeats);
+        RunCase("vector", scheme, vector_aos, num_repeats);
+        RunCase("soa", scheme, soa, num_repeats);
+    }
+
+    return EXIT_SUCCESS;
+}
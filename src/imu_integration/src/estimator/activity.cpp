@@ -3,12 +3,16 @@
  * @Author: Ge Yao
  * @Date: 2020-11-10 14:25:03
  */
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 #include "imu_integration/estimator/activity.hpp"
+#include "imu_integration/estimator/integration.hpp"
 #include "glog/logging.h"
 
 #include "imu_integration/tools/file_manager.hpp"
+#include "imu_integration/tools/tracer.hpp"
 
 namespace imu_integration {
 
@@ -25,10 +29,21 @@ Activity::Activity(void)
     linear_acc_bias_(0.0, 0.0, 0.0)
 {}
 
+Activity::~Activity(void) {
+    // estimates still waiting for ground truth at shutdown, written only in pairs:
+    if (ground_truth_spline_ptr_ && laser_odom_ofs_.is_open()) {
+        WritePendingEstimates(std::numeric_limits<double>::infinity());
+    }
+}
+
 void Activity::Init(void) {
+    // decode only the fields used by integration:
+    bool lightweight;
+    private_nh_.param("subscriber/lightweight", lightweight, true);
+
     // parse IMU config:
     private_nh_.param("imu/topic_name", imu_config_.topic_name, std::string("/sim/sensor/imu"));
-    imu_sub_ptr_ = std::make_shared<IMUSubscriber>(private_nh_, imu_config_.topic_name, 1000000);
+    imu_sub_ptr_ = std::make_shared<IMUSubscriber>(private_nh_, imu_config_.topic_name, 1000000, lightweight);
 
     // a. gravity constant:
     private_nh_.param("imu/gravity/x", imu_config_.gravity.x,  0.0);
@@ -54,38 +69,419 @@ void Activity::Init(void) {
     linear_acc_bias_.y() = imu_config_.bias.linear_acceleration.y;
     linear_acc_bias_.z() = imu_config_.bias.linear_acceleration.z;
 
+    // d. random noises:
+    private_nh_.param("imu/gyro/sigma_bias", imu_config_.gyro_bias_stddev, 5e-5);
+    private_nh_.param("imu/gyro/sigma_noise", imu_config_.gyro_noise_stddev, 0.015);
+    private_nh_.param("imu/acc/sigma_bias", imu_config_.acc_bias_stddev, 5e-4);
+    private_nh_.param("imu/acc/sigma_noise", imu_config_.acc_noise_stddev, 0.019);
+
+    // runtime reload of the above through ~reload_imu_params:
+    imu_params_watcher_ptr_ = std::make_shared<IMUParamsWatcher>(private_nh_, IMUParamsWatcher::GetParams(imu_config_));
+
+    // parse IMU to body extrinsics:
+    private_nh_.param("extrinsics/rotation/roll", extrinsics_config_.rotation.roll, 0.0);
+    private_nh_.param("extrinsics/rotation/pitch", extrinsics_config_.rotation.pitch, 0.0);
+    private_nh_.param("extrinsics/rotation/yaw", extrinsics_config_.rotation.yaw, 0.0);
+    private_nh_.param("extrinsics/lever_arm/x", extrinsics_config_.lever_arm.x, 0.0);
+    private_nh_.param("extrinsics/lever_arm/y", extrinsics_config_.lever_arm.y, 0.0);
+    private_nh_.param("extrinsics/lever_arm/z", extrinsics_config_.lever_arm.z, 0.0);
+    private_nh_.param("extrinsics/angular_acc_time_constant", extrinsics_config_.angular_acc_time_constant, 0.02);
+    const Eigen::Matrix3d R_body_imu = (
+        Eigen::AngleAxisd(extrinsics_config_.rotation.yaw, Eigen::Vector3d::UnitZ()) *
+        Eigen::AngleAxisd(extrinsics_config_.rotation.pitch, Eigen::Vector3d::UnitY()) *
+        Eigen::AngleAxisd(extrinsics_config_.rotation.roll, Eigen::Vector3d::UnitX())
+    ).toRotationMatrix();
+    const Eigen::Vector3d lever_arm(
+        extrinsics_config_.lever_arm.x, extrinsics_config_.lever_arm.y, extrinsics_config_.lever_arm.z
+    );
+
+    // IMU mounted at body reference point needs no compensation:
+    if (!R_body_imu.isIdentity() || !lever_arm.isZero()) {
+        imu_extrinsics_ptr_ = std::make_shared<IMUExtrinsics>(
+            R_body_imu, lever_arm, extrinsics_config_.angular_acc_time_constant
+        );
+    }
+
+    // parse non-holonomic constraint config:
+    private_nh_.param("non_holonomic/enable", non_holonomic_config_.enable, false);
+    private_nh_.param("non_holonomic/period", non_holonomic_config_.period, 0.1);
+    private_nh_.param("non_holonomic/lateral_stddev", non_holonomic_config_.lateral_stddev, 0.1);
+    private_nh_.param("non_holonomic/vertical_stddev", non_holonomic_config_.vertical_stddev, 0.05);
+    if (non_holonomic_config_.enable) {
+        NonHolonomicConstraint::Params params;
+        params.filter.gyro_noise_stddev = imu_config_.gyro_noise_stddev;
+        params.filter.acc_noise_stddev = imu_config_.acc_noise_stddev;
+        params.R_imu_body = R_body_imu.transpose();
+        params.period = non_holonomic_config_.period;
+        params.lateral_stddev = non_holonomic_config_.lateral_stddev;
+        params.vertical_stddev = non_holonomic_config_.vertical_stddev;
+
+        non_holonomic_constraint_ptr_ = std::make_shared<NonHolonomicConstraint>(params);
+    }
+
+    // parse magnetometer heading config, navigation frame origin is shared with the generator:
+    private_nh_.param("magnetometer/enable", magnetometer_config_.enable, false);
+    private_nh_.param("sensors/magnetometer/topic_name", magnetometer_config_.topic_name, std::string("/sim/sensor/magnetometer"));
+    private_nh_.param("magnetometer/sigma", magnetometer_config_.stddev, 5.0e-7);
+    private_nh_.param("magnetometer/max_field_error", magnetometer_config_.max_field_error, 0.15);
+    private_nh_.param("magnetometer/max_innovation", magnetometer_config_.max_innovation, 3.0);
+    private_nh_.param("magnetometer/initial_yaw_stddev", magnetometer_config_.initial_yaw_stddev, 0.01);
+    private_nh_.param("magnetic_model/cof_file", magnetic_model_config_.cof_file, std::string(""));
+    private_nh_.param("magnetic_model/latitude", magnetic_model_config_.latitude, 31.224361);
+    private_nh_.param("magnetic_model/longitude", magnetic_model_config_.longitude, 121.469170);
+    private_nh_.param("magnetic_model/altitude", magnetic_model_config_.altitude, 0.0);
+    private_nh_.param("magnetic_model/decimal_year", magnetic_model_config_.decimal_year, 2019.0);
+    private_nh_.param("magnetic_model/cache/max_distance", magnetic_model_config_.max_distance, 1000.0);
+    private_nh_.param("magnetic_model/cache/max_time", magnetic_model_config_.max_time, 1.0 / 365.0);
+    if (magnetometer_config_.enable) {
+        MagnetometerHeading::Params params;
+        params.field.cof_file = magnetic_model_config_.cof_file;
+        params.field.latitude = magnetic_model_config_.latitude;
+        params.field.longitude = magnetic_model_config_.longitude;
+        params.field.altitude = magnetic_model_config_.altitude;
+        params.field.decimal_year = magnetic_model_config_.decimal_year;
+        params.field.cache.max_distance = magnetic_model_config_.max_distance;
+        params.field.cache.max_time = magnetic_model_config_.max_time;
+        params.gyro_noise_stddev = imu_config_.gyro_noise_stddev;
+        params.stddev = magnetometer_config_.stddev;
+        params.max_field_error = magnetometer_config_.max_field_error;
+        params.max_innovation = magnetometer_config_.max_innovation;
+        params.initial_yaw_stddev = magnetometer_config_.initial_yaw_stddev;
+
+        magnetometer_heading_ptr_ = std::make_shared<MagnetometerHeading>(params);
+        magnetometer_sub_ptr_ = std::make_shared<MagnetometerSubscriber>(private_nh_, magnetometer_config_.topic_name, 1000000);
+    }
+
     // parse odom config:
     private_nh_.param("pose/frame_id", odom_config_.frame_id, std::string("inertial"));
     private_nh_.param("pose/topic_name/ground_truth", odom_config_.topic_name.ground_truth, std::string("/pose/ground_truth"));
     private_nh_.param("pose/topic_name/estimation", odom_config_.topic_name.estimation, std::string("/pose/estimation"));
 
-    odom_ground_truth_sub_ptr = std::make_shared<OdomSubscriber>(private_nh_, odom_config_.topic_name.ground_truth, 1000000);
-    odom_estimation_pub_ = private_nh_.advertise<nav_msgs::Odometry>(odom_config_.topic_name.estimation, 500);
+    odom_ground_truth_sub_ptr = std::make_shared<OdomSubscriber>(private_nh_, odom_config_.topic_name.ground_truth, 1000000, lightweight);
+    private_nh_.param("pose/preserialized", odom_config_.preserialized, true);
+    if (odom_config_.preserialized) {
+        odom_estimation_serialized_pub_ptr_ = std::make_shared<OdomPublisher>(
+            private_nh_, odom_config_.topic_name.estimation, 
+            odom_config_.frame_id, odom_config_.frame_id, 
+            500
+        );
+    } else {
+        odom_estimation_pub_ = private_nh_.advertise<nav_msgs::Odometry>(odom_config_.topic_name.estimation, 500);
+    }
+
+    // parse health monitor config:
+    private_nh_.param("health/enable", health_config_.enable, true);
+    private_nh_.param("health/max_linear_acc", health_config_.max_linear_acc, 160.0);
+    private_nh_.param("health/max_angular_vel", health_config_.max_angular_vel, 35.0);
+    private_nh_.param("health/max_orthonormality_error", health_config_.max_orthonormality_error, 1.0e-9);
+    if (health_config_.enable) {
+        HealthMonitor::Params params;
+        params.max_linear_acc = health_config_.max_linear_acc;
+        params.max_angular_vel = health_config_.max_angular_vel;
+        params.max_orthonormality_error = health_config_.max_orthonormality_error;
+
+        health_monitor_ptr_ = std::make_shared<HealthMonitor>(params);
+    }
+
+    // parse shared state config:
+    private_nh_.param("shared_state/enable", shared_state_config_.enable, false);
+    private_nh_.param("shared_state/name", shared_state_config_.name, std::string(kSharedStateDefaultName));
+    if (shared_state_config_.enable) {
+        shared_state_writer_ptr_ = std::make_shared<SharedStateWriter>(shared_state_config_.name);
+        if (!shared_state_writer_ptr_->Open()) {
+            shared_state_writer_ptr_.reset();
+        }
+    }
+
+    // parse simulated clock config, time itself comes through use_sim_time:
+    private_nh_.param("sim_clock/enable", sim_clock_config_.enable, false);
+    private_nh_.param("sim_clock/ack_topic", sim_clock_config_.ack_topic, std::string("/sim_clock/ack"));
+    if (sim_clock_config_.enable) {
+        std::vector<std::string> topics{imu_config_.topic_name, odom_config_.topic_name.ground_truth};
+        if (magnetometer_sub_ptr_) {
+            topics.push_back(magnetometer_config_.topic_name);
+        }
+        sim_clock_ack_ptr_ = std::make_shared<SimClockAck>(private_nh_, sim_clock_config_.ack_topic, topics);
+    }
+
+    // parse flight recorder config:
+    private_nh_.param("flight_recorder/enable", flight_recorder_config_.enable, true);
+    private_nh_.param("flight_recorder/duration", flight_recorder_config_.duration, 10.0);
+    private_nh_.param("flight_recorder/max_rate", flight_recorder_config_.max_rate, 1000.0);
+    private_nh_.param("flight_recorder/max_position_jump", flight_recorder_config_.max_position_jump, 1.0);
+    private_nh_.param("flight_recorder/max_imu_gap", flight_recorder_config_.max_imu_gap, 0.1);
+    private_nh_.param("flight_recorder/min_dump_interval", flight_recorder_config_.min_dump_interval, 10.0);
+    private_nh_.param("flight_recorder/directory", flight_recorder_config_.directory, std::string("/tmp"));
+    if (flight_recorder_config_.enable) {
+        FlightRecorder::Params params;
+        params.duration = flight_recorder_config_.duration;
+        params.max_rate = flight_recorder_config_.max_rate;
+        params.max_position_jump = flight_recorder_config_.max_position_jump;
+        params.max_imu_gap = flight_recorder_config_.max_imu_gap;
+        params.min_dump_interval = flight_recorder_config_.min_dump_interval;
+        params.directory = flight_recorder_config_.directory;
+
+        flight_recorder_ptr_ = std::make_shared<FlightRecorder>(private_nh_, params);
+    }
+
+    // parse synchronization config:
+    private_nh_.param("sync/capacity", sync_config_.capacity, 2000);
+    private_nh_.param("sync/max_gap", sync_config_.max_gap, 0.2);
+    private_nh_.param("sync/max_latency", sync_config_.max_latency, 0.5);
+    synchronizer_ptr_ = std::make_shared<ApproximateTimeSynchronizer<IMUData, OdomData>>(
+        sync_config_.capacity, sync_config_.max_gap, sync_config_.max_latency
+    );
+
+    // parse ground truth spline config:
+    private_nh_.param("ground_truth_spline/enable", ground_truth_spline_config_.enable, false);
+    private_nh_.param("ground_truth_spline/knot_spacing", ground_truth_spline_config_.knot_spacing, 0.01);
+    private_nh_.param("ground_truth_spline/max_gap", ground_truth_spline_config_.max_gap, 0.1);
+    private_nh_.param("ground_truth_spline/duration", ground_truth_spline_config_.duration, 10.0);
+    if (ground_truth_spline_config_.enable) {
+        BSplineTrajectory::Params params;
+        params.knot_spacing = ground_truth_spline_config_.knot_spacing;
+        params.max_gap = ground_truth_spline_config_.max_gap;
+        params.max_segments = static_cast<size_t>(
+            std::ceil(ground_truth_spline_config_.duration / ground_truth_spline_config_.knot_spacing)
+        );
+
+        ground_truth_spline_ptr_ = std::make_shared<BSplineTrajectory>(params);
+    }
+
+    // parse time offset estimation config:
+    private_nh_.param("time_offset/enable", time_offset_config_.enable, false);
+    private_nh_.param("time_offset/window", time_offset_config_.window, 10.0);
+    private_nh_.param("time_offset/sample_rate", time_offset_config_.sample_rate, 100.0);
+    private_nh_.param("time_offset/max_offset", time_offset_config_.max_offset, 0.5);
+    private_nh_.param("time_offset/period", time_offset_config_.period, 1.0);
+    private_nh_.param("time_offset/min_correlation", time_offset_config_.min_correlation, 0.7);
+    private_nh_.param("time_offset/smoothing", time_offset_config_.smoothing, 0.2);
+    if (time_offset_config_.enable) {
+        time_offset_estimator_ptr_ = std::make_shared<TimeOffsetEstimator>(time_offset_config_);
+        time_offset_estimator_ptr_->Start();
+    }
+
+    // parse sliding window optimization config:
+    private_nh_.param("window/enable", window_config_.enable, false);
+    private_nh_.param("window/topic_name", window_config_.topic_name, std::string("/pose/optimized"));
+    private_nh_.param("window/keyframe_period", window_config_.keyframe_period, 0.1);
+    private_nh_.param("window/window_size", window_config_.window_size, 10);
+    private_nh_.param("window/max_iterations", window_config_.max_iterations, 5);
+    private_nh_.param("window/time_budget", window_config_.time_budget, 0.01);
+    private_nh_.param("window/position_stddev", window_config_.position_stddev, 0.01);
+    private_nh_.param("window/orientation_stddev", window_config_.orientation_stddev, 0.01);
+    if (window_config_.enable) {
+        SlidingWindowOptimizer::Params params;
+        params.preintegration.angular_vel_bias = angular_vel_bias_;
+        params.preintegration.linear_acc_bias = linear_acc_bias_;
+        params.preintegration.gyro_noise_stddev = imu_config_.gyro_noise_stddev;
+        params.preintegration.acc_noise_stddev = imu_config_.acc_noise_stddev;
+        params.gravity = G_;
+        params.keyframe_period = window_config_.keyframe_period;
+        params.window_size = std::max(2, window_config_.window_size);
+        params.max_iterations = window_config_.max_iterations;
+        params.time_budget = window_config_.time_budget;
+        params.position_stddev = window_config_.position_stddev;
+        params.orientation_stddev = window_config_.orientation_stddev;
+
+        window_optimizer_ptr_ = std::make_shared<SlidingWindowOptimizer>(params);
+        odom_optimized_pub_ptr_ = std::make_shared<OdomPublisher>(
+            private_nh_, window_config_.topic_name, 
+            odom_config_.frame_id, odom_config_.frame_id, 
+            100
+        );
+    }
+
+    start_time_ = ros::WallTime::now().toSec();
+
+    // parse trace config:
+    private_nh_.param("trace/enable", trace_config_.enable, false);
+    private_nh_.param("trace/file_path", trace_config_.file_path, std::string("/tmp/imu_integration_estimator_trace.json"));
+    private_nh_.param("trace/flush_period", trace_config_.flush_period, 0.5);
+    if (trace_config_.enable) {
+        Tracer::GetInstance().Start(trace_config_.file_path, trace_config_.flush_period);
+    }
+
+    // parse diagnostics config:
+    private_nh_.param("diagnostics/enable", diagnostics_config_.enable, true);
+    private_nh_.param("diagnostics/topic_name", diagnostics_config_.topic_name, std::string("/diagnostics"));
+    private_nh_.param("diagnostics/period", diagnostics_config_.period, 1.0);
+    if (diagnostics_config_.enable) {
+        diagnostics_prev_.time = ros::WallTime::now().toSec();
+        diagnostics_pub_ = private_nh_.advertise<diagnostic_msgs::DiagnosticArray>(diagnostics_config_.topic_name, 10);
+        diagnostics_timer_ = private_nh_.createWallTimer(
+            ros::WallDuration(diagnostics_config_.period), &Activity::PublishDiagnostics, this
+        );
+    }
+
+    // parse metrics config:
+    private_nh_.param("metrics/enable", metrics_config_.enable, false);
+    private_nh_.param("metrics/port", metrics_config_.port, 9101);
+    private_nh_.param("metrics/textfile_path", metrics_config_.textfile_path, std::string(""));
+    private_nh_.param("metrics/period", metrics_config_.period, 1.0);
+    if (metrics_config_.enable) {
+        RegisterMetrics();
+        metrics_exporter_ptr_ = std::make_shared<MetricsExporter>(metrics_registry_);
+        metrics_exporter_ptr_->Start(metrics_config_.port, metrics_config_.textfile_path, metrics_config_.period);
+    }
+
+    stage_timing_ = diagnostics_config_.enable || metrics_config_.enable;
 }
 
 bool Activity::Run(void) {
+    IMU_INTEGRATION_TRACE_SCOPE("Run");
+
     if (!ReadData())
         return false;
 
+    if (UpdateWindow()) {
+        const SlidingWindowOptimizer::Keyframe &keyframe = window_optimizer_ptr_->GetLatestKeyframe();
+        Eigen::Matrix4d pose = Eigen::Matrix4d::Identity();
+        pose.block<3, 3>(0, 0) = keyframe.R;
+        pose.block<3, 1>(0, 3) = keyframe.t;
+        odom_optimized_pub_ptr_->Publish(ros::Time(keyframe.time), GetBodyPose(pose), keyframe.v);
+    }
+
     while(HasData()) {
         if (UpdatePose()) {
+            if (flight_recorder_ptr_) {
+                flight_recorder_ptr_->AddState(imu_data_buff_.back().time, GetBodyPose(pose_), vel_);
+            }
+            WriteSharedState();
             PublishPose();
 //             SaveTrajectoryKitti();
             SaveTrajectoryTum();      
         }
     }
 
+    // dump on anomaly or request:
+    if (flight_recorder_ptr_) {
+        flight_recorder_ptr_->Update();
+    }
+
+    // everything parsed is processed at this point:
+    if (sim_clock_ack_ptr_) {
+        sim_clock_ack_ptr_->Update(0, last_imu_time_);
+        sim_clock_ack_ptr_->Update(1, last_odom_time_);
+        if (magnetometer_sub_ptr_) {
+            sim_clock_ack_ptr_->Update(2, last_magnetometer_time_);
+        }
+        sim_clock_ack_ptr_->Publish();
+    }
+
     return true;
 }
 
 bool Activity::ReadData(void) {
+    IMU_INTEGRATION_TRACE_SCOPE("ParseData");
+    ScopedCPUTimer cpu_timer(stage_timing_ ? &stage_cpu_time_.parse_data : nullptr);
+
+    const size_t num_imu_data = imu_data_buff_.size();
+    const size_t num_odom_data = odom_data_buff_.size();
+
     // fetch IMU measurements into buffer:
     imu_sub_ptr_->ParseData(imu_data_buff_);
     odom_ground_truth_sub_ptr->ParseData(odom_data_buff_);
 
+    if (imu_data_buff_.size() > num_imu_data) {
+        last_imu_time_ = imu_data_buff_.back().time;
+    }
+    if (odom_data_buff_.size() > num_odom_data) {
+        last_odom_time_ = odom_data_buff_.back().time;
+    }
+    if (magnetometer_sub_ptr_) {
+        magnetometer_sub_ptr_->ParseData(magnetometer_data_buff_);
+        if (!magnetometer_data_buff_.empty()) {
+            last_magnetometer_time_ = magnetometer_data_buff_.back().time;
+        }
+    }
+
+    // raw measurements, before any compensation:
+    if (flight_recorder_ptr_) {
+        for (auto it = imu_data_buff_.begin() + num_imu_data; it != imu_data_buff_.end(); ++it) {
+            flight_recorder_ptr_->AddIMUData(*it);
+        }
+        for (auto it = odom_data_buff_.begin() + num_odom_data; it != odom_data_buff_.end(); ++it) {
+            flight_recorder_ptr_->AddOdomData(*it);
+        }
+    }
+
+    // bad measurements are dropped once recorded, before compensation and every other consumer:
+    if (health_monitor_ptr_) {
+        for (auto it = imu_data_buff_.begin() + num_imu_data; it != imu_data_buff_.end(); ) {
+            const uint32_t flags = health_monitor_ptr_->CheckInput(*it);
+            if (flags) {
+                health_monitor_ptr_->Count(flags);
+                num_dropped_.Add();
+                it = imu_data_buff_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    // everything downstream sees measurements at body reference point:
+    if (imu_extrinsics_ptr_) {
+        for (auto it = imu_data_buff_.begin() + num_imu_data; it != imu_data_buff_.end(); ++it) {
+            imu_extrinsics_ptr_->Compensate(angular_vel_bias_, *it);
+        }
+    }
+
+    if (ground_truth_spline_ptr_) {
+        for (auto it = odom_data_buff_.begin() + num_odom_data; it != odom_data_buff_.end(); ++it) {
+            if (!ground_truth_spline_ptr_->AddPose(it->time, it->pose)) {
+                LOG(WARNING) << "Out of order ground truth at " << it->time << " skipped by ground truth spline.";
+            }
+        }
+    }
+
+    // synchronization is only needed for initialization:
+    if (!initialized_) {
+        for (auto it = imu_data_buff_.begin() + num_imu_data; it != imu_data_buff_.end(); ++it) {
+            // IMU stamp in odometry clock:
+            IMUData imu_data = *it;
+            imu_data.time -= time_offset_;
+            synchronizer_ptr_->AddReference(imu_data);
+        }
+        for (auto it = odom_data_buff_.begin() + num_odom_data; it != odom_data_buff_.end(); ++it) {
+            synchronizer_ptr_->Add<0>(*it);
+        }
+    }
+
+    // hand new measurements over to sliding window optimization, poses in IMU clock:
+    if (window_optimizer_ptr_) {
+        for (auto it = imu_data_buff_.begin() + num_imu_data; it != imu_data_buff_.end(); ++it) {
+            window_optimizer_ptr_->AddIMUData(*it);
+        }
+        for (auto it = odom_data_buff_.begin() + num_odom_data; it != odom_data_buff_.end(); ++it) {
+            OdomData odom_data = *it;
+            odom_data.time += time_offset_;
+            if (imu_extrinsics_ptr_) {
+                odom_data.pose = imu_extrinsics_ptr_->GetIMUPose(odom_data.pose);
+            }
+            window_optimizer_ptr_->AddPose(odom_data);
+        }
+    }
+
+    // hand new measurements over to time offset estimation:
+    if (time_offset_estimator_ptr_) {
+        time_offset_estimator_ptr_->AddIMUData(imu_data_buff_.begin() + num_imu_data, imu_data_buff_.end());
+        time_offset_estimator_ptr_->AddOdomData(odom_data_buff_.begin() + num_odom_data, odom_data_buff_.end());
+    }
+
     return true;
 }
 
+bool Activity::UpdateWindow(void) {
+    IMU_INTEGRATION_TRACE_SCOPE("UpdateWindow");
+
+    if (!window_optimizer_ptr_) {
+        return false;
+    }
+
+    return window_optimizer_ptr_->Update();
+}
+
 bool Activity::HasData(void) {
     if (
         imu_data_buff_.size() < static_cast<size_t>(2)
@@ -103,40 +499,73 @@ bool Activity::HasData(void) {
 }
 
 bool Activity::UpdatePose(void) {
+    IMU_INTEGRATION_TRACE_SCOPE("UpdatePose");
+    ScopedCPUTimer cpu_timer(stage_timing_ ? &stage_cpu_time_.update_pose : nullptr);
+
+    // reloaded params take effect from this sample on:
+    UpdateIMUParams();
+
+    // latest estimate from background thread:
+    if (time_offset_estimator_ptr_) {
+        time_offset_ = time_offset_estimator_ptr_->GetOffset();
+    }
+
     if (!initialized_) {
-        // use the latest measurement for initialization:
-        
-        static std::deque<OdomData> unsynced_odom_;
-        unsynced_odom_ = odom_data_buff_;
-        if (imu_data_buff_.size() == 0) {
+        // use the latest synchronized measurement for initialization:
+        std::tuple<IMUData, OdomData> synced;
+        bool valid_odom = false;
+        while (synchronizer_ptr_->Pop(synced)) {
+            valid_odom = true;
+        }
+
+        if (!valid_odom) {
+            // the synchronizer keeps its own copies, only the latest measurements are needed here:
+            num_dropped_.Add(imu_data_buff_.size() - 1);
+            imu_data_buff_.erase(imu_data_buff_.begin(), imu_data_buff_.end() - 1);
+            odom_data_buff_.erase(odom_data_buff_.begin(), odom_data_buff_.end() - 1);
+            magnetometer_data_buff_.clear();
             return false;
         }
-        
-        double cloud_time = imu_data_buff_.back().time;
-        bool valid_odom = OdomData::SyncData(unsynced_odom_, odom_data_buff_, cloud_time);
-        static bool sensor_inited = false;
-        if (!sensor_inited) {
-            if (!valid_odom) {
-                LOG(INFO) << "Validity check: " << std::endl
-                        << "odom: " << valid_odom << std::endl;
-                return false;
-            }
-            sensor_inited = true;
-        }        
-        
-        OdomData odom_data = odom_data_buff_.back();
-        IMUData imu_data = imu_data_buff_.back();
-        
-        pose_ = odom_data.pose;
+
+        OdomData odom_data = std::get<1>(synced);
+        IMUData imu_data = std::get<0>(synced);
+
+        // ground truth spline, once it covers the IMU stamp, instead of linear interpolation:
+        BSplineTrajectory::State state;
+        if (ground_truth_spline_ptr_ && ground_truth_spline_ptr_->Evaluate(imu_data.time, state)) {
+            odom_data.pose.block<3, 3>(0, 0) = state.R;
+            odom_data.pose.block<3, 1>(0, 3) = state.t;
+            odom_data.vel = state.v;
+        }
+
+        // back to IMU clock:
+        imu_data.time += time_offset_;
+
+        pose_ = imu_extrinsics_ptr_ ? imu_extrinsics_ptr_->GetIMUPose(odom_data.pose) : odom_data.pose;
         vel_ = odom_data.vel;
+        healthy_pose_ = pose_;
         init_time_ = odom_data.time;
         
         initialized_ = true;
 
+        if (non_holonomic_constraint_ptr_) {
+            non_holonomic_constraint_ptr_->Init(imu_data.time);
+        }
+        if (magnetometer_heading_ptr_) {
+            magnetometer_heading_ptr_->Init();
+            magnetometer_data_buff_.clear();
+        }
+
+        LOG(INFO) << "Initialized at " << imu_data.time << ", "
+                  << synchronizer_ptr_->GetNumDropped() << " unsynchronized IMU measurements dropped";
+
+        // only the synchronized measurement is kept:
+        num_dropped_.Add(imu_data_buff_.size() - 1);
+
         odom_data_buff_.clear();
         imu_data_buff_.clear();
 
-        // keep the latest IMU measurement for mid-value integration:
+        // keep the synchronized IMU measurement for mid-value integration:
         imu_data_buff_.push_back(imu_data);
         odom_data_buff_.push_back(odom_data);
         
@@ -147,6 +576,7 @@ bool Activity::UpdatePose(void) {
 
         // get deltas:
         IMUData imu_data = imu_data_buff_.back();
+
         const size_t index_curr = imu_data_buff_.size()-1;
         const size_t index_prev = 0;
         Eigen::Vector3d angular_delta;
@@ -192,7 +622,49 @@ bool Activity::UpdatePose(void) {
         
         // update position:
         UpdatePosition(delta_t, velocity_delta);        
+
+        if (health_monitor_ptr_) {
+            const uint32_t flags = health_monitor_ptr_->CheckState(angular_delta, velocity_delta, pose_, vel_);
+            if (flags) {
+                health_monitor_ptr_->Count(flags);
+                if (flags & HealthMonitor::NON_FINITE_STATE) {
+                    Reinitialize(imu_data);
+                } else {
+                    Eigen::Matrix3d R = pose_.block<3, 3>(0, 0);
+                    HealthMonitor::Orthonormalize(R);
+                    pose_.block<3, 3>(0, 0) = R;
+                }
+            }
+            healthy_pose_ = pose_;
+        }
+
+        // constraint covariance follows the same step:
+        if (non_holonomic_constraint_ptr_) {
+            const Eigen::Vector3d specific_force = 0.5 * (
+                R_prev * (imu_data_buff_.at(index_prev).linear_acceleration - linear_acc_bias_) +
+                R_curr * (imu_data.linear_acceleration - linear_acc_bias_)
+            );
+            non_holonomic_constraint_ptr_->Predict(delta_t, specific_force);
+            non_holonomic_constraint_ptr_->Correct(imu_data.time, pose_, vel_);
+        }
+
+        // magnetometer measurements up to current stamp correct yaw, on the constraint's error state if there is one:
+        if (magnetometer_heading_ptr_) {
+            magnetometer_heading_ptr_->Predict(delta_t);
+            while (!magnetometer_data_buff_.empty() && magnetometer_data_buff_.front().time <= imu_data.time) {
+                if (non_holonomic_constraint_ptr_) {
+                    magnetometer_heading_ptr_->Correct(magnetometer_data_buff_.front(), *non_holonomic_constraint_ptr_, pose_, vel_);
+                } else {
+                    magnetometer_heading_ptr_->Correct(magnetometer_data_buff_.front(), pose_);
+                }
+                magnetometer_data_buff_.pop_front();
+            }
+        }
                
+        // measurements between index_prev and index_curr are skipped:
+        num_integrated_.Add();
+        num_dropped_.Add(index_curr - index_prev - 1);
+
         // move forward -- 
         imu_data_buff_.clear();
         imu_data_buff_.push_back(imu_data);
@@ -205,23 +677,135 @@ bool Activity::UpdatePose(void) {
     return true;
 }
 
+void Activity::Reinitialize(const IMUData &imu_data) {
+    health_monitor_ptr_->CountReinitialization();
+    if (flight_recorder_ptr_) {
+        flight_recorder_ptr_->SetTrigger(FlightRecorder::Trigger::NAN_STATE, imu_data.time);
+    }
+
+    const OdomData &odom_data = odom_data_buff_.back();
+    if (odom_data.pose.allFinite() && odom_data.vel.allFinite()) {
+        // a. latest ground truth:
+        pose_ = imu_extrinsics_ptr_ ? imu_extrinsics_ptr_->GetIMUPose(odom_data.pose) : odom_data.pose;
+        vel_ = odom_data.vel;
+    } else {
+        // b. static alignment, roll and pitch from specific force, yaw and position from last healthy state:
+        const Eigen::Vector3d f = imu_data.linear_acceleration - linear_acc_bias_;
+        const double roll = atan2(f.y(), f.z());
+        const double pitch = atan2(-f.x(), sqrt(f.y() * f.y() + f.z() * f.z()));
+        const double yaw = atan2(healthy_pose_(1, 0), healthy_pose_(0, 0));
+
+        pose_ = healthy_pose_;
+        pose_.block<3, 3>(0, 0) = (
+            Eigen::AngleAxisd(yaw, Eigen::Vector3d::UnitZ()) *
+            Eigen::AngleAxisd(pitch, Eigen::Vector3d::UnitY()) *
+            Eigen::AngleAxisd(roll, Eigen::Vector3d::UnitX())
+        ).toRotationMatrix();
+        vel_ = Eigen::Vector3d::Zero();
+    }
+
+    if (non_holonomic_constraint_ptr_) {
+        non_holonomic_constraint_ptr_->Init(imu_data.time);
+    }
+    if (magnetometer_heading_ptr_) {
+        magnetometer_heading_ptr_->Init();
+    }
+
+    LOG(WARNING) << "Reinitialized at " << imu_data.time << " after non-finite state.";
+}
+
+void Activity::UpdateIMUParams(void) {
+    IMUParams params;
+    if (!imu_params_watcher_ptr_->GetUpdate(params)) {
+        return;
+    }
+
+    IMUParamsWatcher::SetParams(params, imu_config_);
+
+    G_ = Eigen::Vector3d(params.gravity.x, params.gravity.y, params.gravity.z);
+    angular_vel_bias_ = Eigen::Vector3d(
+        params.bias.angular_velocity.x, params.bias.angular_velocity.y, params.bias.angular_velocity.z
+    );
+    linear_acc_bias_ = Eigen::Vector3d(
+        params.bias.linear_acceleration.x, params.bias.linear_acceleration.y, params.bias.linear_acceleration.z
+    );
+
+    // noise is copied into each filter on construction:
+    if (non_holonomic_constraint_ptr_) {
+        non_holonomic_constraint_ptr_->SetNoise(params.gyro_noise_stddev, params.acc_noise_stddev);
+    }
+    if (magnetometer_heading_ptr_) {
+        magnetometer_heading_ptr_->SetNoise(params.gyro_noise_stddev);
+    }
+    if (window_optimizer_ptr_) {
+        window_optimizer_ptr_->SetIMUParams(G_, angular_vel_bias_, linear_acc_bias_);
+        window_optimizer_ptr_->SetNoise(params.gyro_noise_stddev, params.acc_noise_stddev);
+    }
+}
+
+void Activity::WriteSharedState(void) {
+    if (!shared_state_writer_ptr_) {
+        return;
+    }
+
+    const Eigen::Matrix4d pose = GetBodyPose(pose_);
+    const Eigen::Quaterniond q(pose.block<3, 3>(0, 0));
+
+    SharedNavState state;
+    state.time = imu_data_buff_.back().time;
+    state.position[0] = pose(0, 3);
+    state.position[1] = pose(1, 3);
+    state.position[2] = pose(2, 3);
+    state.orientation[0] = q.x();
+    state.orientation[1] = q.y();
+    state.orientation[2] = q.z();
+    state.orientation[3] = q.w();
+    state.velocity[0] = vel_.x();
+    state.velocity[1] = vel_.y();
+    state.velocity[2] = vel_.z();
+
+    shared_state_writer_ptr_->Write(state);
+}
+
 bool Activity::PublishPose() {
+    IMU_INTEGRATION_TRACE_SCOPE("PublishPose");
+    ScopedCPUTimer cpu_timer(stage_timing_ ? &stage_cpu_time_.publish_pose : nullptr);
+
+    const ros::Time stamp = ros::Time::now();
+    if (odom_config_.preserialized) {
+        // only stamp, pose and twist change between estimations:
+        odom_estimation_serialized_pub_ptr_->Publish(stamp, GetBodyPose(pose_), vel_);
+    } else {
+        PublishMessage(stamp);
+    }
+
+    num_published_.Add();
+    const double publish_lag = stamp.toSec() - imu_data_buff_.back().time;
+    if (publish_lag >= 0.0) {
+        publish_lag_.Record(static_cast<uint64_t>(1.0e9 * publish_lag));
+    }
+
+    return true;
+}
+
+void Activity::PublishMessage(const ros::Time &stamp) {
     // a. set header:
-    message_odom_.header.stamp = ros::Time::now();
+    message_odom_.header.stamp = stamp;
     message_odom_.header.frame_id = odom_config_.frame_id;
     
     // b. set child frame id:
     message_odom_.child_frame_id = odom_config_.frame_id;
 
     // b. set orientation:
-    Eigen::Quaterniond q(pose_.block<3, 3>(0, 0));
+    const Eigen::Matrix4d pose = GetBodyPose(pose_);
+    Eigen::Quaterniond q(pose.block<3, 3>(0, 0));
     message_odom_.pose.pose.orientation.x = q.x();
     message_odom_.pose.pose.orientation.y = q.y();
     message_odom_.pose.pose.orientation.z = q.z();
     message_odom_.pose.pose.orientation.w = q.w();
 
     // c. set position:
-    Eigen::Vector3d t = pose_.block<3, 1>(0, 3);
+    Eigen::Vector3d t = pose.block<3, 1>(0, 3);
     message_odom_.pose.pose.position.x = t.x();
     message_odom_.pose.pose.position.y = t.y();
     message_odom_.pose.pose.position.z = t.z();  
@@ -232,8 +816,6 @@ bool Activity::PublishPose() {
     message_odom_.twist.twist.linear.z = vel_.z(); 
 
     odom_estimation_pub_.publish(message_odom_);
-
-    return true;
 }
 
 /**
@@ -242,7 +824,7 @@ bool Activity::PublishPose() {
  * @return unbiased angular velocity in body frame
  */
 inline Eigen::Vector3d Activity::GetUnbiasedAngularVel(const Eigen::Vector3d &angular_vel) {
-    return angular_vel - angular_vel_bias_;
+    return estimator::GetUnbiasedAngularVel(angular_vel, angular_vel_bias_);
 }
 
 /**
@@ -255,7 +837,7 @@ inline Eigen::Vector3d Activity::GetUnbiasedLinearAcc(
     const Eigen::Vector3d &linear_acc,
     const Eigen::Matrix3d &R
 ) {
-    return R*(linear_acc - linear_acc_bias_) - G_;
+    return estimator::GetUnbiasedLinearAcc(linear_acc, R, linear_acc_bias_, G_);
 }
 
 /**
@@ -287,7 +869,9 @@ bool Activity::GetAngularDelta(
     Eigen::Vector3d angular_vel_curr = GetUnbiasedAngularVel(imu_data_curr.angular_velocity);
     Eigen::Vector3d angular_vel_prev = GetUnbiasedAngularVel(imu_data_prev.angular_velocity);
 
-    angular_delta = 0.5*delta_t*(angular_vel_curr + angular_vel_prev);
+    angular_delta = estimator::GetAngularDelta(
+        IntegrationScheme::MIDPOINT, angular_vel_curr, angular_vel_prev, delta_t
+    );
 
     return true;
 }
@@ -313,7 +897,9 @@ bool Activity::GetAngularDeltaEuler(
 
     Eigen::Vector3d angular_vel_prev = GetUnbiasedAngularVel(imu_data_prev.angular_velocity);
 
-    angular_delta = delta_t* angular_vel_prev;
+    angular_delta = estimator::GetAngularDelta(
+        IntegrationScheme::EULER, angular_vel_prev, angular_vel_prev, delta_t
+    );
 
     return true;
 }
@@ -350,7 +936,9 @@ bool Activity::GetVelocityDelta(
     Eigen::Vector3d linear_acc_curr = GetUnbiasedLinearAcc(imu_data_curr.linear_acceleration, R_curr);
     Eigen::Vector3d linear_acc_prev = GetUnbiasedLinearAcc(imu_data_prev.linear_acceleration, R_prev);
     
-    velocity_delta = 0.5*delta_t*(linear_acc_curr + linear_acc_prev);
+    velocity_delta = estimator::GetVelocityDelta(
+        IntegrationScheme::MIDPOINT, linear_acc_curr, linear_acc_prev, delta_t
+    );
 
     return true;
 }
@@ -377,7 +965,9 @@ bool Activity::GetVelocityDeltaEuler(
 
     Eigen::Vector3d linear_acc_prev = GetUnbiasedLinearAcc(imu_data_prev.linear_acceleration, R_prev);
     
-    velocity_delta = delta_t*linear_acc_prev;
+    velocity_delta = estimator::GetVelocityDelta(
+        IntegrationScheme::EULER, linear_acc_prev, linear_acc_prev, delta_t
+    );
 
     return true;
 }
@@ -397,29 +987,12 @@ void Activity::UpdateOrientation(
     //
     // TODO: this could be a helper routine for your own implementation
     //
-    // magnitude:
-    double angular_delta_mag = angular_delta.norm();
-    // direction:
-    Eigen::Vector3d angular_delta_dir = angular_delta.normalized();
-
-    // build delta q:
-    double angular_delta_cos = cos(angular_delta_mag/2.0);
-    double angular_delta_sin = sin(angular_delta_mag/2.0);
-    Eigen::Quaterniond dq(
-        angular_delta_cos, 
-        angular_delta_sin*angular_delta_dir.x(), 
-        angular_delta_sin*angular_delta_dir.y(), 
-        angular_delta_sin*angular_delta_dir.z()
-    );
-    Eigen::Quaterniond q(pose_.block<3, 3>(0, 0));
-    
-    // update:
-    q = q*dq;
-    
-    // write back:
     R_prev = pose_.block<3, 3>(0, 0);
-    pose_.block<3, 3>(0, 0) = q.normalized().toRotationMatrix();
-    R_curr = pose_.block<3, 3>(0, 0);
+    R_curr = R_prev;
+    estimator::UpdateOrientation(angular_delta, R_curr);
+
+    // write back:
+    pose_.block<3, 3>(0, 0) = R_curr;
 }
 
 /**
@@ -432,8 +1005,18 @@ void Activity::UpdatePosition(const double &delta_t, const Eigen::Vector3d &velo
     //
     // TODO: this could be a helper routine for your own implementation
     //
-    pose_.block<3, 1>(0, 3) += delta_t*vel_ + 0.5*delta_t*velocity_delta;
-    vel_ += velocity_delta;
+    Eigen::Vector3d t = pose_.block<3, 1>(0, 3);
+    estimator::UpdatePosition(delta_t, velocity_delta, t, vel_);
+    pose_.block<3, 1>(0, 3) = t;
+}
+
+/**
+ * @brief  get body pose from integrated pose
+ * @param  pose, integrated pose in IMU axes
+ * @return body pose
+ */
+Eigen::Matrix4d Activity::GetBodyPose(const Eigen::Matrix4d &pose) const {
+    return imu_extrinsics_ptr_ ? imu_extrinsics_ptr_->GetBodyPose(pose) : pose;
 }
 
 bool Activity::SaveTrajectoryKitti() {
@@ -452,10 +1035,11 @@ bool Activity::SaveTrajectoryKitti() {
     }
     
     Eigen::Matrix4d truth_pose_ = odom_data_buff_.back().pose;
+    Eigen::Matrix4d body_pose = GetBodyPose(pose_);
     for (int i = 0; i < 3; ++i) {
         for (int j = 0; j < 4; ++j) {
             ground_truth << truth_pose_(i, j);
-            laser_odom << pose_(i, j);
+            laser_odom << body_pose(i, j);
             if (i == 2 && j == 3) {
                 ground_truth << std::endl;
                 laser_odom << std::endl;
@@ -470,49 +1054,72 @@ bool Activity::SaveTrajectoryKitti() {
 }
 
 bool Activity::SaveTrajectoryTum() {
-    static std::ofstream ground_truth, laser_odom;
-    static bool is_file_created = false;
+    IMU_INTEGRATION_TRACE_SCOPE("SaveTrajectoryTum");
+    ScopedCPUTimer cpu_timer(stage_timing_ ? &stage_cpu_time_.save_trajectory : nullptr);
+
     std::string WORK_SPACE_PATH="/workspace/assignments/05-imu-navigation/src/imu_integration";
     
-    if (!is_file_created) {
+    if (!laser_odom_ofs_.is_open()) {
         if (!FileManager::CreateDirectory(WORK_SPACE_PATH + "/slam_data/trajectory"))
             return false;
-        if (!FileManager::CreateFile(ground_truth, WORK_SPACE_PATH + "/slam_data/trajectory/ground_truth.txt"))
+        if (!FileManager::CreateFile(ground_truth_ofs_, WORK_SPACE_PATH + "/slam_data/trajectory/ground_truth.txt"))
             return false;
-        if (!FileManager::CreateFile(laser_odom, WORK_SPACE_PATH + "/slam_data/trajectory/laser_odom.txt"))
+        if (!FileManager::CreateFile(laser_odom_ofs_, WORK_SPACE_PATH + "/slam_data/trajectory/laser_odom.txt"))
             return false;
-        is_file_created = true;
     }
-    
-    Eigen::Matrix4d odom_pose = odom_data_buff_.back().pose;
-    Eigen::Quaterniond odom_q ( odom_pose.block<3,3>(0,0) );
-    double odom_time = odom_data_buff_.back().time - init_time_;
-    ground_truth << odom_time << " "
-                 << odom_pose(0,3) << " "
-                 << odom_pose(1,3) << " "
-                 << odom_pose(2,3) << " "
-                 << odom_q.x() << " "
-                 << odom_q.y() << " "
-                 << odom_q.z() << " "
-                 << odom_q.w() << std::endl;
-                 
- 
-    Eigen::Matrix4d imu_pose = pose_;
-    Eigen::Quaterniond imu_q ( imu_pose.block<3,3>(0,0) );
-    double imu_time = imu_data_buff_.back().time - init_time_;
-    laser_odom << imu_time << " "
-                 << imu_pose(0,3) << " "
-                 << imu_pose(1,3) << " "
-                 << imu_pose(2,3) << " "
-                 << imu_q.x() << " "
-                 << imu_q.y() << " "
-                 << imu_q.z() << " "
-                 << imu_q.w() << std::endl;
-                                  
+
+    // estimate at IMU stamp in odometry clock:
+    OdomData estimate;
+    estimate.time = imu_data_buff_.back().time - time_offset_;
+    estimate.pose = GetBodyPose(pose_);
+    estimate.vel = vel_;
+
+    if (!ground_truth_spline_ptr_) {
+        // latest ground truth, up to one odometry period apart from the estimate:
+        WritePoseTum(ground_truth_ofs_, odom_data_buff_.back().time, odom_data_buff_.back().pose);
+        WritePoseTum(laser_odom_ofs_, estimate.time, estimate.pose);
+        return true;
+    }
+
+    // the spline lags a few knots behind the latest ground truth, so estimates are held back until it covers them:
+    pending_estimates_.push_back(estimate);
+    WritePendingEstimates(estimate.time - ground_truth_spline_config_.max_gap);
 
     return true;
 }
 
+void Activity::WritePendingEstimates(double min_pending_time) {
+    // both files stay row aligned, estimates the spline cannot cover, e.g. after a ground truth gap, are dropped:
+    while (!pending_estimates_.empty()) {
+        const OdomData &pending = pending_estimates_.front();
+
+        BSplineTrajectory::State state;
+        if (ground_truth_spline_ptr_->Evaluate(pending.time, state)) {
+            Eigen::Matrix4d odom_pose = Eigen::Matrix4d::Identity();
+            odom_pose.block<3, 3>(0, 0) = state.R;
+            odom_pose.block<3, 1>(0, 3) = state.t;
+            WritePoseTum(ground_truth_ofs_, pending.time, odom_pose);
+            WritePoseTum(laser_odom_ofs_, pending.time, pending.pose);
+        } else if (pending.time >= min_pending_time) {
+            break;
+        }
+
+        pending_estimates_.pop_front();
+    }
+}
+
+void Activity::WritePoseTum(std::ofstream &ofs, double time, const Eigen::Matrix4d &pose) {
+    Eigen::Quaterniond q ( pose.block<3,3>(0,0) );
+    ofs << time - init_time_ << " "
+        << pose(0,3) << " "
+        << pose(1,3) << " "
+        << pose(2,3) << " "
+        << q.x() << " "
+        << q.y() << " "
+        << q.z() << " "
+        << q.w() << std::endl;
+}
+
 
 } // namespace estimator
 
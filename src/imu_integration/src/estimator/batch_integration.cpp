@@ -0,0 +1,233 @@
+/*
+ * @Description: IMU integration over whole measurement arrays, free of ROS
+ * @Date: 2026-10-18 10:52:31
+ */
+#include "imu_integration/estimator/batch_integration.hpp"
+
+#include <algorithm>
+
+#include "imu_integration/estimator/dual.hpp"
+
+namespace imu_integration {
+
+namespace estimator {
+
+namespace {
+
+// rows of a row-major array, output to a null array is skipped:
+struct Rows {
+    double *data;
+    size_t stride;
+};
+
+struct ConstRows {
+    const double *data;
+    size_t stride;
+
+    const double *operator[](size_t i) const { return data + i * stride; }
+};
+
+template <typename T>
+inline void Store(const Rows &rows, size_t i, const T *values, size_t size) {
+    if (rows.data) {
+        for (size_t j = 0; j < size; ++j) {
+            rows.data[i * rows.stride + j] = GetValue(values[j]);
+        }
+    }
+}
+
+// integration params in scalar type T:
+template <typename T>
+struct Model {
+    IntegrationScheme scheme;
+    Vector3<T> gravity;
+    Vector3<T> angular_vel_bias;
+    Vector3<T> linear_acc_bias;
+    // IMU clock scale, stamp deltas are multiplied by it:
+    T time_scale;
+};
+
+Model<double> GetModel(const BatchIntegrationParams &params) {
+    return Model<double>{params.scheme, params.gravity, params.angular_vel_bias, params.linear_acc_bias, 1.0};
+}
+
+// shared by all array layouts and scalar types, final state is returned through R_curr, t and v:
+template <typename T>
+void Integrate(
+    const Model<T> &model, size_t num_samples,
+    const ConstRows &time, const ConstRows &angular_velocity, const ConstRows &linear_acceleration,
+    const Eigen::Matrix4d &init_pose, const Eigen::Vector3d &init_vel,
+    const Rows &position, const Rows &orientation, const Rows &velocity,
+    Matrix3<T> &R_curr, Vector3<T> &t, Vector3<T> &v
+) {
+    R_curr = init_pose.block<3, 3>(0, 0).cast<T>();
+    t = init_pose.block<3, 1>(0, 3).cast<T>();
+    v = init_vel.cast<T>();
+
+    const bool has_output = (position.data || orientation.data || velocity.data);
+
+    // same unbiasing as Activity::GetUnbiasedAngularVel and Activity::GetUnbiasedLinearAcc:
+    Vector3<T> angular_vel_prev = GetUnbiasedAngularVel(
+        Eigen::Map<const Eigen::Vector3d>(angular_velocity[0]).cast<T>(), model.angular_vel_bias
+    );
+    Vector3<T> linear_acc_prev = GetUnbiasedLinearAcc(
+        Eigen::Map<const Eigen::Vector3d>(linear_acceleration[0]).cast<T>(), R_curr,
+        model.linear_acc_bias, model.gravity
+    );
+
+    for (size_t i = 0; i < num_samples; ++i) {
+        if (i > 0) {
+            const T delta_t = model.time_scale * (time[i][0] - time[i - 1][0]);
+
+            // a. orientation:
+            const Vector3<T> angular_vel_curr = GetUnbiasedAngularVel(
+                Eigen::Map<const Eigen::Vector3d>(angular_velocity[i]).cast<T>(), model.angular_vel_bias
+            );
+            UpdateOrientation(
+                GetAngularDelta(model.scheme, angular_vel_curr, angular_vel_prev, delta_t), R_curr
+            );
+
+            // b. position and velocity:
+            const Vector3<T> linear_acc_curr = GetUnbiasedLinearAcc(
+                Eigen::Map<const Eigen::Vector3d>(linear_acceleration[i]).cast<T>(), R_curr,
+                model.linear_acc_bias, model.gravity
+            );
+            UpdatePosition(
+                delta_t, GetVelocityDelta(model.scheme, linear_acc_curr, linear_acc_prev, delta_t), t, v
+            );
+
+            angular_vel_prev = angular_vel_curr;
+            linear_acc_prev = linear_acc_curr;
+        }
+
+        if (has_output) {
+            const Eigen::Quaternion<T> q(R_curr);
+            Store(position, i, t.data(), 3);
+            Store(orientation, i, q.coeffs().data(), 4);
+            Store(velocity, i, v.data(), 3);
+        }
+    }
+}
+
+} // namespace
+
+void IntegrateBatch(
+    const BatchIntegrationParams &params,
+    size_t num_samples, const double *time,
+    const double *angular_velocity, const double *linear_acceleration,
+    const Eigen::Matrix4d &init_pose, const Eigen::Vector3d &init_vel,
+    double *position, double *orientation, double *velocity
+) {
+    if (num_samples == 0) {
+        return;
+    }
+
+    Eigen::Matrix3d R;
+    Eigen::Vector3d t, v;
+    Integrate(
+        GetModel(params), num_samples,
+        ConstRows{time, 1}, ConstRows{angular_velocity, 3}, ConstRows{linear_acceleration, 3},
+        init_pose, init_vel,
+        Rows{position, 3}, Rows{orientation, 4}, Rows{velocity, 3},
+        R, t, v
+    );
+}
+
+void IntegratePacked(
+    const BatchIntegrationParams &params,
+    size_t num_samples, const double *samples,
+    const Eigen::Matrix4d &init_pose, const Eigen::Vector3d &init_vel,
+    Eigen::Matrix4d &pose, Eigen::Vector3d &vel,
+    double *states
+) {
+    pose = init_pose;
+    vel = init_vel;
+    if (num_samples == 0) {
+        return;
+    }
+
+    Eigen::Matrix3d R;
+    Eigen::Vector3d t;
+    Integrate(
+        GetModel(params), num_samples,
+        ConstRows{samples, kPackedSampleSize}, 
+        ConstRows{samples + 1, kPackedSampleSize}, 
+        ConstRows{samples + 4, kPackedSampleSize},
+        init_pose, init_vel,
+        Rows{states, kPackedStateSize}, 
+        Rows{states ? states + 3 : nullptr, kPackedStateSize}, 
+        Rows{states ? states + 7 : nullptr, kPackedStateSize},
+        R, t, vel
+    );
+
+    pose.block<3, 3>(0, 0) = R;
+    pose.block<3, 1>(0, 3) = t;
+}
+
+void IntegrateSensitivity(
+    const BatchIntegrationParams &params,
+    size_t num_samples, const double *time,
+    const double *angular_velocity, const double *linear_acceleration,
+    const Eigen::Matrix4d &init_pose, const Eigen::Vector3d &init_vel,
+    Eigen::Matrix4d &pose, Eigen::Vector3d &vel,
+    SensitivityJacobian &jacobian
+) {
+    typedef Dual<kNumSensitivityParams> Scalar;
+
+    pose = init_pose;
+    vel = init_vel;
+    jacobian.setZero();
+    if (num_samples == 0) {
+        return;
+    }
+
+    // seed every param:
+    Model<Scalar> model;
+    model.scheme = params.scheme;
+    for (int i = 0; i < 3; ++i) {
+        model.angular_vel_bias(i) = Scalar::Variable(params.angular_vel_bias(i), kIndexParamAngularVelBias + i);
+        model.linear_acc_bias(i) = Scalar::Variable(params.linear_acc_bias(i), kIndexParamLinearAccBias + i);
+        model.gravity(i) = Scalar::Variable(params.gravity(i), kIndexParamGravity + i);
+    }
+    model.time_scale = Scalar::Variable(1.0, kIndexParamTimeScale);
+
+    Matrix3<Scalar> R;
+    Vector3<Scalar> t, v;
+    Integrate(
+        model, num_samples,
+        ConstRows{time, 1}, ConstRows{angular_velocity, 3}, ConstRows{linear_acceleration, 3},
+        init_pose, init_vel,
+        Rows{nullptr, 3}, Rows{nullptr, 4}, Rows{nullptr, 3},
+        R, t, v
+    );
+
+    Eigen::Matrix3d R_value;
+    for (int i = 0; i < 3; ++i) {
+        pose(i, 3) = t(i).a;
+        vel(i) = v(i).a;
+        jacobian.row(i) = t(i).v.transpose();
+        jacobian.row(3 + i) = v(i).v.transpose();
+        for (int j = 0; j < 3; ++j) {
+            R_value(i, j) = R(i, j).a;
+        }
+    }
+    pose.block<3, 3>(0, 0) = R_value;
+
+    // dR = [dtheta]x * R, skew-symmetric part guards against round-off:
+    for (int k = 0; k < kNumSensitivityParams; ++k) {
+        Eigen::Matrix3d dR;
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                dR(i, j) = R(i, j).v(k);
+            }
+        }
+        const Eigen::Matrix3d dtheta_hat = dR * R_value.transpose();
+        jacobian(6, k) = 0.5 * (dtheta_hat(2, 1) - dtheta_hat(1, 2));
+        jacobian(7, k) = 0.5 * (dtheta_hat(0, 2) - dtheta_hat(2, 0));
+        jacobian(8, k) = 0.5 * (dtheta_hat(1, 0) - dtheta_hat(0, 1));
+    }
+}
+
+} // namespace estimator
+
+} // namespace imu_integration
@@ -0,0 +1,325 @@
+/*
+ * @Description: IMU integration runtime diagnostics
+ * @Date: 2026-10-18 15:02:27
+ */
+#include <cmath>
+#include <sstream>
+
+#include "imu_integration/estimator/activity.hpp"
+#include "glog/logging.h"
+
+namespace imu_integration {
+
+namespace estimator {
+
+namespace {
+
+template <typename T>
+void AddValue(diagnostic_msgs::DiagnosticStatus &status, const std::string &key, const T &value) {
+    std::ostringstream oss;
+    oss << value;
+
+    diagnostic_msgs::KeyValue key_value;
+    key_value.key = key;
+    key_value.value = oss.str();
+    status.values.push_back(key_value);
+}
+
+void AddPercentiles(
+    diagnostic_msgs::DiagnosticStatus &status, const std::string &stage,
+    const LatencyHistogram::Snapshot &snapshot
+) {
+    // CPU time in microseconds:
+    AddValue(status, stage + " count", snapshot.GetTotal());
+    AddValue(status, stage + " cpu p50 [us]", 1.0e-3 * snapshot.GetPercentile(0.50));
+    AddValue(status, stage + " cpu p90 [us]", 1.0e-3 * snapshot.GetPercentile(0.90));
+    AddValue(status, stage + " cpu p99 [us]", 1.0e-3 * snapshot.GetPercentile(0.99));
+    AddValue(status, stage + " cpu max [us]", 1.0e-3 * snapshot.GetPercentile(1.00));
+}
+
+} // namespace
+
+void Activity::PublishDiagnostics(const ros::WallTimerEvent &event) {
+    const double time = ros::WallTime::now().toSec();
+    const double window = time - diagnostics_prev_.time;
+    if (window <= 0.0) {
+        return;
+    }
+
+    // a. throughput over the last window:
+    const SubscriberStats &imu_stats = imu_sub_ptr_->GetStats();
+    const SubscriberStats &odom_stats = odom_ground_truth_sub_ptr->GetStats();
+
+    const uint64_t num_received = imu_stats.num_received.Get();
+    const uint64_t num_integrated = num_integrated_.Get();
+    const uint64_t num_dropped = num_dropped_.Get();
+
+    const double input_rate = (num_received - diagnostics_prev_.num_received) / window;
+    const double processing_rate = (num_integrated - diagnostics_prev_.num_integrated) / window;
+    const uint64_t window_dropped = num_dropped - diagnostics_prev_.num_dropped;
+
+    // b. stage CPU time over the last window:
+    LatencyHistogram::Snapshot parse_data, update_pose, publish_pose, save_trajectory;
+    stage_cpu_time_.parse_data.GetSnapshot(parse_data);
+    stage_cpu_time_.update_pose.GetSnapshot(update_pose);
+    stage_cpu_time_.publish_pose.GetSnapshot(publish_pose);
+    stage_cpu_time_.save_trajectory.GetSnapshot(save_trajectory);
+
+    diagnostic_msgs::DiagnosticStatus status;
+    status.name = ros::this_node::getName() + ": imu integration";
+    status.hardware_id = imu_config_.topic_name;
+
+    if (input_rate > 0.0 && processing_rate < 0.9 * input_rate) {
+        status.level = diagnostic_msgs::DiagnosticStatus::WARN;
+        status.message = "estimator falls behind input";
+    } else if (window_dropped > 0) {
+        status.level = diagnostic_msgs::DiagnosticStatus::WARN;
+        status.message = "measurements dropped";
+    } else {
+        status.level = diagnostic_msgs::DiagnosticStatus::OK;
+        status.message = "OK";
+    }
+
+    AddValue(status, "imu received", num_received);
+    AddValue(status, "imu backlog high-water mark", imu_stats.buffer_high_water_mark.load(std::memory_order_relaxed));
+    AddValue(status, "odom received", odom_stats.num_received.Get());
+    AddValue(status, "odom backlog high-water mark", odom_stats.buffer_high_water_mark.load(std::memory_order_relaxed));
+    AddValue(status, "samples integrated", num_integrated);
+    AddValue(status, "samples dropped", num_dropped);
+    AddValue(status, "input rate [Hz]", input_rate);
+    AddValue(status, "processing rate [Hz]", processing_rate);
+    AddValue(status, "processing / input ratio", (input_rate > 0.0) ? processing_rate / input_rate : 0.0);
+    if (time_offset_estimator_ptr_) {
+        AddValue(status, "imu time offset [s]", time_offset_estimator_ptr_->GetOffset());
+        AddValue(status, "imu time offset correlation", time_offset_estimator_ptr_->GetCorrelation());
+        AddValue(status, "imu time offset estimates", time_offset_estimator_ptr_->GetNumEstimates().Get());
+    }
+    if (health_monitor_ptr_) {
+        AddValue(status, "non-finite measurements", health_monitor_ptr_->GetNumNonFiniteInput().Get());
+        AddValue(status, "implausible measurements", health_monitor_ptr_->GetNumImplausibleInput().Get());
+        AddValue(status, "non-finite states", health_monitor_ptr_->GetNumNonFiniteState().Get());
+        AddValue(status, "orthonormality corrections", health_monitor_ptr_->GetNumOrthonormalityDrift().Get());
+        AddValue(status, "reinitializations", health_monitor_ptr_->GetNumReinitializations().Get());
+    }
+    if (flight_recorder_ptr_) {
+        AddValue(status, "flight recorder anomalies", flight_recorder_ptr_->GetNumTriggers().Get());
+        AddValue(status, "flight recorder dumps", flight_recorder_ptr_->GetNumDumps().Get());
+    }
+    if (non_holonomic_constraint_ptr_) {
+        const ErrorStateCovariance &P = non_holonomic_constraint_ptr_->GetCovariance();
+        AddValue(status, "non-holonomic updates", non_holonomic_constraint_ptr_->GetNumUpdates().Get());
+        AddValue(status, "position stddev [m]", std::sqrt(P.block<3, 3>(kIndexErrorPos, kIndexErrorPos).trace()));
+    }
+    if (magnetometer_heading_ptr_) {
+        AddValue(status, "magnetometer updates", magnetometer_heading_ptr_->GetNumUpdates().Get());
+        AddValue(status, "magnetometer rejected", magnetometer_heading_ptr_->GetNumRejected().Get());
+        AddValue(status, "magnetic model evaluations", magnetometer_heading_ptr_->GetCache().GetNumEvaluations().Get());
+        // yaw is tracked by the constraint's error state when both are enabled:
+        AddValue(
+            status, "yaw stddev [rad]",
+            non_holonomic_constraint_ptr_ ?
+                std::sqrt(non_holonomic_constraint_ptr_->GetCovariance()(kIndexErrorOri + 2, kIndexErrorOri + 2)) :
+                magnetometer_heading_ptr_->GetYawStddev()
+        );
+    }
+    if (window_optimizer_ptr_) {
+        LatencyHistogram::Snapshot solve_time;
+        window_optimizer_ptr_->GetSolveTime().GetSnapshot(solve_time);
+        AddValue(status, "window keyframes", window_optimizer_ptr_->GetNumKeyframes().Get());
+        AddValue(status, "window time budget overruns", window_optimizer_ptr_->GetNumBudgetOverruns().Get());
+        AddValue(status, "window solve p50 [us]", 1.0e-3 * solve_time.GetPercentile(0.50));
+        AddValue(status, "window solve p99 [us]", 1.0e-3 * solve_time.GetPercentile(0.99));
+    }
+    AddPercentiles(status, "ParseData", parse_data - diagnostics_prev_.parse_data);
+    AddPercentiles(status, "UpdatePose", update_pose - diagnostics_prev_.update_pose);
+    AddPercentiles(status, "PublishPose", publish_pose - diagnostics_prev_.publish_pose);
+    AddPercentiles(status, "SaveTrajectoryTum", save_trajectory - diagnostics_prev_.save_trajectory);
+
+    diagnostic_msgs::DiagnosticArray message_diagnostics;
+    message_diagnostics.header.stamp = ros::Time::now();
+    message_diagnostics.status.push_back(status);
+    diagnostics_pub_.publish(message_diagnostics);
+
+    // move window forward:
+    diagnostics_prev_.time = time;
+    diagnostics_prev_.num_received = num_received;
+    diagnostics_prev_.num_integrated = num_integrated;
+    diagnostics_prev_.num_dropped = num_dropped;
+    diagnostics_prev_.parse_data = parse_data;
+    diagnostics_prev_.update_pose = update_pose;
+    diagnostics_prev_.publish_pose = publish_pose;
+    diagnostics_prev_.save_trajectory = save_trajectory;
+}
+
+void Activity::Report(void) {
+    const double elapsed = ros::WallTime::now().toSec() - start_time_;
+
+    LatencyHistogram::Snapshot update_pose, publish_lag;
+    stage_cpu_time_.update_pose.GetSnapshot(update_pose);
+    publish_lag_.GetSnapshot(publish_lag);
+
+    const uint64_t num_received = imu_sub_ptr_->GetStats().num_received.Get();
+    const uint64_t num_integrated = num_integrated_.Get();
+
+    LOG(INFO) << "Estimator summary over " << elapsed << " s:" << std::endl
+              << "\timu received " << num_received 
+              << ", integrated " << num_integrated
+              << ", dropped " << num_dropped_.Get()
+              << ", published " << num_published_.Get() << std::endl
+              << "\tinput rate " << num_received / elapsed << " Hz"
+              << ", sustained throughput " << num_integrated / elapsed << " Hz" << std::endl
+              << "\timu backlog high-water mark " 
+              << imu_sub_ptr_->GetStats().buffer_high_water_mark.load(std::memory_order_relaxed) << std::endl
+              << "\tpublish lag p50 " << 1.0e-6 * publish_lag.GetPercentile(0.50) << " ms"
+              << ", p99 " << 1.0e-6 * publish_lag.GetPercentile(0.99) << " ms"
+              << ", max " << 1.0e-6 * publish_lag.GetPercentile(1.00) << " ms";
+
+    // stage timers only run for diagnostics or metrics:
+    if (stage_timing_) {
+        LOG(INFO) << "\tUpdatePose cpu p50 " << 1.0e-3 * update_pose.GetPercentile(0.50) << " us"
+                  << ", p99 " << 1.0e-3 * update_pose.GetPercentile(0.99) << " us";
+    }
+}
+
+void Activity::RegisterMetrics(void) {
+    const std::string prefix("imu_integration_estimator_");
+
+    metrics_registry_.AddCounter(
+        prefix + "imu_received_total", "IMU measurements received.", "",
+        &imu_sub_ptr_->GetStats().num_received
+    );
+    metrics_registry_.AddCounter(
+        prefix + "odom_received_total", "Ground truth odometry messages received.", "",
+        &odom_ground_truth_sub_ptr->GetStats().num_received
+    );
+    metrics_registry_.AddCounter(
+        prefix + "samples_integrated_total", "IMU measurements integrated.", "", &num_integrated_
+    );
+    metrics_registry_.AddCounter(
+        prefix + "samples_dropped_total", "IMU measurements skipped by integration.", "", &num_dropped_
+    );
+    metrics_registry_.AddCounter(
+        prefix + "poses_published_total", "Pose estimations published.", "", &num_published_
+    );
+
+    const SubscriberStats *imu_stats = &imu_sub_ptr_->GetStats();
+    const SubscriberStats *odom_stats = &odom_ground_truth_sub_ptr->GetStats();
+    metrics_registry_.AddGauge(
+        prefix + "backlog_high_water_mark", "Largest subscriber backlog waiting for ParseData.", "topic=\"imu\"",
+        [imu_stats]() { return static_cast<double>(imu_stats->buffer_high_water_mark.load(std::memory_order_relaxed)); }
+    );
+    metrics_registry_.AddGauge(
+        prefix + "backlog_high_water_mark", "Largest subscriber backlog waiting for ParseData.", "topic=\"odom\"",
+        [odom_stats]() { return static_cast<double>(odom_stats->buffer_high_water_mark.load(std::memory_order_relaxed)); }
+    );
+
+    if (time_offset_estimator_ptr_) {
+        const TimeOffsetEstimator *time_offset_estimator = time_offset_estimator_ptr_.get();
+        metrics_registry_.AddGauge(
+            prefix + "imu_time_offset_seconds", "Estimated IMU stamp minus odometry stamp.", "",
+            [time_offset_estimator]() { return time_offset_estimator->GetOffset(); }
+        );
+        metrics_registry_.AddGauge(
+            prefix + "imu_time_offset_correlation", "Normalized angular rate correlation at the offset estimate.", "",
+            [time_offset_estimator]() { return time_offset_estimator->GetCorrelation(); }
+        );
+    }
+
+    if (health_monitor_ptr_) {
+        const std::string health_help("Numerical health check triggers.");
+        metrics_registry_.AddCounter(
+            prefix + "health_triggers_total", health_help, "check=\"non_finite_input\"",
+            &health_monitor_ptr_->GetNumNonFiniteInput()
+        );
+        metrics_registry_.AddCounter(
+            prefix + "health_triggers_total", health_help, "check=\"implausible_input\"",
+            &health_monitor_ptr_->GetNumImplausibleInput()
+        );
+        metrics_registry_.AddCounter(
+            prefix + "health_triggers_total", health_help, "check=\"non_finite_state\"",
+            &health_monitor_ptr_->GetNumNonFiniteState()
+        );
+        metrics_registry_.AddCounter(
+            prefix + "health_triggers_total", health_help, "check=\"orthonormality_drift\"",
+            &health_monitor_ptr_->GetNumOrthonormalityDrift()
+        );
+        metrics_registry_.AddCounter(
+            prefix + "reinitializations_total", "Recoveries from non-finite state.", "",
+            &health_monitor_ptr_->GetNumReinitializations()
+        );
+    }
+
+    if (flight_recorder_ptr_) {
+        metrics_registry_.AddCounter(
+            prefix + "flight_recorder_anomalies_total", "NaN, position jump and IMU gap detections.", "",
+            &flight_recorder_ptr_->GetNumTriggers()
+        );
+        metrics_registry_.AddCounter(
+            prefix + "flight_recorder_dumps_total", "Flight recorder dumps written.", "",
+            &flight_recorder_ptr_->GetNumDumps()
+        );
+    }
+
+    if (non_holonomic_constraint_ptr_) {
+        metrics_registry_.AddCounter(
+            prefix + "non_holonomic_updates_total", "Non-holonomic constraint updates applied.", "",
+            &non_holonomic_constraint_ptr_->GetNumUpdates()
+        );
+    }
+
+    if (magnetometer_heading_ptr_) {
+        metrics_registry_.AddCounter(
+            prefix + "magnetometer_updates_total", "Magnetometer heading updates applied.", "",
+            &magnetometer_heading_ptr_->GetNumUpdates()
+        );
+        metrics_registry_.AddCounter(
+            prefix + "magnetometer_rejected_total", "Magnetometer measurements rejected as disturbed or outlying.", "",
+            &magnetometer_heading_ptr_->GetNumRejected()
+        );
+        metrics_registry_.AddCounter(
+            prefix + "magnetic_model_evaluations_total", "Magnetic model evaluations on cache misses.", "",
+            &magnetometer_heading_ptr_->GetCache().GetNumEvaluations()
+        );
+        metrics_registry_.AddCounter(
+            prefix + "magnetic_model_cache_hits_total", "Magnetic model cache hits.", "",
+            &magnetometer_heading_ptr_->GetCache().GetNumHits()
+        );
+    }
+
+    if (window_optimizer_ptr_) {
+        metrics_registry_.AddCounter(
+            prefix + "window_keyframes_total", "Keyframes added to the sliding window.", "",
+            &window_optimizer_ptr_->GetNumKeyframes()
+        );
+        metrics_registry_.AddCounter(
+            prefix + "window_budget_overruns_total", "Window optimizations stopped early by the time budget.", "",
+            &window_optimizer_ptr_->GetNumBudgetOverruns()
+        );
+        metrics_registry_.AddHistogram(
+            prefix + "window_solve_seconds", "Wall time of sliding window optimization per keyframe.", "",
+            &window_optimizer_ptr_->GetSolveTime()
+        );
+    }
+
+    const std::string stage_help("Thread CPU time per estimator stage.");
+    metrics_registry_.AddHistogram(
+        prefix + "stage_cpu_seconds", stage_help, "stage=\"ParseData\"", &stage_cpu_time_.parse_data
+    );
+    metrics_registry_.AddHistogram(
+        prefix + "stage_cpu_seconds", stage_help, "stage=\"UpdatePose\"", &stage_cpu_time_.update_pose
+    );
+    metrics_registry_.AddHistogram(
+        prefix + "stage_cpu_seconds", stage_help, "stage=\"PublishPose\"", &stage_cpu_time_.publish_pose
+    );
+    metrics_registry_.AddHistogram(
+        prefix + "stage_cpu_seconds", stage_help, "stage=\"SaveTrajectoryTum\"", &stage_cpu_time_.save_trajectory
+    );
+    metrics_registry_.AddHistogram(
+        prefix + "publish_lag_seconds", "Delay from IMU measurement stamp to estimation publishing.", "",
+        &publish_lag_
+    );
+}
+
+} // namespace estimator
+
+} // namespace imu_integration
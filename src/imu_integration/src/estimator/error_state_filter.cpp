@@ -0,0 +1,129 @@
+/*
+ * @Description: error-state Kalman filter over IMU integration with position updates
+ * @Date: 2026-10-18 10:27:15
+ */
+#include "imu_integration/estimator/error_state_filter.hpp"
+
+#include "imu_integration/estimator/integration.hpp"
+#include "imu_integration/estimator/so3.hpp"
+
+namespace imu_integration {
+
+namespace estimator {
+
+void FilterState::Inject(const ErrorState &dx) {
+    t += dx.segment<3>(kIndexErrorPos);
+    v += dx.segment<3>(kIndexErrorVel);
+
+    R = Exp(dx.segment<3>(kIndexErrorOri)) * R;
+}
+
+ErrorState FilterState::Minus(const FilterState &other) const {
+    ErrorState dx;
+    dx.segment<3>(kIndexErrorPos) = t - other.t;
+    dx.segment<3>(kIndexErrorVel) = v - other.v;
+
+    dx.segment<3>(kIndexErrorOri) = Log(R * other.R.transpose());
+
+    return dx;
+}
+
+ErrorStateFilter::ErrorStateFilter(const Params &params)
+    : params_(params) {}
+
+void ErrorStateFilter::Init(const OdomData &odom_data, const IMUData &imu_data, const ErrorStateCovariance &P) {
+    state_.time = imu_data.time;
+    state_.R = odom_data.pose.block<3, 3>(0, 0);
+    state_.t = odom_data.pose.block<3, 1>(0, 3);
+    state_.v = odom_data.vel;
+    state_.P = P;
+
+    imu_data_ = imu_data;
+}
+
+void ErrorStateFilter::Predict(const IMUData &imu_data) {
+    FilterState state_pred;
+    ErrorStateCovariance F;
+    Propagate(params_, state_, imu_data_, imu_data, state_pred, F);
+
+    state_ = state_pred;
+    imu_data_ = imu_data;
+}
+
+void ErrorStateFilter::Correct(const Eigen::Vector3d &position) {
+    // H = [I 0 0]:
+    const Eigen::Matrix3d S = state_.P.block<3, 3>(kIndexErrorPos, kIndexErrorPos) + 
+        params_.position_stddev * params_.position_stddev * Eigen::Matrix3d::Identity();
+    const Eigen::Matrix<double, kErrorStateDim, 3> K = 
+        state_.P.block<kErrorStateDim, 3>(0, kIndexErrorPos) * S.inverse();
+
+    state_.Inject(K * (position - state_.t));
+
+    // Joseph form keeps P symmetric positive definite:
+    ErrorStateCovariance I_KH = ErrorStateCovariance::Identity();
+    I_KH.block<kErrorStateDim, 3>(0, kIndexErrorPos) -= K;
+    state_.P = I_KH * state_.P * I_KH.transpose() + 
+        params_.position_stddev * params_.position_stddev * K * K.transpose();
+}
+
+void ErrorStateFilter::Propagate(
+    const Params &params,
+    const FilterState &state, const IMUData &imu_data_prev, const IMUData &imu_data_curr,
+    FilterState &state_pred, ErrorStateCovariance &F
+) {
+    const double delta_t = imu_data_curr.time - imu_data_prev.time;
+
+    // a. nominal state, same kernels as the estimator:
+    state_pred.time = imu_data_curr.time;
+    state_pred.R = state.R;
+    UpdateOrientation(
+        GetAngularDelta(
+            IntegrationScheme::MIDPOINT, 
+            imu_data_curr.angular_velocity - params.angular_vel_bias, 
+            imu_data_prev.angular_velocity - params.angular_vel_bias, 
+            delta_t
+        ),
+        state_pred.R
+    );
+
+    const Eigen::Vector3d specific_force_prev = state.R * (imu_data_prev.linear_acceleration - params.linear_acc_bias);
+    const Eigen::Vector3d specific_force_curr = state_pred.R * (imu_data_curr.linear_acceleration - params.linear_acc_bias);
+    state_pred.t = state.t;
+    state_pred.v = state.v;
+    UpdatePosition(
+        delta_t,
+        GetVelocityDelta(
+            IntegrationScheme::MIDPOINT, 
+            specific_force_curr - params.gravity, specific_force_prev - params.gravity, 
+            delta_t
+        ),
+        state_pred.t, state_pred.v
+    );
+
+    // b. error state transition:
+    ErrorStateCovariance Q;
+    GetTransition(params, delta_t, 0.5 * (specific_force_prev + specific_force_curr), F, Q);
+
+    state_pred.P = F * state.P * F.transpose() + Q;
+}
+
+void ErrorStateFilter::GetTransition(
+    const Params &params, double delta_t, const Eigen::Vector3d &specific_force,
+    ErrorStateCovariance &F, ErrorStateCovariance &Q
+) {
+    // a. orientation error in navigation frame:
+    F = ErrorStateCovariance::Identity();
+    F.block<3, 3>(kIndexErrorPos, kIndexErrorVel) = delta_t * Eigen::Matrix3d::Identity();
+    F.block<3, 3>(kIndexErrorVel, kIndexErrorOri) = -delta_t * GetSkewSymmetric(specific_force);
+
+    // b. process noise from per measurement noise:
+    Q = ErrorStateCovariance::Zero();
+    Q.block<3, 3>(kIndexErrorVel, kIndexErrorVel) = 
+        std::pow(params.acc_noise_stddev * delta_t, 2) * Eigen::Matrix3d::Identity();
+    Q.block<3, 3>(kIndexErrorOri, kIndexErrorOri) = 
+        std::pow(params.gyro_noise_stddev * delta_t, 2) * Eigen::Matrix3d::Identity();
+}
+
+} // namespace estimator
+
+} // namespace imu_integration
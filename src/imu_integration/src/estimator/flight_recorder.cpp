@@ -0,0 +1,230 @@
+/*
+ * @Description: black-box recorder of raw measurements and estimator states
+ * @Date: 2026-10-18 10:23:46
+ */
+#include "imu_integration/estimator/flight_recorder.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+
+#include "glog/logging.h"
+
+namespace imu_integration {
+
+namespace estimator {
+
+namespace {
+
+FlightRecorder::PoseRecord GetPoseRecord(double time, const Eigen::Matrix4d &pose, const Eigen::Vector3d &vel) {
+    const Eigen::Quaterniond q(pose.block<3, 3>(0, 0));
+
+    FlightRecorder::PoseRecord record;
+    record.time = time;
+    record.position[0] = pose(0, 3);
+    record.position[1] = pose(1, 3);
+    record.position[2] = pose(2, 3);
+    record.orientation[0] = q.x();
+    record.orientation[1] = q.y();
+    record.orientation[2] = q.z();
+    record.orientation[3] = q.w();
+    record.velocity[0] = vel.x();
+    record.velocity[1] = vel.y();
+    record.velocity[2] = vel.z();
+
+    return record;
+}
+
+template <typename T>
+bool WriteRecords(FILE *file, const std::vector<T> &records, uint64_t num_records) {
+    return fwrite(records.data(), sizeof(T), num_records, file) == num_records;
+}
+
+} // namespace
+
+FlightRecorder::FlightRecorder(ros::NodeHandle &nh, const Params &params)
+    : params_(params),
+    nh_(nh),
+    imu_records_(static_cast<size_t>(std::ceil(params.duration * params.max_rate))),
+    odom_records_(static_cast<size_t>(std::ceil(params.duration * params.max_rate))),
+    state_records_(static_cast<size_t>(std::ceil(params.duration * params.max_rate))),
+    snapshot_imu_(static_cast<size_t>(std::ceil(params.duration * params.max_rate))),
+    snapshot_odom_(static_cast<size_t>(std::ceil(params.duration * params.max_rate))),
+    snapshot_state_(static_cast<size_t>(std::ceil(params.duration * params.max_rate)))
+{
+    service_ = nh_.advertiseService("dump_flight_recorder", &FlightRecorder::DumpCallback, this);
+    thread_ = std::thread(&FlightRecorder::Loop, this);
+}
+
+FlightRecorder::~FlightRecorder(void) {
+    running_ = false;
+    condition_.notify_one();
+    thread_.join();
+}
+
+void FlightRecorder::AddIMUData(const IMUData &imu_data) {
+    IMURecord record;
+    record.time = imu_data.time;
+    for (int i = 0; i < 3; ++i) {
+        record.angular_velocity[i] = imu_data.angular_velocity(i);
+        record.linear_acceleration[i] = imu_data.linear_acceleration(i);
+    }
+    imu_records_.Push(record);
+
+    if (prev_imu_time_ >= 0.0 && imu_data.time - prev_imu_time_ > params_.max_imu_gap) {
+        SetTrigger(Trigger::IMU_GAP, imu_data.time);
+    }
+    prev_imu_time_ = imu_data.time;
+    latest_time_ = std::max(latest_time_, imu_data.time);
+}
+
+void FlightRecorder::AddOdomData(const OdomData &odom_data) {
+    odom_records_.Push(GetPoseRecord(odom_data.time, odom_data.pose, odom_data.vel));
+}
+
+void FlightRecorder::AddState(double time, const Eigen::Matrix4d &pose, const Eigen::Vector3d &vel) {
+    state_records_.Push(GetPoseRecord(time, pose, vel));
+
+    const Eigen::Vector3d position = pose.block<3, 1>(0, 3);
+    if (!pose.allFinite() || !vel.allFinite()) {
+        SetTrigger(Trigger::NAN_STATE, time);
+    } else if (has_state_ && (position - prev_position_).norm() > params_.max_position_jump) {
+        SetTrigger(Trigger::POSITION_JUMP, time);
+    }
+    prev_position_ = position;
+    has_state_ = true;
+}
+
+bool FlightRecorder::Update(void) {
+    // triggers wait until the previous dump has been written:
+    if (dump_pending_.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    if (dump_requested_.exchange(false, std::memory_order_acquire)) {
+        trigger_ = Trigger::REQUEST;
+        trigger_time_ = latest_time_;
+    }
+
+    if (trigger_ == Trigger::NONE) {
+        return false;
+    }
+
+    const Trigger trigger = trigger_;
+    trigger_ = Trigger::NONE;
+
+    // explicit requests bypass the dump interval, persisting anomalies do not:
+    if (
+        trigger != Trigger::REQUEST &&
+        trigger_time_ - prev_dump_time_ < params_.min_dump_interval
+    ) {
+        return false;
+    }
+    prev_dump_time_ = trigger_time_;
+
+    // a. snapshot, the rings keep recording while the file is written:
+    const double start_time = latest_time_ - params_.duration;
+    memcpy(snapshot_header_.magic, "IMUFREC1", sizeof(snapshot_header_.magic));
+    snapshot_header_.version = 1;
+    snapshot_header_.trigger = static_cast<uint32_t>(trigger);
+    snapshot_header_.trigger_time = trigger_time_;
+    snapshot_header_.num_imu_records = imu_records_.Copy(start_time, snapshot_imu_);
+    snapshot_header_.num_odom_records = odom_records_.Copy(start_time, snapshot_odom_);
+    snapshot_header_.num_state_records = state_records_.Copy(start_time, snapshot_state_);
+
+    // b. hand over:
+    dump_pending_.store(true, std::memory_order_release);
+    condition_.notify_one();
+
+    return true;
+}
+
+bool FlightRecorder::DumpCallback(std_srvs::Trigger::Request &request, std_srvs::Trigger::Response &response) {
+    dump_requested_.store(true, std::memory_order_release);
+
+    response.success = true;
+    response.message = "flight recorder dump requested, written to " + params_.directory;
+
+    return true;
+}
+
+void FlightRecorder::SetTrigger(Trigger trigger, double time) {
+    num_triggers_.Add();
+
+    // first anomaly wins until it is handled:
+    if (trigger_ == Trigger::NONE) {
+        trigger_ = trigger;
+        trigger_time_ = time;
+    }
+}
+
+void FlightRecorder::Loop(void) {
+    while (running_) {
+        {
+            // the estimator thread never takes the lock, a missed notification only delays the dump:
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait_for(lock, std::chrono::milliseconds(200));
+        }
+
+        if (dump_pending_.load(std::memory_order_acquire)) {
+            WriteDump();
+            dump_pending_.store(false, std::memory_order_release);
+        }
+    }
+}
+
+void FlightRecorder::WriteDump(void) {
+    const Trigger trigger = static_cast<Trigger>(snapshot_header_.trigger);
+
+    std::ostringstream oss;
+    oss.precision(16);
+    oss << params_.directory << "/imu_integration_" << GetTriggerName(trigger)
+        << "_" << snapshot_header_.trigger_time << ".bin";
+    const std::string file_path = oss.str();
+
+    FILE *file = fopen(file_path.c_str(), "wb");
+    if (!file) {
+        LOG(WARNING) << "Failed to create flight recorder dump " << file_path;
+        return;
+    }
+
+    const bool success =
+        fwrite(&snapshot_header_, sizeof(snapshot_header_), 1, file) == 1 &&
+        WriteRecords(file, snapshot_imu_, snapshot_header_.num_imu_records) &&
+        WriteRecords(file, snapshot_odom_, snapshot_header_.num_odom_records) &&
+        WriteRecords(file, snapshot_state_, snapshot_header_.num_state_records);
+    fclose(file);
+
+    if (!success) {
+        LOG(WARNING) << "Failed to write flight recorder dump " << file_path;
+        return;
+    }
+
+    num_dumps_.Add();
+    LOG(WARNING) << "Flight recorder dump on " << GetTriggerName(trigger)
+                 << " at " << snapshot_header_.trigger_time << ": " << file_path << ", "
+                 << snapshot_header_.num_imu_records << " IMU measurements, "
+                 << snapshot_header_.num_odom_records << " odometry measurements, "
+                 << snapshot_header_.num_state_records << " states";
+}
+
+const char *FlightRecorder::GetTriggerName(Trigger trigger) {
+    switch (trigger) {
+        case Trigger::NAN_STATE:
+            return "nan";
+        case Trigger::POSITION_JUMP:
+            return "jump";
+        case Trigger::IMU_GAP:
+            return "gap";
+        case Trigger::REQUEST:
+            return "request";
+        default:
+            return "none";
+    }
+}
+
+} // namespace estimator
+
+} // namespace imu_integration
@@ -0,0 +1,129 @@
+/*
+ * @Description: stateless IMU integration as a ROS service
+ * @Date: 2026-10-18 14:08:52
+ */
+#include "imu_integration/estimator/integration_service.hpp"
+
+#include <cmath>
+
+#include "glog/logging.h"
+
+namespace imu_integration {
+
+namespace estimator {
+
+IntegrationService::IntegrationService(
+    ros::NodeHandle &nh,
+    const std::string &service_name
+) : nh_(nh) {
+    service_ = nh_.advertiseService(service_name, &IntegrationService::IntegrateCallback, this);
+}
+
+bool IntegrationService::IntegrateCallback(
+    IntegrateIMU::Request &request,
+    IntegrateIMU::Response &response
+) {
+    ScopedCPUTimer cpu_timer(call_cpu_time_);
+    num_calls_.Add();
+
+    BatchIntegrationParams params;
+    Eigen::Matrix4d init_pose;
+    Eigen::Vector3d init_vel;
+    if (!ParseRequest(request, params, init_pose, init_vel, response.message)) {
+        num_failures_.Add();
+        response.success = false;
+        return true;
+    }
+
+    const size_t num_samples = request.samples.size() / kPackedSampleSize;
+    if (request.return_states) {
+        response.states.resize(kPackedStateSize * num_samples);
+    }
+
+    Eigen::Matrix4d pose;
+    Eigen::Vector3d vel;
+    IntegratePacked(
+        params, 
+        num_samples, request.samples.data(), 
+        init_pose, init_vel,
+        pose, vel,
+        request.return_states ? response.states.data() : nullptr
+    );
+
+    // a. time:
+    response.final_time = request.samples[kPackedSampleSize * (num_samples - 1)];
+    // b. pose:
+    const Eigen::Quaterniond q(pose.block<3, 3>(0, 0));
+    response.final_pose.position.x = pose(0, 3);
+    response.final_pose.position.y = pose(1, 3);
+    response.final_pose.position.z = pose(2, 3);
+    response.final_pose.orientation.x = q.x();
+    response.final_pose.orientation.y = q.y();
+    response.final_pose.orientation.z = q.z();
+    response.final_pose.orientation.w = q.w();
+    // c. velocity:
+    response.final_velocity.x = vel.x();
+    response.final_velocity.y = vel.y();
+    response.final_velocity.z = vel.z();
+
+    response.success = true;
+
+    return true;
+}
+
+bool IntegrationService::ParseRequest(
+    const IntegrateIMU::Request &request, 
+    BatchIntegrationParams &params, Eigen::Matrix4d &init_pose, Eigen::Vector3d &init_vel,
+    std::string &message
+) {
+    // a. samples:
+    const size_t num_samples = request.samples.size() / kPackedSampleSize;
+    if (num_samples == 0 || request.samples.size() % kPackedSampleSize != 0) {
+        message = "samples must hold N > 0 rows of time, angular velocity and linear acceleration";
+        return false;
+    }
+    for (size_t i = 1; i < num_samples; ++i) {
+        if (!(request.samples[kPackedSampleSize * i] >= request.samples[kPackedSampleSize * (i - 1)])) {
+            message = "sample stamps must be non-decreasing";
+            return false;
+        }
+    }
+
+    // b. params:
+    if (request.scheme > 1) {
+        message = "scheme must be 0, midpoint, or 1, euler";
+        return false;
+    }
+    params.scheme = (request.scheme == 1) ? IntegrationScheme::EULER : IntegrationScheme::MIDPOINT;
+    params.gravity = Eigen::Vector3d(request.gravity.x, request.gravity.y, request.gravity.z);
+    params.angular_vel_bias = Eigen::Vector3d(
+        request.angular_velocity_bias.x, request.angular_velocity_bias.y, request.angular_velocity_bias.z
+    );
+    params.linear_acc_bias = Eigen::Vector3d(
+        request.linear_acceleration_bias.x, request.linear_acceleration_bias.y, request.linear_acceleration_bias.z
+    );
+
+    // c. initial state:
+    Eigen::Quaterniond q(
+        request.initial_pose.orientation.w, 
+        request.initial_pose.orientation.x, 
+        request.initial_pose.orientation.y, 
+        request.initial_pose.orientation.z
+    );
+    if (!(q.norm() > 0.0)) {
+        message = "initial orientation must be a non-zero quaternion";
+        return false;
+    }
+    init_pose = Eigen::Matrix4d::Identity();
+    init_pose.block<3, 3>(0, 0) = q.normalized().toRotationMatrix();
+    init_pose.block<3, 1>(0, 3) = Eigen::Vector3d(
+        request.initial_pose.position.x, request.initial_pose.position.y, request.initial_pose.position.z
+    );
+    init_vel = Eigen::Vector3d(request.initial_velocity.x, request.initial_velocity.y, request.initial_velocity.z);
+
+    return true;
+}
+
+} // namespace estimator
+
+} // namespace imu_integration
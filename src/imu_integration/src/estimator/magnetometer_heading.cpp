@@ -0,0 +1,104 @@
+/*
+ * @Description: magnetometer heading aiding against the World Magnetic Model
+ * @Date: 2026-10-18 15:20:37
+ */
+#include "imu_integration/estimator/magnetometer_heading.hpp"
+
+#include <cmath>
+
+namespace imu_integration {
+
+namespace estimator {
+
+MagnetometerHeading::MagnetometerHeading(const Params &params)
+    : params_(params), field_(params.field) {
+    Init();
+}
+
+void MagnetometerHeading::Init(void) {
+    P_ = params_.initial_yaw_stddev * params_.initial_yaw_stddev;
+}
+
+void MagnetometerHeading::Predict(double delta_t) {
+    P_ += std::pow(params_.gyro_noise_stddev * delta_t, 2);
+}
+
+bool MagnetometerHeading::Correct(const MagnetometerData &magnetometer_data, Eigen::Matrix4d &pose) {
+    double innovation, variance;
+    if (!GetInnovation(magnetometer_data, pose, innovation, variance)) {
+        return false;
+    }
+
+    // scalar innovation variance:
+    const double S = P_ + variance;
+    if (innovation * innovation > params_.max_innovation * params_.max_innovation * S) {
+        num_rejected_.Add();
+        return false;
+    }
+
+    const double K = P_ / S;
+    pose.block<3, 3>(0, 0) = Eigen::AngleAxisd(K * innovation, Eigen::Vector3d::UnitZ()).toRotationMatrix() * pose.block<3, 3>(0, 0);
+
+    P_ *= 1.0 - K;
+
+    num_updates_.Add();
+
+    return true;
+}
+
+bool MagnetometerHeading::Correct(
+    const MagnetometerData &magnetometer_data, NonHolonomicConstraint &constraint,
+    Eigen::Matrix4d &pose, Eigen::Vector3d &vel
+) {
+    double innovation, variance;
+    if (!GetInnovation(magnetometer_data, pose, innovation, variance)) {
+        return false;
+    }
+
+    if (!constraint.CorrectHeading(innovation, variance, params_.max_innovation, pose, vel)) {
+        num_rejected_.Add();
+        return false;
+    }
+
+    num_updates_.Add();
+
+    return true;
+}
+
+bool MagnetometerHeading::GetInnovation(
+    const MagnetometerData &magnetometer_data, const Eigen::Matrix4d &pose,
+    double &innovation, double &variance
+) {
+    const Eigen::Matrix3d R = pose.block<3, 3>(0, 0);
+
+    const Eigen::Vector3d field = field_.GetField(pose.block<3, 1>(0, 3), magnetometer_data.time);
+    const Eigen::Vector3d field_measured = R * magnetometer_data.magnetic_field;
+
+    // local disturbances show up in magnitude first:
+    const double field_norm = field.norm();
+    if (std::fabs(field_measured.norm() - field_norm) > params_.max_field_error * field_norm) {
+        num_rejected_.Add();
+        return false;
+    }
+
+    // heading is undefined near the magnetic poles:
+    const double horizontal_norm = field.head<2>().norm();
+    if (horizontal_norm < params_.max_field_error * field_norm) {
+        num_rejected_.Add();
+        return false;
+    }
+
+    // rotation about navigation z taking measured horizontal field onto model's:
+    innovation = std::atan2(
+        field_measured.x() * field.y() - field_measured.y() * field.x(),
+        field_measured.x() * field.x() + field_measured.y() * field.y()
+    );
+    // noise projected onto the horizontal direction:
+    variance = std::pow(params_.stddev / horizontal_norm, 2);
+
+    return true;
+}
+
+} // namespace estimator
+
+} // namespace imu_integration
@@ -1,6 +1,7 @@
 #include <fstream>
 
 #include <ros/ros.h>
+#include <ros/callback_queue.h>
 #include <rosbag/bag.h>
 
 #include "imu_integration/estimator/activity.hpp"
@@ -13,16 +14,24 @@ int main(int argc, char** argv) {
 
     activity.Init();
     
-    // 100 Hz:
+    // 100 Hz, or as soon as measurements arrive on simulated clock:
     ros::Rate loop_rate(100);
     while (ros::ok())
     {
-        ros::spinOnce();
+        if (activity.IsOnSimClock()) {
+            ros::getGlobalCallbackQueue()->callAvailable(ros::WallDuration(0.001));
+        } else {
+            ros::spinOnce();
+        }
 
         activity.Run();
 
-        loop_rate.sleep();
+        if (!activity.IsOnSimClock()) {
+            loop_rate.sleep();
+        }
     } 
 
+    activity.Report();
+
     return EXIT_SUCCESS;
 }
\ No newline at end of file
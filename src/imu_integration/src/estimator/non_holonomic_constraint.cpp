@@ -0,0 +1,114 @@
+/*
+ * @Description: non-holonomic constraint pseudo-measurements for ground vehicles
+ * @Date: 2026-10-18 14:06:52
+ */
+#include "imu_integration/estimator/non_holonomic_constraint.hpp"
+
+#include <cmath>
+
+#include "imu_integration/estimator/so3.hpp"
+
+namespace imu_integration {
+
+namespace estimator {
+
+NonHolonomicConstraint::NonHolonomicConstraint(const Params &params)
+    : params_(params) {}
+
+void NonHolonomicConstraint::Init(double time) {
+    // position is taken from ground truth as is:
+    P_ = ErrorStateCovariance::Zero();
+    P_.block<3, 3>(kIndexErrorVel, kIndexErrorVel) =
+        std::pow(params_.initial_vel_stddev, 2) * Eigen::Matrix3d::Identity();
+    P_.block<3, 3>(kIndexErrorOri, kIndexErrorOri) =
+        std::pow(params_.initial_ori_stddev, 2) * Eigen::Matrix3d::Identity();
+
+    prev_update_time_ = time;
+}
+
+void NonHolonomicConstraint::Predict(double delta_t, const Eigen::Vector3d &specific_force) {
+    ErrorStateCovariance F, Q;
+    ErrorStateFilter::GetTransition(params_.filter, delta_t, specific_force, F, Q);
+
+    P_ = F * P_ * F.transpose() + Q;
+}
+
+bool NonHolonomicConstraint::Correct(double time, Eigen::Matrix4d &pose, Eigen::Vector3d &vel) {
+    if (time - prev_update_time_ < params_.period) {
+        return false;
+    }
+    prev_update_time_ = time;
+
+    Eigen::Matrix3d R = pose.block<3, 3>(0, 0);
+    Eigen::Vector3d t = pose.block<3, 1>(0, 3);
+
+    // sequential updates, each one linearized at the state corrected by the previous:
+    CorrectAxis(params_.R_imu_body.col(1), params_.lateral_stddev, R, t, vel);
+    CorrectAxis(params_.R_imu_body.col(2), params_.vertical_stddev, R, t, vel);
+
+    pose.block<3, 3>(0, 0) = R;
+    pose.block<3, 1>(0, 3) = t;
+
+    num_updates_.Add();
+
+    return true;
+}
+
+void NonHolonomicConstraint::CorrectAxis(
+    const Eigen::Vector3d &axis, double stddev,
+    Eigen::Matrix3d &R, Eigen::Vector3d &t, Eigen::Vector3d &v
+) {
+    // h = axis' * R' * v, orientation error applied on the left:
+    const Eigen::Vector3d axis_nav = R * axis;
+    Eigen::Matrix<double, 1, kErrorStateDim> H = Eigen::Matrix<double, 1, kErrorStateDim>::Zero();
+    H.segment<3>(kIndexErrorVel) = axis_nav.transpose();
+    H.segment<3>(kIndexErrorOri) = axis_nav.transpose() * GetSkewSymmetric(v);
+
+    // scalar innovation variance:
+    const double S = H * P_ * H.transpose() + stddev * stddev;
+
+    Update(H, -axis_nav.dot(v), S, R, t, v);
+}
+
+bool NonHolonomicConstraint::CorrectHeading(
+    double innovation, double variance, double max_innovation,
+    Eigen::Matrix4d &pose, Eigen::Vector3d &vel
+) {
+    // heading error is the navigation z component of the left orientation error:
+    Eigen::Matrix<double, 1, kErrorStateDim> H = Eigen::Matrix<double, 1, kErrorStateDim>::Zero();
+    H(kIndexErrorOri + 2) = 1.0;
+
+    const double S = P_(kIndexErrorOri + 2, kIndexErrorOri + 2) + variance;
+    if (innovation * innovation > max_innovation * max_innovation * S) {
+        return false;
+    }
+
+    Eigen::Matrix3d R = pose.block<3, 3>(0, 0);
+    Eigen::Vector3d t = pose.block<3, 1>(0, 3);
+
+    Update(H, innovation, S, R, t, vel);
+
+    pose.block<3, 3>(0, 0) = R;
+    pose.block<3, 1>(0, 3) = t;
+
+    return true;
+}
+
+void NonHolonomicConstraint::Update(
+    const Eigen::Matrix<double, 1, kErrorStateDim> &H, double residual, double S,
+    Eigen::Matrix3d &R, Eigen::Vector3d &t, Eigen::Vector3d &v
+) {
+    const ErrorState K = P_ * H.transpose() / S;
+
+    const ErrorState dx = K * residual;
+    t += dx.segment<3>(kIndexErrorPos);
+    v += dx.segment<3>(kIndexErrorVel);
+    R = Exp(dx.segment<3>(kIndexErrorOri)) * R;
+
+    // Joseph form reduces to a symmetric rank-one downdate for optimal scalar gain:
+    P_ -= S * K * K.transpose();
+}
+
+} // namespace estimator
+
+} // namespace imu_integration
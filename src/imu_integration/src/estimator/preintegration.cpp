@@ -0,0 +1,69 @@
+/*
+ * @Description: IMU preintegration between keyframes
+ * @Date: 2026-10-18 10:02:31
+ */
+#include "imu_integration/estimator/preintegration.hpp"
+
+#include "imu_integration/estimator/integration.hpp"
+#include "imu_integration/estimator/so3.hpp"
+
+namespace imu_integration {
+
+namespace estimator {
+
+IMUPreintegration::IMUPreintegration(const Params &params, const IMUData &imu_data)
+    : params_(params), imu_data_(imu_data) {}
+
+void IMUPreintegration::Integrate(const IMUData &imu_data) {
+    const double delta_t = imu_data.time - imu_data_.time;
+    if (delta_t <= 0.0) {
+        return;
+    }
+
+    // a. increments:
+    const Eigen::Vector3d angular_delta = GetAngularDelta(
+        IntegrationScheme::MIDPOINT, 
+        imu_data.angular_velocity - params_.angular_vel_bias, 
+        imu_data_.angular_velocity - params_.angular_vel_bias, 
+        delta_t
+    );
+    Eigen::Matrix3d delta_R_curr = delta_R_;
+    UpdateOrientation(angular_delta, delta_R_curr);
+
+    const Eigen::Vector3d linear_acc_prev = imu_data_.linear_acceleration - params_.linear_acc_bias;
+    const Eigen::Vector3d linear_acc_curr = imu_data.linear_acceleration - params_.linear_acc_bias;
+    const Eigen::Vector3d linear_acc_mid = 0.5 * (delta_R_ * linear_acc_prev + delta_R_curr * linear_acc_curr);
+
+    // b. covariance, orientation error applied on the right:
+    ErrorStateCovariance A = ErrorStateCovariance::Identity();
+    A.block<3, 3>(kIndexErrorPos, kIndexErrorVel) = delta_t * Eigen::Matrix3d::Identity();
+    A.block<3, 3>(kIndexErrorPos, kIndexErrorOri) = -0.5 * delta_t * delta_t * GetSkewSymmetric(linear_acc_mid) * delta_R_;
+    A.block<3, 3>(kIndexErrorVel, kIndexErrorOri) = -delta_t * GetSkewSymmetric(linear_acc_mid) * delta_R_;
+    A.block<3, 3>(kIndexErrorOri, kIndexErrorOri) = Exp(angular_delta).transpose();
+
+    Eigen::Matrix<double, kErrorStateDim, 6> B = Eigen::Matrix<double, kErrorStateDim, 6>::Zero();
+    B.block<3, 3>(kIndexErrorPos, 0) = 0.5 * delta_t * delta_t * delta_R_;
+    B.block<3, 3>(kIndexErrorVel, 0) = delta_t * delta_R_;
+    B.block<3, 3>(kIndexErrorOri, 3) = delta_t * Eigen::Matrix3d::Identity();
+
+    Eigen::Matrix<double, 6, 6> Q = Eigen::Matrix<double, 6, 6>::Zero();
+    Q.block<3, 3>(0, 0) = params_.acc_noise_stddev * params_.acc_noise_stddev * Eigen::Matrix3d::Identity();
+    Q.block<3, 3>(3, 3) = params_.gyro_noise_stddev * params_.gyro_noise_stddev * Eigen::Matrix3d::Identity();
+
+    covariance_ = A * covariance_ * A.transpose() + B * Q * B.transpose();
+
+    // c. relative motion:
+    UpdatePosition(
+        delta_t, 
+        GetVelocityDelta(IntegrationScheme::MIDPOINT, delta_R_curr * linear_acc_curr, delta_R_ * linear_acc_prev, delta_t),
+        delta_p_, delta_v_
+    );
+    delta_R_ = delta_R_curr;
+    delta_t_ += delta_t;
+
+    imu_data_ = imu_data;
+}
+
+} // namespace estimator
+
+} // namespace imu_integration
@@ -0,0 +1,214 @@
+/*
+ * @Description: out-of-core Rauch-Tung-Striebel smoother over error-state filter output
+ * @Date: 2026-10-18 15:52:40
+ */
+#include "imu_integration/estimator/rts_smoother.hpp"
+
+#include <sys/types.h>
+
+#include <algorithm>
+
+#include "glog/logging.h"
+
+namespace imu_integration {
+
+namespace estimator {
+
+RTSSmoother::RTSSmoother(const ErrorStateFilter::Params &params, const std::string &spill_path, size_t block_size)
+    : params_(params), spill_path_(spill_path), block_size_(block_size) {
+    block_.reserve(block_size_);
+}
+
+RTSSmoother::~RTSSmoother(void) {
+    if (filtered_file_) {
+        fclose(filtered_file_);
+        std::remove((spill_path_ + ".filtered").c_str());
+    }
+    if (smoothed_file_) {
+        fclose(smoothed_file_);
+        std::remove((spill_path_ + ".smoothed").c_str());
+    }
+}
+
+bool RTSSmoother::Open(void) {
+    filtered_file_ = fopen((spill_path_ + ".filtered").c_str(), "w+b");
+    smoothed_file_ = fopen((spill_path_ + ".smoothed").c_str(), "w+b");
+    if (!filtered_file_ || !smoothed_file_) {
+        LOG(WARNING) << "Failed to create smoother spill files: " << spill_path_;
+        return false;
+    }
+
+    return true;
+}
+
+bool RTSSmoother::Add(const FilterState &state, const IMUData &imu_data) {
+    Record record;
+    Pack(state, imu_data, record);
+    block_.push_back(record);
+    ++num_states_;
+
+    if (block_.size() == block_size_) {
+        return FlushBlock();
+    }
+
+    return true;
+}
+
+bool RTSSmoother::Smooth(const std::function<void(const FilterState &)> &callback) {
+    if (num_states_ == 0 || !FlushBlock()) {
+        return false;
+    }
+
+    const size_t num_blocks = (num_states_ + block_size_ - 1) / block_size_;
+
+    // a. backward pass, blocks in reverse order:
+    std::vector<Record> filtered, smoothed;
+    FilterState state_next_smoothed, state_pred;
+    IMUData imu_data_next;
+    ErrorStateCovariance F;
+    bool has_next = false;
+
+    for (size_t b = num_blocks; b-- > 0;) {
+        if (!ReadBlock(filtered_file_, b, filtered)) {
+            return false;
+        }
+        smoothed.resize(filtered.size());
+
+        for (size_t i = filtered.size(); i-- > 0;) {
+            FilterState state;
+            IMUData imu_data;
+            Unpack(filtered[i], state, imu_data);
+
+            FilterState state_smoothed = state;
+            if (has_next) {
+                // prediction of the forward pass re-derived from stored IMU measurements:
+                ErrorStateFilter::Propagate(params_, state, imu_data, imu_data_next, state_pred, F);
+
+                // G = P F^T P_pred^-1:
+                const ErrorStateCovariance G = 
+                    state_pred.P.ldlt().solve(F * state.P).transpose();
+
+                state_smoothed.Inject(G * state_next_smoothed.Minus(state_pred));
+                state_smoothed.P = state.P + G * (state_next_smoothed.P - state_pred.P) * G.transpose();
+            }
+
+            Pack(state_smoothed, imu_data, smoothed[i]);
+
+            state_next_smoothed = state_smoothed;
+            imu_data_next = imu_data;
+            has_next = true;
+        }
+
+        if (!WriteBlock(smoothed_file_, b, smoothed)) {
+            return false;
+        }
+    }
+
+    // b. stream smoothed states in time order:
+    FilterState state;
+    IMUData imu_data;
+    for (size_t b = 0; b < num_blocks; ++b) {
+        if (!ReadBlock(smoothed_file_, b, smoothed)) {
+            return false;
+        }
+        for (const Record &record: smoothed) {
+            Unpack(record, state, imu_data);
+            callback(state);
+        }
+    }
+
+    return true;
+}
+
+void RTSSmoother::Pack(const FilterState &state, const IMUData &imu_data, Record &record) {
+    record.time = state.time;
+
+    const Eigen::Quaterniond q(state.R);
+    record.q[0] = q.w();
+    record.q[1] = q.x();
+    record.q[2] = q.y();
+    record.q[3] = q.z();
+
+    for (int i = 0; i < 3; ++i) {
+        record.t[i] = state.t(i);
+        record.v[i] = state.v(i);
+        record.linear_acceleration[i] = imu_data.linear_acceleration(i);
+        record.angular_velocity[i] = imu_data.angular_velocity(i);
+    }
+
+    int index = 0;
+    for (int i = 0; i < kErrorStateDim; ++i) {
+        for (int j = i; j < kErrorStateDim; ++j) {
+            record.P[index++] = state.P(i, j);
+        }
+    }
+
+    record.imu_time = imu_data.time;
+}
+
+void RTSSmoother::Unpack(const Record &record, FilterState &state, IMUData &imu_data) {
+    state.time = record.time;
+    state.R = Eigen::Quaterniond(record.q[0], record.q[1], record.q[2], record.q[3]).normalized().toRotationMatrix();
+
+    for (int i = 0; i < 3; ++i) {
+        state.t(i) = record.t[i];
+        state.v(i) = record.v[i];
+        imu_data.linear_acceleration(i) = record.linear_acceleration[i];
+        imu_data.angular_velocity(i) = record.angular_velocity[i];
+    }
+
+    int index = 0;
+    for (int i = 0; i < kErrorStateDim; ++i) {
+        for (int j = i; j < kErrorStateDim; ++j) {
+            state.P(i, j) = state.P(j, i) = record.P[index++];
+        }
+    }
+
+    imu_data.time = record.imu_time;
+}
+
+bool RTSSmoother::FlushBlock(void) {
+    if (block_.empty()) {
+        return true;
+    }
+
+    // blocks are appended in order during the forward pass:
+    const size_t index = (num_states_ - 1) / block_size_;
+    if (!WriteBlock(filtered_file_, index, block_)) {
+        return false;
+    }
+    block_.clear();
+
+    return true;
+}
+
+bool RTSSmoother::ReadBlock(FILE *file, size_t index, std::vector<Record> &block) {
+    const size_t size = std::min(block_size_, num_states_ - index * block_size_);
+    block.resize(size);
+
+    if (
+        fseeko(file, static_cast<off_t>(index * block_size_ * sizeof(Record)), SEEK_SET) != 0 ||
+        fread(block.data(), sizeof(Record), size, file) != size
+    ) {
+        LOG(WARNING) << "Failed to read smoother block " << index << " from " << spill_path_;
+        return false;
+    }
+
+    return true;
+}
+
+bool RTSSmoother::WriteBlock(FILE *file, size_t index, const std::vector<Record> &block) {
+    if (
+        fseeko(file, static_cast<off_t>(index * block_size_ * sizeof(Record)), SEEK_SET) != 0 ||
+        fwrite(block.data(), sizeof(Record), block.size(), file) != block.size()
+    ) {
+        LOG(WARNING) << "Failed to write smoother block " << index << " to " << spill_path_;
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace estimator
+
+} // namespace imu_integration
@@ -0,0 +1,356 @@
+/*
+ * @Description: fixed-lag smoother over keyframes linked by IMU preintegration and pose factors
+ * @Date: 2026-10-18 14:36:08
+ */
+#include "imu_integration/estimator/sliding_window_optimizer.hpp"
+
+#include <chrono>
+
+#include "imu_integration/estimator/so3.hpp"
+
+namespace imu_integration {
+
+namespace estimator {
+
+namespace {
+
+// keeps the system well posed before the first prior exists:
+const double kDamping = 1.0e-9;
+const double kConvergenceThreshold = 1.0e-8;
+// keeps preintegration covariance invertible over intervals of a single short step:
+const double kMinCovariance = 1.0e-15;
+
+} // namespace
+
+SlidingWindowOptimizer::SlidingWindowOptimizer(const Params &params)
+    : params_(params) {}
+
+void SlidingWindowOptimizer::AddIMUData(const IMUData &imu_data) {
+    imu_data_buff_.push_back(imu_data);
+}
+
+void SlidingWindowOptimizer::AddPose(const OdomData &odom_data) {
+    pose_buff_.push_back(odom_data);
+}
+
+bool SlidingWindowOptimizer::Update(void) {
+    bool updated = false;
+
+    while (!pose_buff_.empty()) {
+        const OdomData odom_data = pose_buff_.front();
+
+        // a. at most one keyframe per period:
+        if (!keyframes_.empty() && odom_data.time < keyframes_.back().time + params_.keyframe_period) {
+            pose_buff_.pop_front();
+            continue;
+        }
+
+        // b. wait until IMU measurements bracket the pose, with one strictly after it to interpolate towards:
+        if (imu_data_buff_.empty() || imu_data_buff_.back().time <= odom_data.time) {
+            break;
+        }
+
+        if (keyframes_.empty()) {
+            // first keyframe, only the measurement right before it is needed:
+            while (imu_data_buff_.size() > 1 && imu_data_buff_.at(1).time <= odom_data.time) {
+                imu_data_buff_.pop_front();
+            }
+            if (imu_data_buff_.front().time > odom_data.time) {
+                pose_buff_.pop_front();
+                continue;
+            }
+            imu_data_ = imu_data_buff_.front();
+            imu_data_buff_.pop_front();
+        } else {
+            // integrate measurements up to the pose:
+            while (imu_data_buff_.front().time <= odom_data.time) {
+                preintegration_.Integrate(imu_data_buff_.front());
+                imu_data_ = imu_data_buff_.front();
+                imu_data_buff_.pop_front();
+            }
+        }
+
+        // c. keyframe at the pose stamp, preintegration restarts there:
+        const IMUData imu_data = IMUData::Interpolate(imu_data_, imu_data_buff_.front(), odom_data.time);
+        if (!keyframes_.empty()) {
+            preintegration_.Integrate(imu_data);
+        }
+        imu_data_ = imu_data;
+
+        AddKeyframe(odom_data);
+        pose_buff_.pop_front();
+
+        preintegration_ = IMUPreintegration(params_.preintegration, imu_data_);
+        updated = true;
+    }
+
+    return updated;
+}
+
+void SlidingWindowOptimizer::AddKeyframe(const OdomData &odom_data) {
+    Keyframe keyframe;
+    keyframe.time = odom_data.time;
+    keyframe.R_meas = odom_data.pose.block<3, 3>(0, 0);
+    keyframe.t_meas = odom_data.pose.block<3, 1>(0, 3);
+
+    if (keyframes_.empty()) {
+        keyframe.R = keyframe.R_meas;
+        keyframe.t = keyframe.t_meas;
+        keyframe.v = odom_data.vel;
+        keyframes_.push_back(keyframe);
+        num_keyframes_.Add();
+        return;
+    }
+
+    // initial guess from preintegration:
+    const Keyframe &keyframe_i = keyframes_.back();
+    const double delta_t = preintegration_.GetDeltaTime();
+    keyframe.R = keyframe_i.R * preintegration_.GetDeltaR();
+    keyframe.v = keyframe_i.v - params_.gravity * delta_t + keyframe_i.R * preintegration_.GetDeltaV();
+    keyframe.t = keyframe_i.t + keyframe_i.v * delta_t - 0.5 * params_.gravity * delta_t * delta_t + 
+        keyframe_i.R * preintegration_.GetDeltaP();
+
+    keyframes_.push_back(keyframe);
+    preintegrations_.push_back(preintegration_);
+    num_keyframes_.Add();
+
+    Optimize();
+
+    if (static_cast<int>(keyframes_.size()) > params_.window_size) {
+        Marginalize();
+    }
+}
+
+void SlidingWindowOptimizer::Optimize(void) {
+    const auto start_time = std::chrono::steady_clock::now();
+    const auto time_budget = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(params_.time_budget)
+    );
+
+    std::vector<Block, Eigen::aligned_allocator<Block>> D, U;
+    std::vector<Vector, Eigen::aligned_allocator<Vector>> g, dx;
+
+    auto iteration_start_time = start_time;
+    for (int i = 0; i < params_.max_iterations; ++i) {
+        Linearize(D, U, g);
+        Solve(D, U, g, dx);
+
+        // right perturbation of orientation:
+        double dx_norm = 0.0;
+        for (size_t k = 0; k < keyframes_.size(); ++k) {
+            Keyframe &keyframe = keyframes_.at(k);
+            keyframe.t += dx.at(k).segment<3>(kIndexErrorPos);
+            keyframe.v += dx.at(k).segment<3>(kIndexErrorVel);
+            keyframe.R = keyframe.R * Exp(dx.at(k).segment<3>(kIndexErrorOri));
+            dx_norm += dx.at(k).squaredNorm();
+        }
+
+        if (dx_norm < kConvergenceThreshold) {
+            break;
+        }
+
+        // stop if another iteration of the same cost would exceed the budget:
+        const auto time = std::chrono::steady_clock::now();
+        if (
+            i + 1 < params_.max_iterations && 
+            (time - start_time) + (time - iteration_start_time) > time_budget
+        ) {
+            num_budget_overruns_.Add();
+            break;
+        }
+        iteration_start_time = time;
+    }
+
+    solve_time_.Record(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_time).count()
+    );
+}
+
+double SlidingWindowOptimizer::Linearize(
+    std::vector<Block, Eigen::aligned_allocator<Block>> &D,
+    std::vector<Block, Eigen::aligned_allocator<Block>> &U,
+    std::vector<Vector, Eigen::aligned_allocator<Vector>> &g
+) const {
+    const size_t K = keyframes_.size();
+    D.assign(K, kDamping * Block::Identity());
+    U.assign(K > 0 ? K - 1 : 0, Block::Zero());
+    g.assign(K, Vector::Zero());
+
+    double cost = 0.0;
+    Block H, H_ii, H_ij, H_jj;
+    Vector b, b_i, b_j;
+
+    // a. marginalization prior:
+    if (has_prior_) {
+        cost += LinearizePrior(keyframes_.front(), H, b);
+        D.at(0) += H;
+        g.at(0) += b;
+    }
+
+    // b. pose factors:
+    for (size_t k = 0; k < K; ++k) {
+        cost += LinearizePoseFactor(keyframes_.at(k), H, b);
+        D.at(k) += H;
+        g.at(k) += b;
+    }
+
+    // c. IMU factors between consecutive keyframes:
+    for (size_t k = 0; k + 1 < K; ++k) {
+        cost += LinearizeIMUFactor(
+            keyframes_.at(k), keyframes_.at(k + 1), preintegrations_.at(k), 
+            H_ii, H_ij, H_jj, b_i, b_j
+        );
+        D.at(k) += H_ii;
+        D.at(k + 1) += H_jj;
+        U.at(k) += H_ij;
+        g.at(k) += b_i;
+        g.at(k + 1) += b_j;
+    }
+
+    return cost;
+}
+
+void SlidingWindowOptimizer::Solve(
+    std::vector<Block, Eigen::aligned_allocator<Block>> &D,
+    const std::vector<Block, Eigen::aligned_allocator<Block>> &U,
+    const std::vector<Vector, Eigen::aligned_allocator<Vector>> &g,
+    std::vector<Vector, Eigen::aligned_allocator<Vector>> &dx
+) {
+    const size_t K = D.size();
+    dx.assign(K, Vector::Zero());
+    if (K == 0) {
+        return;
+    }
+
+    // a. forward elimination, D[k] becomes the Schur complement of keyframes before k:
+    std::vector<Vector, Eigen::aligned_allocator<Vector>> y(K);
+    std::vector<Eigen::LDLT<Block>, Eigen::aligned_allocator<Eigen::LDLT<Block>>> S(K);
+    y.at(0) = -g.at(0);
+    S.at(0).compute(D.at(0));
+    for (size_t k = 1; k < K; ++k) {
+        const Block L = S.at(k - 1).solve(U.at(k - 1)).transpose();
+        D.at(k) -= L * U.at(k - 1);
+        y.at(k) = -g.at(k) - L * y.at(k - 1);
+        S.at(k).compute(D.at(k));
+    }
+
+    // b. back substitution:
+    dx.at(K - 1) = S.at(K - 1).solve(y.at(K - 1));
+    for (size_t k = K - 1; k-- > 0;) {
+        dx.at(k) = S.at(k).solve(y.at(k) - U.at(k) * dx.at(k + 1));
+    }
+}
+
+void SlidingWindowOptimizer::Marginalize(void) {
+    // a. factors connected to the oldest keyframe:
+    Block H_00 = Block::Zero(), H_01, H_11, H;
+    Vector b_0 = Vector::Zero(), b_1, b;
+
+    if (has_prior_) {
+        LinearizePrior(keyframes_.at(0), H, b);
+        H_00 += H;
+        b_0 += b;
+    }
+
+    LinearizePoseFactor(keyframes_.at(0), H, b);
+    H_00 += H;
+    b_0 += b;
+
+    Block H_ii;
+    Vector b_i;
+    LinearizeIMUFactor(keyframes_.at(0), keyframes_.at(1), preintegrations_.at(0), H_ii, H_01, H_11, b_i, b_1);
+    H_00 += H_ii;
+    b_0 += b_i;
+
+    // b. Schur complement onto the next keyframe:
+    const Eigen::LDLT<Block> H_00_ldlt(H_00 + kDamping * Block::Identity());
+    prior_H_ = H_11 - H_01.transpose() * H_00_ldlt.solve(H_01);
+    prior_H_ = 0.5 * (prior_H_ + prior_H_.transpose());
+    prior_b_ = b_1 - H_01.transpose() * H_00_ldlt.solve(b_0);
+    prior_keyframe_ = keyframes_.at(1);
+    has_prior_ = true;
+
+    keyframes_.pop_front();
+    preintegrations_.pop_front();
+}
+
+double SlidingWindowOptimizer::LinearizeIMUFactor(
+    const Keyframe &keyframe_i, const Keyframe &keyframe_j, const IMUPreintegration &preintegration,
+    Block &H_ii, Block &H_ij, Block &H_jj, Vector &b_i, Vector &b_j
+) const {
+    const double delta_t = preintegration.GetDeltaTime();
+    const Eigen::Matrix3d R_i_t = keyframe_i.R.transpose();
+
+    // a. residual, ordered as error state:
+    const Eigen::Vector3d delta_p = R_i_t * (
+        keyframe_j.t - keyframe_i.t - keyframe_i.v * delta_t + 0.5 * params_.gravity * delta_t * delta_t
+    );
+    const Eigen::Vector3d delta_v = R_i_t * (keyframe_j.v - keyframe_i.v + params_.gravity * delta_t);
+
+    Vector r;
+    r.segment<3>(kIndexErrorPos) = delta_p - preintegration.GetDeltaP();
+    r.segment<3>(kIndexErrorVel) = delta_v - preintegration.GetDeltaV();
+    r.segment<3>(kIndexErrorOri) = Log(preintegration.GetDeltaR().transpose() * R_i_t * keyframe_j.R);
+
+    // b. Jacobians:
+    const Eigen::Matrix3d J_r_inv = GetRightJacobianInverse(r.segment<3>(kIndexErrorOri));
+
+    Block J_i = Block::Zero();
+    J_i.block<3, 3>(kIndexErrorPos, kIndexErrorPos) = -R_i_t;
+    J_i.block<3, 3>(kIndexErrorPos, kIndexErrorVel) = -R_i_t * delta_t;
+    J_i.block<3, 3>(kIndexErrorPos, kIndexErrorOri) = GetSkewSymmetric(delta_p);
+    J_i.block<3, 3>(kIndexErrorVel, kIndexErrorVel) = -R_i_t;
+    J_i.block<3, 3>(kIndexErrorVel, kIndexErrorOri) = GetSkewSymmetric(delta_v);
+    J_i.block<3, 3>(kIndexErrorOri, kIndexErrorOri) = -J_r_inv * keyframe_j.R.transpose() * keyframe_i.R;
+
+    Block J_j = Block::Zero();
+    J_j.block<3, 3>(kIndexErrorPos, kIndexErrorPos) = R_i_t;
+    J_j.block<3, 3>(kIndexErrorVel, kIndexErrorVel) = R_i_t;
+    J_j.block<3, 3>(kIndexErrorOri, kIndexErrorOri) = J_r_inv;
+
+    // c. normal equations:
+    const Block W = (preintegration.GetCovariance() + kMinCovariance * Block::Identity()).ldlt().solve(Block::Identity());
+    H_ii = J_i.transpose() * W * J_i;
+    H_ij = J_i.transpose() * W * J_j;
+    H_jj = J_j.transpose() * W * J_j;
+    b_i = J_i.transpose() * W * r;
+    b_j = J_j.transpose() * W * r;
+
+    return 0.5 * r.dot(W * r);
+}
+
+double SlidingWindowOptimizer::LinearizePoseFactor(const Keyframe &keyframe, Block &H, Vector &b) const {
+    const Eigen::Vector3d r_t = keyframe.t - keyframe.t_meas;
+    const Eigen::Vector3d r_R = Log(keyframe.R_meas.transpose() * keyframe.R);
+    const Eigen::Matrix3d J_r_inv = GetRightJacobianInverse(r_R);
+
+    const double w_t = 1.0 / (params_.position_stddev * params_.position_stddev);
+    const double w_R = 1.0 / (params_.orientation_stddev * params_.orientation_stddev);
+
+    H.setZero();
+    H.block<3, 3>(kIndexErrorPos, kIndexErrorPos) = w_t * Eigen::Matrix3d::Identity();
+    H.block<3, 3>(kIndexErrorOri, kIndexErrorOri) = w_R * J_r_inv.transpose() * J_r_inv;
+
+    b.setZero();
+    b.segment<3>(kIndexErrorPos) = w_t * r_t;
+    b.segment<3>(kIndexErrorOri) = w_R * J_r_inv.transpose() * r_R;
+
+    return 0.5 * (w_t * r_t.squaredNorm() + w_R * r_R.squaredNorm());
+}
+
+double SlidingWindowOptimizer::LinearizePrior(const Keyframe &keyframe, Block &H, Vector &b) const {
+    // first order expansion around the linearization point at marginalization:
+    Vector dx;
+    dx.segment<3>(kIndexErrorPos) = keyframe.t - prior_keyframe_.t;
+    dx.segment<3>(kIndexErrorVel) = keyframe.v - prior_keyframe_.v;
+    dx.segment<3>(kIndexErrorOri) = Log(prior_keyframe_.R.transpose() * keyframe.R);
+
+    H = prior_H_;
+    b = prior_b_ + prior_H_ * dx;
+
+    return prior_b_.dot(dx) + 0.5 * dx.dot(prior_H_ * dx);
+}
+
+} // namespace estimator
+
+} // namespace imu_integration
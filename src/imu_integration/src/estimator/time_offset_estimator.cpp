@@ -0,0 +1,279 @@
+/*
+ * @Description: online IMU to odometry time offset estimation through angular rate cross-correlation
+ * @Date: 2026-10-18 09:41:52
+ */
+#include "imu_integration/estimator/time_offset_estimator.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+
+#include <unsupported/Eigen/FFT>
+
+#include "glog/logging.h"
+
+namespace imu_integration {
+
+namespace estimator {
+
+namespace {
+
+size_t GetFFTSize(size_t n) {
+    size_t size = 1;
+    while (size < n) {
+        size <<= 1;
+    }
+    return size;
+}
+
+} // namespace
+
+TimeOffsetEstimator::TimeOffsetEstimator(const TimeOffsetConfig &config)
+    : config_(config) {}
+
+TimeOffsetEstimator::~TimeOffsetEstimator(void) {
+    Stop();
+}
+
+void TimeOffsetEstimator::Start(void) {
+    std::lock_guard<std::mutex> lock(loop_mutex_);
+    if (running_) {
+        return;
+    }
+
+    running_ = true;
+    thread_ = std::thread(&TimeOffsetEstimator::Loop, this);
+}
+
+void TimeOffsetEstimator::Stop(void) {
+    {
+        std::lock_guard<std::mutex> lock(loop_mutex_);
+        if (!running_) {
+            return;
+        }
+        running_ = false;
+    }
+
+    loop_cond_.notify_all();
+    thread_.join();
+}
+
+void TimeOffsetEstimator::AddIMUData(
+    std::deque<IMUData>::const_iterator first, std::deque<IMUData>::const_iterator last
+) {
+    if (first == last) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(buff_mutex_);
+    for (; first != last; ++first) {
+        RateSample sample;
+        sample.time = first->time;
+        sample.rate = first->angular_velocity.norm();
+        imu_rate_buff_.push_back(sample);
+    }
+
+    // keep one window plus search range:
+    const double min_time = imu_rate_buff_.back().time - config_.window - 2.0 * config_.max_offset;
+    while (imu_rate_buff_.front().time < min_time) {
+        imu_rate_buff_.pop_front();
+    }
+}
+
+void TimeOffsetEstimator::AddOdomData(
+    std::deque<OdomData>::const_iterator first, std::deque<OdomData>::const_iterator last
+) {
+    if (first == last) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(buff_mutex_);
+    for (; first != last; ++first) {
+        // angular rate from consecutive orientations, stamped at interval midpoint:
+        const double delta_t = first->time - prev_odom_.time;
+        if (has_prev_odom_ && delta_t > 0.0) {
+            Eigen::AngleAxisd delta_R(
+                prev_odom_.pose.block<3, 3>(0, 0).transpose() * first->pose.block<3, 3>(0, 0)
+            );
+
+            RateSample sample;
+            sample.time = prev_odom_.time + 0.5 * delta_t;
+            sample.rate = delta_R.angle() / delta_t;
+            odom_rate_buff_.push_back(sample);
+        }
+
+        prev_odom_ = *first;
+        has_prev_odom_ = true;
+    }
+
+    if (odom_rate_buff_.empty()) {
+        return;
+    }
+
+    const double min_time = odom_rate_buff_.back().time - config_.window - 2.0 * config_.max_offset;
+    while (odom_rate_buff_.front().time < min_time) {
+        odom_rate_buff_.pop_front();
+    }
+}
+
+void TimeOffsetEstimator::Loop(void) {
+    const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(config_.period)
+    );
+
+    std::unique_lock<std::mutex> lock(loop_mutex_);
+    while (running_) {
+        loop_cond_.wait_for(lock, period);
+        if (!running_) {
+            break;
+        }
+
+        lock.unlock();
+
+        double offset, correlation;
+        if (Estimate(offset, correlation)) {
+            correlation_.store(correlation, std::memory_order_relaxed);
+
+            // weak correlation means too little excitation, keep previous estimate:
+            if (correlation >= config_.min_correlation) {
+                if (!has_estimate_) {
+                    LOG(INFO) << "IMU to odometry time offset locked: " << offset << " s, correlation " << correlation;
+                    offset_.store(offset, std::memory_order_relaxed);
+                    has_estimate_ = true;
+                } else {
+                    const double prev_offset = offset_.load(std::memory_order_relaxed);
+                    offset_.store(
+                        prev_offset + config_.smoothing * (offset - prev_offset), std::memory_order_relaxed
+                    );
+                }
+                num_estimates_.Add();
+            }
+        }
+
+        lock.lock();
+    }
+}
+
+bool TimeOffsetEstimator::Estimate(double &offset, double &correlation) {
+    std::vector<RateSample> imu_rate, odom_rate;
+    {
+        std::lock_guard<std::mutex> lock(buff_mutex_);
+        imu_rate.assign(imu_rate_buff_.begin(), imu_rate_buff_.end());
+        odom_rate.assign(odom_rate_buff_.begin(), odom_rate_buff_.end());
+    }
+
+    if (imu_rate.size() < 2 || odom_rate.size() < 2) {
+        return false;
+    }
+
+    // a. common grid over the latest window:
+    const double end_time = std::min(imu_rate.back().time, odom_rate.back().time);
+    const double start_time = std::max(
+        std::max(imu_rate.front().time, odom_rate.front().time), end_time - config_.window
+    );
+    const size_t N = static_cast<size_t>((end_time - start_time) * config_.sample_rate) + 1;
+    const size_t max_lag = static_cast<size_t>(std::ceil(config_.max_offset * config_.sample_rate));
+
+    if (end_time - start_time < 0.5 * config_.window || N < 4 * max_lag) {
+        return false;
+    }
+
+    // b. zero padding so that circular correlation equals linear correlation within search range:
+    const size_t M = GetFFTSize(N + max_lag + 1);
+    std::vector<double> imu_signal, odom_signal;
+    Resample(imu_rate, start_time, N, imu_signal);
+    Resample(odom_rate, start_time, N, odom_signal);
+    imu_signal.resize(M, 0.0);
+    odom_signal.resize(M, 0.0);
+
+    // prefix sums of squares for energies of overlapping segments:
+    std::vector<double> imu_energy(N + 1, 0.0), odom_energy(N + 1, 0.0);
+    for (size_t i = 0; i < N; ++i) {
+        imu_energy[i + 1] = imu_energy[i] + imu_signal[i] * imu_signal[i];
+        odom_energy[i + 1] = odom_energy[i] + odom_signal[i] * odom_signal[i];
+    }
+
+    // c. cross-correlation c[k] = sum imu[n + k] * odom[n]:
+    Eigen::FFT<double> fft;
+    std::vector<std::complex<double>> imu_spectrum, odom_spectrum;
+    fft.fwd(imu_spectrum, imu_signal);
+    fft.fwd(odom_spectrum, odom_signal);
+    for (size_t i = 0; i < M; ++i) {
+        imu_spectrum[i] *= std::conj(odom_spectrum[i]);
+    }
+    std::vector<double> cross_correlation;
+    fft.inv(cross_correlation, imu_spectrum);
+
+    // d. peak of normalized correlation within search range, 
+    //    normalization by overlapping segments keeps the peak from being pulled towards zero lag:
+    const int K = static_cast<int>(max_lag);
+    auto GetCorrelation = [&](int k) {
+        const size_t n = N - std::abs(k);
+        const double energy = (k >= 0) ? 
+            (imu_energy[N] - imu_energy[k]) * odom_energy[n] : 
+            imu_energy[n] * (odom_energy[N] - odom_energy[-k]);
+
+        return (energy > 0.0) ? 
+            cross_correlation[(k + static_cast<int>(M)) % static_cast<int>(M)] / std::sqrt(energy) : 0.0;
+    };
+    int k_peak = -K;
+    for (int k = -K + 1; k <= K; ++k) {
+        if (GetCorrelation(k) > GetCorrelation(k_peak)) {
+            k_peak = k;
+        }
+    }
+
+    // e. sub-sample refinement through parabola fit:
+    double delta_k = 0.0;
+    if (-K < k_peak && k_peak < K) {
+        const double y_prev = GetCorrelation(k_peak - 1);
+        const double y_peak = GetCorrelation(k_peak);
+        const double y_next = GetCorrelation(k_peak + 1);
+        const double curvature = y_prev - 2.0 * y_peak + y_next;
+        if (curvature < 0.0) {
+            delta_k = 0.5 * (y_prev - y_next) / curvature;
+        }
+    }
+
+    offset = (k_peak + delta_k) / config_.sample_rate;
+    correlation = GetCorrelation(k_peak);
+
+    return true;
+}
+
+void TimeOffsetEstimator::Resample(
+    const std::vector<RateSample> &samples, double start_time, size_t N,
+    std::vector<double> &signal
+) const {
+    signal.resize(N);
+
+    // linear interpolation, samples and grid are both sorted:
+    size_t j = 0;
+    double mean = 0.0;
+    for (size_t i = 0; i < N; ++i) {
+        const double time = start_time + i / config_.sample_rate;
+        while (j + 2 < samples.size() && samples[j + 1].time < time) {
+            ++j;
+        }
+
+        const RateSample &prev = samples[j];
+        const RateSample &next = samples[j + 1];
+        const double delta_t = next.time - prev.time;
+        const double scale = (delta_t > 0.0) ? 
+            std::max(0.0, std::min(1.0, (time - prev.time) / delta_t)) : 0.0;
+
+        signal[i] = (1.0 - scale) * prev.rate + scale * next.rate;
+        mean += signal[i];
+    }
+
+    // remove mean so that the constant part does not bias the peak:
+    mean /= N;
+    for (double &value: signal) {
+        value -= mean;
+    }
+}
+
+} // namespace estimator
+
+} // namespace imu_integration
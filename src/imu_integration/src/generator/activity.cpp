@@ -3,13 +3,15 @@
  * @Author: Ge Yao
  * @Date: 2020-11-10 14:25:03
  */
-#include "imu_integration/generator/node_constants.hpp"
 #include "imu_integration/generator/activity.hpp"
 #include "glog/logging.h"
 
 #include <eigen3/Eigen/src/Geometry/Quaternion.h>
 #include <math.h>
 
+#include <algorithm>
+#include <cmath>
+
 namespace imu_integration {
 
 namespace generator {
@@ -64,103 +66,408 @@ void Activity::Init(void) {
     private_nh_.param("imu/acc/sigma_bias", imu_config_.acc_bias_stddev, 5e-4);
     private_nh_.param("imu/acc/sigma_noise", imu_config_.acc_noise_stddev, 0.019);
 
+    // runtime reload of the above through ~reload_imu_params:
+    imu_params_watcher_ptr_ = std::make_shared<IMUParamsWatcher>(private_nh_, IMUParamsWatcher::GetParams(imu_config_));
+
     // parse odom config:
     private_nh_.param("pose/frame_id", odom_config_.frame_id, std::string("inertial"));
     private_nh_.param("pose/topic_name", odom_config_.topic_name.ground_truth, std::string("/pose/ground_truth"));
 
+    // parse sensors config:
+    private_nh_.param("sensors/imu/rate", sensors_config_.imu_rate, 100.0);
+    private_nh_.param("sensors/ground_truth/rate", sensors_config_.ground_truth_rate, 100.0);
+    private_nh_.param("sensors/position/rate", sensors_config_.position.rate, 0.0);
+    private_nh_.param("sensors/position/topic_name", sensors_config_.position.topic_name, std::string("/sim/sensor/position"));
+    private_nh_.param("sensors/position/sigma", sensors_config_.position.stddev, 1.0);
+    private_nh_.param("sensors/magnetometer/rate", sensors_config_.magnetometer.rate, 0.0);
+    private_nh_.param("sensors/magnetometer/topic_name", sensors_config_.magnetometer.topic_name, std::string("/sim/sensor/magnetometer"));
+    private_nh_.param("sensors/magnetometer/field/x", sensors_config_.magnetometer.field.x, 0.0);
+    private_nh_.param("sensors/magnetometer/field/y", sensors_config_.magnetometer.field.y, 2.2e-5);
+    private_nh_.param("sensors/magnetometer/field/z", sensors_config_.magnetometer.field.z, -4.2e-5);
+    private_nh_.param("sensors/magnetometer/use_magnetic_model", sensors_config_.magnetometer.use_magnetic_model, true);
+    private_nh_.param("sensors/magnetometer/sigma", sensors_config_.magnetometer.stddev, 5.0e-7);
+
+    // parse magnetic model config, navigation frame origin is shared with the estimator:
+    private_nh_.param("magnetic_model/cof_file", magnetic_model_config_.cof_file, std::string(""));
+    private_nh_.param("magnetic_model/latitude", magnetic_model_config_.latitude, 31.224361);
+    private_nh_.param("magnetic_model/longitude", magnetic_model_config_.longitude, 121.469170);
+    private_nh_.param("magnetic_model/altitude", magnetic_model_config_.altitude, 0.0);
+    private_nh_.param("magnetic_model/decimal_year", magnetic_model_config_.decimal_year, 2019.0);
+    private_nh_.param("magnetic_model/cache/max_distance", magnetic_model_config_.max_distance, 1000.0);
+    private_nh_.param("magnetic_model/cache/max_time", magnetic_model_config_.max_time, 1.0 / 365.0);
+    if (sensors_config_.magnetometer.rate > 0.0 && sensors_config_.magnetometer.use_magnetic_model) {
+        LocalMagneticField::Params params;
+        params.cof_file = magnetic_model_config_.cof_file;
+        params.latitude = magnetic_model_config_.latitude;
+        params.longitude = magnetic_model_config_.longitude;
+        params.altitude = magnetic_model_config_.altitude;
+        params.decimal_year = magnetic_model_config_.decimal_year;
+        params.cache.max_distance = magnetic_model_config_.max_distance;
+        params.cache.max_time = magnetic_model_config_.max_time;
+
+        magnetic_field_ptr_ = std::make_shared<LocalMagneticField>(params);
+    }
+
     // init publishers:
     pub_imu_ = private_nh_.advertise<sensor_msgs::Imu>(imu_config_.topic_name, 500);
     pub_odom_ = private_nh_.advertise<nav_msgs::Odometry>(odom_config_.topic_name.ground_truth, 500);
+    if (sensors_config_.position.rate > 0.0) {
+        pub_position_ = private_nh_.advertise<geometry_msgs::PointStamped>(sensors_config_.position.topic_name, 500);
+    }
+    if (sensors_config_.magnetometer.rate > 0.0) {
+        pub_magnetometer_ = private_nh_.advertise<sensor_msgs::MagneticField>(sensors_config_.magnetometer.topic_name, 500);
+    }
+
+    // parse stress config:
+    private_nh_.param("stress/enable", stress_config_.enable, false);
+    private_nh_.param("stress/profile", stress_config_.profile, std::string("default"));
+    private_nh_.param("stress/rate", stress_config_.rate, 1000.0);
+    private_nh_.param("stress/burst_size", stress_config_.burst_size, 1);
+    private_nh_.param("stress/reorder_probability", stress_config_.reorder_probability, 0.0);
+    private_nh_.param("stress/max_hold", stress_config_.max_hold, 0.1);
+    private_nh_.param("stress/duplicate_probability", stress_config_.duplicate_probability, 0.0);
+    private_nh_.param("stress/drop_probability", stress_config_.drop_probability, 0.0);
+    private_nh_.param("stress/num_topics", stress_config_.num_topics, 1);
+    if (stress_config_.enable) {
+        stress_config_.rate = std::max(stress_config_.rate, 1.0);
+        stress_config_.burst_size = std::max(stress_config_.burst_size, 1);
+
+        for (int i = 1; i < stress_config_.num_topics; ++i) {
+            pub_imu_stress_.push_back(
+                private_nh_.advertise<sensor_msgs::Imu>(imu_config_.topic_name + "/stress_" + std::to_string(i), 500)
+            );
+        }
+
+        imu_shaper_ptr_ = std::make_shared<StressShaper<sensor_msgs::Imu>>(normal_generator_, stress_config_);
+        odom_shaper_ptr_ = std::make_shared<StressShaper<nav_msgs::Odometry>>(normal_generator_, stress_config_);
+
+        LOG(INFO) << "Stress profile " << stress_config_.profile << ": " 
+                  << stress_config_.rate << " Hz in bursts of " << stress_config_.burst_size 
+                  << ", reorder " << stress_config_.reorder_probability 
+                  << ", duplicate " << stress_config_.duplicate_probability
+                  << ", drop " << stress_config_.drop_probability 
+                  << ", " << stress_config_.num_topics << " IMU topics";
+    }
 
     // init timestamp:
     timestamp_ = ros::Time::now();
+
+    // parse simulated clock config:
+    private_nh_.param("sim_clock/enable", sim_clock_config_.enable, false);
+    private_nh_.param("sim_clock/start_time", sim_clock_config_.start_time, 1.0);
+    private_nh_.param("sim_clock/duration", sim_clock_config_.duration, 0.0);
+    private_nh_.param(
+        "sim_clock/consumers", sim_clock_config_.consumers, 
+        std::vector<std::string>(1, "/imu_integration_estimator_node")
+    );
+    private_nh_.param("sim_clock/ack_topic", sim_clock_config_.ack_topic, std::string("/sim_clock/ack"));
+    private_nh_.param("sim_clock/ack_timeout", sim_clock_config_.ack_timeout, 0.0);
+    if (sim_clock_config_.enable && stress_config_.enable) {
+        LOG(WARNING) << "Simulated clock is not available in stress mode, using wall clock";
+    } else if (sim_clock_config_.enable) {
+        SimClockServer::Params params;
+        params.consumers = sim_clock_config_.consumers;
+        params.ack_topic = sim_clock_config_.ack_topic;
+        params.start_time = sim_clock_config_.start_time;
+        params.ack_timeout = sim_clock_config_.ack_timeout;
+
+        sim_clock_server_ptr_ = std::make_shared<SimClockServer>(private_nh_, params);
+        timestamp_ = sim_clock_server_ptr_->GetTime();
+    }
+
+    // every sensor fires at its own rate from the initial timestamp on:
+    imu_time_ = timestamp_.toSec();
+    if (!stress_config_.enable) {
+        const double start_time = timestamp_.toSec();
+        scheduler_.AddSensor(
+            "imu", sensors_config_.imu_rate, start_time, 
+            [this](double time) { PublishIMU(time); }
+        );
+        scheduler_.AddSensor(
+            "ground_truth", sensors_config_.ground_truth_rate, start_time, 
+            [this](double time) { PublishGroundTruth(time); }
+        );
+        scheduler_.AddSensor(
+            "position", sensors_config_.position.rate, start_time, 
+            [this](double time) { PublishPosition(time); }
+        );
+        scheduler_.AddSensor(
+            "magnetometer", sensors_config_.magnetometer.rate, start_time, 
+            [this](double time) { PublishMagnetometer(time); }
+        );
+
+        if (scheduler_.GetSensors().empty()) {
+            LOG(WARNING) << "No sensor has a positive rate, nothing will be published";
+        }
+    }
+
+    // parse metrics config:
+    private_nh_.param("metrics/enable", metrics_config_.enable, false);
+    private_nh_.param("metrics/port", metrics_config_.port, 9102);
+    private_nh_.param("metrics/textfile_path", metrics_config_.textfile_path, std::string(""));
+    private_nh_.param("metrics/period", metrics_config_.period, 1.0);
+    if (metrics_config_.enable) {
+        RegisterMetrics();
+        metrics_exporter_ptr_ = std::make_shared<MetricsExporter>(metrics_registry_);
+        metrics_exporter_ptr_->Start(metrics_config_.port, metrics_config_.textfile_path, metrics_config_.period);
+    }
+
+    // nothing is published before every consumer listens:
+    if (sim_clock_server_ptr_) {
+        std::vector<ros::Publisher> publishers;
+        if (sensors_config_.imu_rate > 0.0) {
+            publishers.push_back(pub_imu_);
+        }
+        if (sensors_config_.ground_truth_rate > 0.0) {
+            publishers.push_back(pub_odom_);
+        }
+
+        sim_clock_server_ptr_->WaitForConsumers(publishers);
+    }
 }
 
 void Activity::Run(void) {
-    // update timestamp:
-    ros::Time timestamp = ros::Time::now();
-    double delta_t = timestamp.toSec() - timestamp_.toSec();
-    timestamp_ = timestamp;
+    ScopedCPUTimer cpu_timer(metrics_config_.enable ? &run_cpu_time_ : nullptr);
+
+    UpdateIMUParams();
+
+    if (stress_config_.enable) {
+        RunStress();
+        return;
+    }
+
+    if (sim_clock_server_ptr_) {
+        RunSimClock();
+        return;
+    }
+
+    // every sensor measurement due by now, stamped at its own sample time:
+    scheduler_.RunUntil(ros::Time::now().toSec());
+}
+
+void Activity::RunStress(void) {
+    auto publish_imu = [this](const sensor_msgs::Imu &message_imu) { PublishIMUMessage(message_imu); };
+    auto publish_odom = [this](const nav_msgs::Odometry &message_odom) { PublishOdometryMessage(message_odom); };
+
+    // a message held for reordering is not kept back past its deadline:
+    imu_shaper_ptr_->Release(publish_imu);
+    odom_shaper_ptr_->Release(publish_odom);
+
+    // a burst of measurements evenly spaced at the stress rate, the last one stamped now:
+    const double time = ros::Time::now().toSec();
+    const double sample_period = 1.0 / stress_config_.rate;
+
+    for (int i = stress_config_.burst_size - 1; i >= 0; --i) {
+        ros::Time timestamp(time - i * sample_period);
+        double delta_t = timestamp.toSec() - timestamp_.toSec();
+        // a late cycle overlaps the previous burst:
+        if (delta_t <= 0.0) {
+            continue;
+        }
+        timestamp_ = timestamp;
+
+        GetGroundTruth();
+        AddNoise(delta_t);
+        SetIMUMessage();
+        SetOdometryMessage();
+
+        imu_shaper_ptr_->Push(message_imu_, publish_imu);
+        odom_shaper_ptr_->Push(message_odom_, publish_odom);
+    }
+}
+
+void Activity::RunSimClock(void) {
+    // one step per sensor event time, measurements go out before the clock:
+    const double time = scheduler_.GetNextTime();
+    if (!std::isfinite(time)) {
+        return;
+    }
+
+    scheduler_.RunUntil(time);
+
+    sim_clock_server_ptr_->Advance(time);
+    sim_clock_server_ptr_->WaitForAcks();
+}
+
+void Activity::PublishIMU(double time) {
+    const double delta_t = time - imu_time_;
+    imu_time_ = time;
 
-    // get ground truth from motion equation:
+    timestamp_ = ros::Time(time);
     GetGroundTruth();
-    // update bias & add measurement noises:
     AddNoise(delta_t);
-    // convert to ROS messages:
     SetIMUMessage();
+
+    PublishIMUMessage(message_imu_);
+}
+
+void Activity::PublishGroundTruth(double time) {
+    timestamp_ = ros::Time(time);
+    GetGroundTruth();
     SetOdometryMessage();
-    // publish ROS messages:
-    PublishMessages();
+
+    PublishOdometryMessage(message_odom_);
 }
 
-void Activity::GetGroundTruth(void) {
-    // acceleration:
-    double timestamp_in_sec = timestamp_.toSec();
-    double sin_w_xy_t = sin(kOmegaXY*timestamp_in_sec);
-    double cos_w_xy_t = cos(kOmegaXY*timestamp_in_sec);
-    double sin_w_z_t = sin(kOmegaZ*timestamp_in_sec);
-    double cos_w_z_t = cos(kOmegaZ*timestamp_in_sec);
-    double rho_x_w_xy = kRhoX*kOmegaXY;
-    double rho_y_w_xy = kRhoY*kOmegaXY;
-    double rho_z_w_z = kRhoZ*kOmegaZ;
-
-    Eigen::Vector3d p(
-        kRhoX*cos_w_xy_t, 
-        kRhoY*sin_w_xy_t, 
-        kRhoZ*sin_w_z_t
-    );
-    Eigen::Vector3d v(
-        -rho_x_w_xy*sin_w_xy_t, 
-         rho_y_w_xy*cos_w_xy_t, 
-         rho_z_w_z*cos_w_z_t
+void Activity::PublishPosition(double time) {
+    timestamp_ = ros::Time(time);
+    GetGroundTruth();
+
+    const Eigen::Vector3d position = t_gt_ + sensors_config_.position.stddev * GetStandardNormal();
+
+    geometry_msgs::PointStamped message_position;
+    message_position.header.stamp = timestamp_;
+    message_position.header.frame_id = odom_config_.frame_id;
+    message_position.point.x = position.x();
+    message_position.point.y = position.y();
+    message_position.point.z = position.z();
+
+    pub_position_.publish(message_position);
+    num_position_published_.Add();
+    if (sim_clock_server_ptr_) {
+        sim_clock_server_ptr_->SetPublished(pub_position_.getTopic(), time);
+    }
+}
+
+void Activity::PublishMagnetometer(double time) {
+    timestamp_ = ros::Time(time);
+    GetGroundTruth();
+
+    const Eigen::Vector3d field = magnetic_field_ptr_ ? magnetic_field_ptr_->GetField(t_gt_, time) : Eigen::Vector3d(
+        sensors_config_.magnetometer.field.x, 
+        sensors_config_.magnetometer.field.y, 
+        sensors_config_.magnetometer.field.z
     );
-    Eigen::Vector3d a(
-        -rho_x_w_xy*kOmegaXY*cos_w_xy_t, 
-        -rho_y_w_xy*kOmegaXY*sin_w_xy_t, 
-        -rho_z_w_z*kOmegaZ*sin_w_z_t
+    const Eigen::Vector3d magnetic_field = 
+        R_gt_.transpose() * field + sensors_config_.magnetometer.stddev * GetStandardNormal();
+
+    sensor_msgs::MagneticField message_magnetometer;
+    message_magnetometer.header.stamp = timestamp_;
+    message_magnetometer.header.frame_id = imu_config_.frame_id;
+    message_magnetometer.magnetic_field.x = magnetic_field.x();
+    message_magnetometer.magnetic_field.y = magnetic_field.y();
+    message_magnetometer.magnetic_field.z = magnetic_field.z();
+    const double variance = sensors_config_.magnetometer.stddev * sensors_config_.magnetometer.stddev;
+    for (size_t i = 0; i < 9; ++i) {
+        message_magnetometer.magnetic_field_covariance[i] = (i % 4 == 0) ? variance : 0.0;
+    }
+
+    pub_magnetometer_.publish(message_magnetometer);
+    num_magnetometer_published_.Add();
+    if (sim_clock_server_ptr_) {
+        sim_clock_server_ptr_->SetPublished(pub_magnetometer_.getTopic(), time);
+    }
+}
+
+Eigen::Vector3d Activity::GetStandardNormal(void) {
+    return Eigen::Vector3d(
+        normal_distribution_(normal_generator_),
+        normal_distribution_(normal_generator_),
+        normal_distribution_(normal_generator_)
     );
+}
 
-    // angular velocity:
-    double sin_t = sin(timestamp_in_sec);
-    double cos_t = cos(timestamp_in_sec);
+double Activity::GetLoopRate(void) const {
+    if (stress_config_.enable) {
+        return stress_config_.rate / stress_config_.burst_size;
+    }
 
-    Eigen::Vector3d euler_angles(
-        kRoll*cos_t,
-        kPitch*sin_t,
-        kYaw*timestamp_in_sec
-    );
+    // as fast as consumers acknowledge:
+    if (sim_clock_server_ptr_) {
+        return 0.0;
+    }
 
-    Eigen::Vector3d euler_angle_rates(
-        -kRoll*sin_t,
-        kPitch*cos_t,
-        kYaw
+    // fastest sensor, 100 Hz without any:
+    const double max_rate = scheduler_.GetMaxRate();
+    return (max_rate > 0.0) ? max_rate : 100.0;
+}
+
+bool Activity::IsFinished(void) const {
+    return (
+        sim_clock_server_ptr_ && 
+        sim_clock_config_.duration > 0.0 &&
+        sim_clock_server_ptr_->GetTime().toSec() - sim_clock_config_.start_time >= sim_clock_config_.duration
     );
+}
+
+void Activity::Flush(void) {
+    if (!stress_config_.enable) {
+        return;
+    }
 
-    // transform to body frame:
-    R_gt_ = EulerAnglesToRotation(euler_angles);
-    t_gt_ = p;
-    v_gt_ = v;
-    // a. angular velocity:
-    angular_vel_ = EulerAngleRatesToBodyAngleRates(euler_angles, euler_angle_rates);
-    // b. linear acceleration:
-    linear_acc_ = R_gt_.transpose() * (a + G_);
+    imu_shaper_ptr_->Flush([this](const sensor_msgs::Imu &message_imu) { PublishIMUMessage(message_imu); });
+    odom_shaper_ptr_->Flush([this](const nav_msgs::Odometry &message_odom) { PublishOdometryMessage(message_odom); });
+}
+
+void Activity::Report(void) const {
+    if (sim_clock_server_ptr_) {
+        LOG(INFO) << "Simulated clock summary: " 
+                  << sim_clock_server_ptr_->GetTime().toSec() - sim_clock_config_.start_time << " s in "
+                  << sim_clock_server_ptr_->GetNumSteps().Get() << " steps, "
+                  << sim_clock_server_ptr_->GetNumTimeouts().Get() << " acknowledgement timeouts";
+    }
+
+    if (!stress_config_.enable) {
+        for (const SensorScheduler::Sensor &sensor: scheduler_.GetSensors()) {
+            LOG(INFO) << "Sensor " << sensor.name << " at " << sensor.rate << " Hz published " << sensor.num_fired;
+        }
+        return;
+    }
+
+    LOG(INFO) << "Stress profile " << stress_config_.profile << " summary:" << std::endl
+              << "\timu generated " << imu_shaper_ptr_->GetNumIn() 
+              << ", published " << imu_shaper_ptr_->GetNumOut() 
+              << ", dropped " << imu_shaper_ptr_->GetNumDropped()
+              << ", duplicated " << imu_shaper_ptr_->GetNumDuplicated()
+              << ", reordered " << imu_shaper_ptr_->GetNumReordered() << std::endl
+              << "\todom generated " << odom_shaper_ptr_->GetNumIn() 
+              << ", published " << odom_shaper_ptr_->GetNumOut() 
+              << ", dropped " << odom_shaper_ptr_->GetNumDropped()
+              << ", duplicated " << odom_shaper_ptr_->GetNumDuplicated()
+              << ", reordered " << odom_shaper_ptr_->GetNumReordered();
+}
+
+void Activity::GetGroundTruth(void) {
+    MotionState state;
+    generator::GetGroundTruth(timestamp_.toSec(), G_, state);
+
+    R_gt_ = state.R;
+    t_gt_ = state.t;
+    v_gt_ = state.v;
+    angular_vel_ = state.angular_vel;
+    linear_acc_ = state.linear_acc;
 }
 
 void Activity::AddNoise(double delta_t) {
-    // TODO: add params to class attributes:
-    double sqrt_delta_t = sqrt(delta_t);
+    IMUNoise noise;
+    noise.gyro_bias_stddev = imu_config_.gyro_bias_stddev;
+    noise.gyro_noise_stddev = imu_config_.gyro_noise_stddev;
+    noise.acc_bias_stddev = imu_config_.acc_bias_stddev;
+    noise.acc_noise_stddev = imu_config_.acc_noise_stddev;
+
+    generator::AddNoise(
+        noise, delta_t, normal_generator_, normal_distribution_,
+        angular_vel_bias_, linear_acc_bias_,
+        angular_vel_, linear_acc_
+    );
+}
 
-    // a. update bias:
-    angular_vel_bias_ += GetGaussianNoise(imu_config_.gyro_bias_stddev * sqrt_delta_t);
-    linear_acc_bias_ += GetGaussianNoise(imu_config_.acc_bias_stddev * sqrt_delta_t);
+void Activity::UpdateIMUParams(void) {
+    IMUParams params;
+    if (!imu_params_watcher_ptr_->GetUpdate(params)) {
+        return;
+    }
 
-    // b. get measurement noise:
-    Eigen::Vector3d angular_vel_noise = GetGaussianNoise(imu_config_.gyro_noise_stddev / sqrt_delta_t);
-    Eigen::Vector3d linear_acc_noise = GetGaussianNoise(imu_config_.acc_noise_stddev / sqrt_delta_t);
+    IMUParamsWatcher::SetParams(params, imu_config_);
 
-    // apply to measurement:
-    angular_vel_ += angular_vel_bias_ + angular_vel_noise;
-    linear_acc_ += linear_acc_bias_ + linear_acc_noise;
+    G_ = Eigen::Vector3d(params.gravity.x, params.gravity.y, params.gravity.z);
+    // restart bias random walks from the new values:
+    angular_vel_bias_ = Eigen::Vector3d(
+        params.bias.angular_velocity.x, params.bias.angular_velocity.y, params.bias.angular_velocity.z
+    );
+    linear_acc_bias_ = Eigen::Vector3d(
+        params.bias.linear_acceleration.x, params.bias.linear_acceleration.y, params.bias.linear_acceleration.z
+    );
 }
 
 void Activity::SetIMUMessage(void) {
@@ -210,60 +517,70 @@ void Activity::SetOdometryMessage(void) {
     message_odom_.twist.twist.linear.z = v_gt_.z(); 
 }
 
-void Activity::PublishMessages(void) {
-    pub_imu_.publish(message_imu_);
-    pub_odom_.publish(message_odom_);
-}
-
-Eigen::Vector3d Activity::GetGaussianNoise(double stddev) {
-    return stddev * Eigen::Vector3d(
-        normal_distribution_(normal_generator_),
-        normal_distribution_(normal_generator_),
-        normal_distribution_(normal_generator_)
-    );
+void Activity::PublishIMUMessage(const sensor_msgs::Imu &message_imu) {
+    pub_imu_.publish(message_imu);
+    for (const ros::Publisher &pub_imu: pub_imu_stress_) {
+        pub_imu.publish(message_imu);
+    }
+
+    num_imu_published_.Add();
+    if (sim_clock_server_ptr_) {
+        sim_clock_server_ptr_->SetPublished(pub_imu_.getTopic(), message_imu.header.stamp.toSec());
+    }
+    const double publish_lag = ros::Time::now().toSec() - message_imu.header.stamp.toSec();
+    if (publish_lag >= 0.0) {
+        publish_lag_.Record(static_cast<uint64_t>(1.0e9 * publish_lag));
+    }
 }
 
-Eigen::Matrix3d Activity::EulerAnglesToRotation(
-    const Eigen::Vector3d &euler_angles
-) {
-    // parse Euler angles:
-    double roll = euler_angles.x();
-    double pitch = euler_angles.y();
-    double yaw = euler_angles.z();
-
-    double cr =  cos(roll); double sr =  sin(roll);
-    double cp = cos(pitch); double sp = sin(pitch);
-    double cy =   cos(yaw); double sy =   sin(yaw);
+void Activity::PublishOdometryMessage(const nav_msgs::Odometry &message_odom) {
+    pub_odom_.publish(message_odom);
 
-    Eigen::Matrix3d R_ib;
-    
-    R_ib << 
-        cy*cp,  cy*sp*sr - sy*cr,   sy*sr + cy* cr*sp,
-        sy*cp, cy *cr + sy*sr*sp,    sp*sy*cr - cy*sr,
-          -sp,             cp*sr,               cp*cr;
-
-    return R_ib;
+    num_odom_published_.Add();
+    if (sim_clock_server_ptr_) {
+        sim_clock_server_ptr_->SetPublished(pub_odom_.getTopic(), message_odom.header.stamp.toSec());
+    }
 }
 
-Eigen::Vector3d Activity::EulerAngleRatesToBodyAngleRates(
-    const Eigen::Vector3d &euler_angles, 
-    const Eigen::Vector3d &euler_angle_rates
-) {
-    // parse euler angles:
-    double roll = euler_angles(0);
-    double pitch = euler_angles(1);
-
-    double cr =  cos(roll); double sr =  sin(roll);
-    double cp = cos(pitch); double sp = sin(pitch);
-
-    Eigen::Matrix3d R;
+void Activity::RegisterMetrics(void) {
+    const std::string prefix("imu_integration_generator_");
 
-    R <<  
-        1,     0,    - sp,
-        0,    cr,   sr*cp,
-        0,   -sr,   cr*cp;
+    metrics_registry_.AddCounter(
+        prefix + "messages_published_total", "Messages published.", "topic=\"imu\"", &num_imu_published_
+    );
+    metrics_registry_.AddCounter(
+        prefix + "messages_published_total", "Messages published.", "topic=\"odom\"", &num_odom_published_
+    );
+    if (sensors_config_.position.rate > 0.0) {
+        metrics_registry_.AddCounter(
+            prefix + "messages_published_total", "Messages published.", "topic=\"position\"", &num_position_published_
+        );
+    }
+    if (sensors_config_.magnetometer.rate > 0.0) {
+        metrics_registry_.AddCounter(
+            prefix + "messages_published_total", "Messages published.", "topic=\"magnetometer\"", &num_magnetometer_published_
+        );
+    }
+    metrics_registry_.AddHistogram(
+        prefix + "run_cpu_seconds", "Thread CPU time per generation cycle.", "", &run_cpu_time_
+    );
+    metrics_registry_.AddHistogram(
+        prefix + "publish_lag_seconds", "Delay from measurement stamp to publishing.", "", &publish_lag_
+    );
 
-    return R * euler_angle_rates;
+    if (sim_clock_server_ptr_) {
+        metrics_registry_.AddCounter(
+            prefix + "sim_clock_steps_total", "Simulated clock steps.", "", &sim_clock_server_ptr_->GetNumSteps()
+        );
+        metrics_registry_.AddCounter(
+            prefix + "sim_clock_ack_timeouts_total", "Simulated clock steps advanced without all acknowledgements.", "", 
+            &sim_clock_server_ptr_->GetNumTimeouts()
+        );
+        metrics_registry_.AddHistogram(
+            prefix + "sim_clock_ack_wait_seconds", "Wall time waiting for consumers per simulated clock step.", "", 
+            &sim_clock_server_ptr_->GetAckWait()
+        );
+    }
 }
 
 }  // namespace generator
@@ -0,0 +1,145 @@
+/*
+ * @Description: ground truth motion equation and IMU noise model, free of ROS
+ * @Date: 2026-10-18 10:52:31
+ */
+#include "imu_integration/generator/node_constants.hpp"
+#include "imu_integration/generator/motion_model.hpp"
+
+namespace imu_integration {
+
+namespace generator {
+
+Eigen::Matrix3d EulerAnglesToRotation(
+    const Eigen::Vector3d &euler_angles
+) {
+    // parse Euler angles:
+    double roll = euler_angles.x();
+    double pitch = euler_angles.y();
+    double yaw = euler_angles.z();
+
+    double cr =  cos(roll); double sr =  sin(roll);
+    double cp = cos(pitch); double sp = sin(pitch);
+    double cy =   cos(yaw); double sy =   sin(yaw);
+
+    Eigen::Matrix3d R_ib;
+
+    R_ib <<
+        cy*cp,  cy*sp*sr - sy*cr,   sy*sr + cy* cr*sp,
+        sy*cp, cy *cr + sy*sr*sp,    sp*sy*cr - cy*sr,
+          -sp,             cp*sr,               cp*cr;
+
+    return R_ib;
+}
+
+Eigen::Vector3d EulerAngleRatesToBodyAngleRates(
+    const Eigen::Vector3d &euler_angles,
+    const Eigen::Vector3d &euler_angle_rates
+) {
+    // parse euler angles:
+    double roll = euler_angles(0);
+    double pitch = euler_angles(1);
+
+    double cr =  cos(roll); double sr =  sin(roll);
+    double cp = cos(pitch); double sp = sin(pitch);
+
+    Eigen::Matrix3d R;
+
+    R <<
+        1,     0,    - sp,
+        0,    cr,   sr*cp,
+        0,   -sr,   cr*cp;
+
+    return R * euler_angle_rates;
+}
+
+void GetGroundTruth(double time, const Eigen::Vector3d &G, MotionState &state) {
+    // acceleration:
+    double sin_w_xy_t = sin(kOmegaXY*time);
+    double cos_w_xy_t = cos(kOmegaXY*time);
+    double sin_w_z_t = sin(kOmegaZ*time);
+    double cos_w_z_t = cos(kOmegaZ*time);
+    double rho_x_w_xy = kRhoX*kOmegaXY;
+    double rho_y_w_xy = kRhoY*kOmegaXY;
+    double rho_z_w_z = kRhoZ*kOmegaZ;
+
+    Eigen::Vector3d p(
+        kRhoX*cos_w_xy_t,
+        kRhoY*sin_w_xy_t,
+        kRhoZ*sin_w_z_t
+    );
+    Eigen::Vector3d v(
+        -rho_x_w_xy*sin_w_xy_t,
+         rho_y_w_xy*cos_w_xy_t,
+         rho_z_w_z*cos_w_z_t
+    );
+    Eigen::Vector3d a(
+        -rho_x_w_xy*kOmegaXY*cos_w_xy_t,
+        -rho_y_w_xy*kOmegaXY*sin_w_xy_t,
+        -rho_z_w_z*kOmegaZ*sin_w_z_t
+    );
+
+    // angular velocity:
+    double sin_t = sin(time);
+    double cos_t = cos(time);
+
+    Eigen::Vector3d euler_angles(
+        kRoll*cos_t,
+        kPitch*sin_t,
+        kYaw*time
+    );
+
+    Eigen::Vector3d euler_angle_rates(
+        -kRoll*sin_t,
+        kPitch*cos_t,
+        kYaw
+    );
+
+    // transform to body frame:
+    state.R = EulerAnglesToRotation(euler_angles);
+    state.t = p;
+    state.v = v;
+    // a. angular velocity:
+    state.angular_vel = EulerAngleRatesToBodyAngleRates(euler_angles, euler_angle_rates);
+    // b. linear acceleration:
+    state.linear_acc = state.R.transpose() * (a + G);
+}
+
+void GenerateBatch(
+    size_t num_samples, const double *time,
+    const Eigen::Vector3d &G, const IMUNoise *noise, unsigned int seed,
+    const Eigen::Vector3d &angular_vel_bias, const Eigen::Vector3d &linear_acc_bias,
+    double *position, double *orientation, double *velocity,
+    double *angular_velocity, double *linear_acceleration
+) {
+    std::default_random_engine engine(seed);
+    std::normal_distribution<double> distribution(0.0, 1.0);
+
+    Eigen::Vector3d angular_vel_bias_curr = angular_vel_bias;
+    Eigen::Vector3d linear_acc_bias_curr = linear_acc_bias;
+
+    MotionState state;
+    for (size_t i = 0; i < num_samples; ++i) {
+        GetGroundTruth(time[i], G, state);
+
+        // the first measurement uses the sample period of the second:
+        if (noise && num_samples > 1) {
+            const double delta_t = (i > 0) ? time[i] - time[i - 1] : time[1] - time[0];
+            AddNoise(
+                *noise, delta_t, engine, distribution,
+                angular_vel_bias_curr, linear_acc_bias_curr,
+                state.angular_vel, state.linear_acc
+            );
+        }
+
+        const Eigen::Quaterniond q(state.R);
+        Eigen::Map<Eigen::Vector3d>(position + 3 * i) = state.t;
+        Eigen::Map<Eigen::Vector4d>(orientation + 4 * i) = q.coeffs();
+        Eigen::Map<Eigen::Vector3d>(velocity + 3 * i) = state.v;
+        Eigen::Map<Eigen::Vector3d>(angular_velocity + 3 * i) = state.angular_vel;
+        Eigen::Map<Eigen::Vector3d>(linear_acceleration + 3 * i) = state.linear_acc;
+    }
+}
+
+}  // namespace generator
+
+}  // namespace imu_integration
@@ -1,4 +1,5 @@
 #include <fstream>
+#include <memory>
 
 #include <ros/ros.h>
 #include <rosbag/bag.h>
@@ -12,16 +13,24 @@ int main(int argc, char** argv) {
 
     activity.Init();
     
-    // 100 Hz:
-    ros::Rate loop_rate(100);
-    while (ros::ok())
+    // 100 Hz, or stress rate divided by burst size, unthrottled on simulated clock:
+    std::shared_ptr<ros::Rate> loop_rate_ptr;
+    if (activity.GetLoopRate() > 0.0) {
+        loop_rate_ptr = std::make_shared<ros::Rate>(activity.GetLoopRate());
+    }
+    while (ros::ok() && !activity.IsFinished())
     {
         ros::spinOnce();
 
         activity.Run();
 
-        loop_rate.sleep();
+        if (loop_rate_ptr) {
+            loop_rate_ptr->sleep();
+        }
     } 
 
+    activity.Flush();
+    activity.Report();
+
     return EXIT_SUCCESS;
 }
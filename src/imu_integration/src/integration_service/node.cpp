@@ -0,0 +1,37 @@
+/*
+ * @Description: standalone node serving stateless IMU integration
+ * @Date: 2026-10-18 14:08:52
+ */
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+#include <ros/ros.h>
+
+#include "imu_integration/estimator/integration_service.hpp"
+
+#include "glog/logging.h"
+
+int main(int argc, char** argv) {
+    std::string node_name{"imu_integration_service_node"};
+    ros::init(argc, argv, node_name);
+
+    ros::NodeHandle private_nh("~");
+
+    std::string service_name;
+    int num_threads;
+    private_nh.param("service_name", service_name, std::string("integrate_imu"));
+    private_nh.param("num_threads", num_threads, 1);
+
+    imu_integration::estimator::IntegrationService service(private_nh, service_name);
+
+    // calls are independent, 0 uses one thread per core:
+    ros::MultiThreadedSpinner spinner(static_cast<uint32_t>(std::max(num_threads, 0)));
+    spinner.spin();
+
+    LOG(INFO) << "Integration service summary: "
+              << service.GetNumCalls().Get() << " calls, " 
+              << service.GetNumFailures().Get() << " rejected";
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,94 @@
+/*
+ * @Description: publish odometry from a pre-serialized, in-place patched buffer
+ * @Date: 2026-10-18 10:12:46
+ */
+#include "imu_integration/publisher/odom_publisher.hpp"
+
+namespace imu_integration {
+
+namespace {
+
+// nav_msgs/Odometry wire layout after the two frame id strings:
+const uint32_t kPoseSize = (3 + 4) * sizeof(double);
+const uint32_t kTwistSize = (3 + 3) * sizeof(double);
+const uint32_t kCovarianceSize = 36 * sizeof(double);
+
+} // namespace
+
+void SerializedOdometry::Init(const std::string &frame_id, const std::string &child_frame_id) {
+    // a. header, seq and stamp are patched on publish:
+    buffer.assign(
+        3 * sizeof(uint32_t) + 
+        sizeof(uint32_t) + frame_id.size() + 
+        sizeof(uint32_t) + child_frame_id.size() + 
+        kPoseSize + kCovarianceSize + 
+        kTwistSize + kCovarianceSize, 
+        0
+    );
+    uint32_t offset = 3 * sizeof(uint32_t);
+    WriteString(offset, frame_id);
+
+    // b. child frame id:
+    WriteString(offset, child_frame_id);
+
+    // c. pose, identity orientation until first publish, zero covariance:
+    pose_offset_ = offset;
+    Write(pose_offset_ + 6 * sizeof(double), 1.0);
+
+    // d. twist, zero covariance:
+    twist_offset_ = pose_offset_ + kPoseSize + kCovarianceSize;
+}
+
+void SerializedOdometry::WriteString(uint32_t &offset, const std::string &value) {
+    const uint32_t length = static_cast<uint32_t>(value.size());
+    Write(offset, length);
+    offset += sizeof(uint32_t);
+
+    memcpy(buffer.data() + offset, value.data(), length);
+    offset += length;
+}
+
+void SerializedOdometry::Patch(uint32_t seq, const ros::Time &stamp, const Eigen::Matrix4d &pose, const Eigen::Vector3d &vel) {
+    // a. header:
+    Write(0, seq);
+    Write(sizeof(uint32_t), stamp.sec);
+    Write(2 * sizeof(uint32_t), stamp.nsec);
+
+    // b. position:
+    uint32_t offset = pose_offset_;
+    for (int i = 0; i < 3; ++i, offset += sizeof(double)) {
+        Write(offset, pose(i, 3));
+    }
+
+    // c. orientation:
+    Eigen::Quaterniond q(pose.block<3, 3>(0, 0));
+    Write(offset, q.x()); offset += sizeof(double);
+    Write(offset, q.y()); offset += sizeof(double);
+    Write(offset, q.z()); offset += sizeof(double);
+    Write(offset, q.w());
+
+    // d. linear velocity, angular velocity stays zero:
+    offset = twist_offset_;
+    for (int i = 0; i < 3; ++i, offset += sizeof(double)) {
+        Write(offset, vel(i));
+    }
+}
+
+OdomPublisher::OdomPublisher(
+    ros::NodeHandle& nh, 
+    std::string topic_name, 
+    std::string frame_id, std::string child_frame_id, 
+    size_t buff_size
+) : nh_(nh) {
+    publisher_ = nh_.advertise<nav_msgs::Odometry>(topic_name, buff_size);
+
+    message_.Init(frame_id, child_frame_id);
+}
+
+void OdomPublisher::Publish(const ros::Time &stamp, const Eigen::Matrix4d &pose, const Eigen::Vector3d &vel) {
+    message_.Patch(seq_++, stamp, pose, vel);
+
+    publisher_.publish(message_);
+}
+
+} // namespace imu_integration
@@ -0,0 +1,285 @@
+/*
+ * @Description: Python bindings of batch integration and generator motion model
+ * @Date: 2026-10-18 16:20:45
+ */
+#include <string>
+#include <vector>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+#include "imu_integration/estimator/batch_integration.hpp"
+#include "imu_integration/generator/motion_model.hpp"
+
+namespace py = pybind11;
+
+namespace {
+
+// C-contiguous float64 arrays are passed through, anything else is converted once:
+typedef py::array_t<double, py::array::c_style | py::array::forcecast> DoubleArray;
+
+size_t GetNumRows(const DoubleArray &array, size_t num_cols, const char *name) {
+    if (
+        (num_cols == 1 && array.ndim() != 1) ||
+        (num_cols > 1 && (array.ndim() != 2 || static_cast<size_t>(array.shape(1)) != num_cols))
+    ) {
+        throw py::value_error(
+            std::string(name) + " must have shape " + (num_cols == 1 ? "(N,)" : "(N, " + std::to_string(num_cols) + ")")
+        );
+    }
+
+    return static_cast<size_t>(array.shape(0));
+}
+
+Eigen::Vector3d GetVector3d(const DoubleArray &array, const char *name) {
+    if (array.size() != 3) {
+        throw py::value_error(std::string(name) + " must have 3 elements");
+    }
+
+    return Eigen::Map<const Eigen::Vector3d>(array.data());
+}
+
+imu_integration::estimator::IntegrationScheme GetScheme(const std::string &scheme) {
+    if ("midpoint" == scheme) {
+        return imu_integration::estimator::IntegrationScheme::MIDPOINT;
+    }
+    if ("euler" == scheme) {
+        return imu_integration::estimator::IntegrationScheme::EULER;
+    }
+
+    throw py::value_error("scheme must be 'midpoint' or 'euler'");
+}
+
+py::tuple Integrate(
+    const DoubleArray &time,
+    const DoubleArray &angular_velocity, const DoubleArray &linear_acceleration,
+    const DoubleArray &init_position, const DoubleArray &init_orientation, const DoubleArray &init_velocity,
+    const DoubleArray &gravity,
+    const DoubleArray &angular_vel_bias, const DoubleArray &linear_acc_bias,
+    const std::string &scheme
+) {
+    const size_t N = GetNumRows(time, 1, "time");
+    if (
+        GetNumRows(angular_velocity, 3, "angular_velocity") != N ||
+        GetNumRows(linear_acceleration, 3, "linear_acceleration") != N
+    ) {
+        throw py::value_error("time, angular_velocity and linear_acceleration must have the same length");
+    }
+    if (init_orientation.size() != 4) {
+        throw py::value_error("init_orientation must have 4 elements, x, y, z, w");
+    }
+
+    imu_integration::estimator::BatchIntegrationParams params;
+    params.scheme = GetScheme(scheme);
+    params.gravity = GetVector3d(gravity, "gravity");
+    params.angular_vel_bias = GetVector3d(angular_vel_bias, "angular_vel_bias");
+    params.linear_acc_bias = GetVector3d(linear_acc_bias, "linear_acc_bias");
+
+    Eigen::Matrix4d init_pose = Eigen::Matrix4d::Identity();
+    init_pose.block<3, 3>(0, 0) = Eigen::Quaterniond(
+        Eigen::Map<const Eigen::Vector4d>(init_orientation.data())
+    ).normalized().toRotationMatrix();
+    init_pose.block<3, 1>(0, 3) = GetVector3d(init_position, "init_position");
+    const Eigen::Vector3d init_vel = GetVector3d(init_velocity, "init_velocity");
+
+    // outputs are allocated once and filled in place:
+    py::array_t<double> position({N, static_cast<size_t>(3)});
+    py::array_t<double> orientation({N, static_cast<size_t>(4)});
+    py::array_t<double> velocity({N, static_cast<size_t>(3)});
+
+    const double *time_ptr = time.data();
+    const double *angular_velocity_ptr = angular_velocity.data();
+    const double *linear_acceleration_ptr = linear_acceleration.data();
+    double *position_ptr = position.mutable_data();
+    double *orientation_ptr = orientation.mutable_data();
+    double *velocity_ptr = velocity.mutable_data();
+
+    {
+        py::gil_scoped_release release;
+
+        imu_integration::estimator::IntegrateBatch(
+            params,
+            N, time_ptr,
+            angular_velocity_ptr, linear_acceleration_ptr,
+            init_pose, init_vel,
+            position_ptr, orientation_ptr, velocity_ptr
+        );
+    }
+
+    return py::make_tuple(position, orientation, velocity);
+}
+
+py::tuple Sensitivity(
+    const DoubleArray &time,
+    const DoubleArray &angular_velocity, const DoubleArray &linear_acceleration,
+    const DoubleArray &init_position, const DoubleArray &init_orientation, const DoubleArray &init_velocity,
+    const DoubleArray &gravity,
+    const DoubleArray &angular_vel_bias, const DoubleArray &linear_acc_bias,
+    const std::string &scheme
+) {
+    const size_t N = GetNumRows(time, 1, "time");
+    if (
+        GetNumRows(angular_velocity, 3, "angular_velocity") != N ||
+        GetNumRows(linear_acceleration, 3, "linear_acceleration") != N
+    ) {
+        throw py::value_error("time, angular_velocity and linear_acceleration must have the same length");
+    }
+    if (init_orientation.size() != 4) {
+        throw py::value_error("init_orientation must have 4 elements, x, y, z, w");
+    }
+
+    imu_integration::estimator::BatchIntegrationParams params;
+    params.scheme = GetScheme(scheme);
+    params.gravity = GetVector3d(gravity, "gravity");
+    params.angular_vel_bias = GetVector3d(angular_vel_bias, "angular_vel_bias");
+    params.linear_acc_bias = GetVector3d(linear_acc_bias, "linear_acc_bias");
+
+    Eigen::Matrix4d init_pose = Eigen::Matrix4d::Identity();
+    init_pose.block<3, 3>(0, 0) = Eigen::Quaterniond(
+        Eigen::Map<const Eigen::Vector4d>(init_orientation.data())
+    ).normalized().toRotationMatrix();
+    init_pose.block<3, 1>(0, 3) = GetVector3d(init_position, "init_position");
+    const Eigen::Vector3d init_vel = GetVector3d(init_velocity, "init_velocity");
+
+    Eigen::Matrix4d pose;
+    Eigen::Vector3d vel;
+    imu_integration::estimator::SensitivityJacobian jacobian;
+
+    const double *time_ptr = time.data();
+    const double *angular_velocity_ptr = angular_velocity.data();
+    const double *linear_acceleration_ptr = linear_acceleration.data();
+
+    {
+        py::gil_scoped_release release;
+
+        imu_integration::estimator::IntegrateSensitivity(
+            params,
+            N, time_ptr,
+            angular_velocity_ptr, linear_acceleration_ptr,
+            init_pose, init_vel,
+            pose, vel, jacobian
+        );
+    }
+
+    const Eigen::Quaterniond q(Eigen::Matrix3d(pose.block<3, 3>(0, 0)));
+    py::array_t<double> position(3), orientation(4), velocity(3);
+    py::array_t<double> jacobian_array({
+        static_cast<size_t>(jacobian.rows()), static_cast<size_t>(jacobian.cols())
+    });
+    Eigen::Map<Eigen::Vector3d>(position.mutable_data()) = pose.block<3, 1>(0, 3);
+    Eigen::Map<Eigen::Vector4d>(orientation.mutable_data()) = q.coeffs();
+    Eigen::Map<Eigen::Vector3d>(velocity.mutable_data()) = vel;
+    Eigen::Map<Eigen::Matrix<double, 9, imu_integration::estimator::kNumSensitivityParams, Eigen::RowMajor>>(
+        jacobian_array.mutable_data()
+    ) = jacobian;
+
+    return py::make_tuple(position, orientation, velocity, jacobian_array);
+}
+
+py::dict Generate(
+    const DoubleArray &time,
+    const DoubleArray &gravity,
+    bool add_noise,
+    double gyro_bias_stddev, double gyro_noise_stddev,
+    double acc_bias_stddev, double acc_noise_stddev,
+    unsigned int seed,
+    const DoubleArray &angular_vel_bias, const DoubleArray &linear_acc_bias
+) {
+    const size_t N = GetNumRows(time, 1, "time");
+
+    const Eigen::Vector3d G = GetVector3d(gravity, "gravity");
+    const Eigen::Vector3d angular_vel_bias_init = GetVector3d(angular_vel_bias, "angular_vel_bias");
+    const Eigen::Vector3d linear_acc_bias_init = GetVector3d(linear_acc_bias, "linear_acc_bias");
+
+    imu_integration::generator::IMUNoise noise;
+    noise.gyro_bias_stddev = gyro_bias_stddev;
+    noise.gyro_noise_stddev = gyro_noise_stddev;
+    noise.acc_bias_stddev = acc_bias_stddev;
+    noise.acc_noise_stddev = acc_noise_stddev;
+
+    py::array_t<double> position({N, static_cast<size_t>(3)});
+    py::array_t<double> orientation({N, static_cast<size_t>(4)});
+    py::array_t<double> velocity({N, static_cast<size_t>(3)});
+    py::array_t<double> angular_velocity({N, static_cast<size_t>(3)});
+    py::array_t<double> linear_acceleration({N, static_cast<size_t>(3)});
+
+    const double *time_ptr = time.data();
+    double *position_ptr = position.mutable_data();
+    double *orientation_ptr = orientation.mutable_data();
+    double *velocity_ptr = velocity.mutable_data();
+    double *angular_velocity_ptr = angular_velocity.mutable_data();
+    double *linear_acceleration_ptr = linear_acceleration.mutable_data();
+
+    {
+        py::gil_scoped_release release;
+
+        imu_integration::generator::GenerateBatch(
+            N, time_ptr,
+            G, add_noise ? &noise : nullptr, seed,
+            angular_vel_bias_init, linear_acc_bias_init,
+            position_ptr, orientation_ptr, velocity_ptr,
+            angular_velocity_ptr, linear_acceleration_ptr
+        );
+    }
+
+    py::dict result;
+    result["position"] = position;
+    result["orientation"] = orientation;
+    result["velocity"] = velocity;
+    result["angular_velocity"] = angular_velocity;
+    result["linear_acceleration"] = linear_acceleration;
+
+    return result;
+}
+
+} // namespace
+
+PYBIND11_MODULE(imu_integration_py, m) {
+    m.doc() = "batch IMU integration and simulated IMU generation";
+
+    const imu_integration::generator::IMUNoise default_noise;
+
+    m.def(
+        "integrate", &Integrate,
+        "Integrate N IMU measurements with the estimator's kernels.\n"
+        "Returns position (N, 3), orientation (N, 4) as x, y, z, w and velocity (N, 3).",
+        py::arg("time"),
+        py::arg("angular_velocity"), py::arg("linear_acceleration"),
+        py::arg("init_position"), py::arg("init_orientation"), py::arg("init_velocity"),
+        py::arg("gravity") = std::vector<double>{0.0, 0.0, -9.7942164704},
+        py::arg("angular_vel_bias") = std::vector<double>{0.0, 0.0, 0.0},
+        py::arg("linear_acc_bias") = std::vector<double>{0.0, 0.0, 0.0},
+        py::arg("scheme") = "midpoint"
+    );
+
+    m.def(
+        "sensitivity", &Sensitivity,
+        "Integrate N IMU measurements and differentiate the final state in the same pass.\n"
+        "Returns final position (3,), orientation (4,) as x, y, z, w, velocity (3,) and the (9, 10) Jacobian\n"
+        "of position, velocity and orientation error by angular_vel_bias, linear_acc_bias, gravity and clock scale.",
+        py::arg("time"),
+        py::arg("angular_velocity"), py::arg("linear_acceleration"),
+        py::arg("init_position"), py::arg("init_orientation"), py::arg("init_velocity"),
+        py::arg("gravity") = std::vector<double>{0.0, 0.0, -9.7942164704},
+        py::arg("angular_vel_bias") = std::vector<double>{0.0, 0.0, 0.0},
+        py::arg("linear_acc_bias") = std::vector<double>{0.0, 0.0, 0.0},
+        py::arg("scheme") = "midpoint"
+    );
+
+    m.def(
+        "generate", &Generate,
+        "Evaluate the generator's motion equation at the given stamps, with optional bias random walk and noise.\n"
+        "Returns a dict of position, orientation (x, y, z, w), velocity, angular_velocity and linear_acceleration.",
+        py::arg("time"),
+        py::arg("gravity") = std::vector<double>{0.0, 0.0, -9.7942164704},
+        py::arg("add_noise") = true,
+        py::arg("gyro_bias_stddev") = default_noise.gyro_bias_stddev,
+        py::arg("gyro_noise_stddev") = default_noise.gyro_noise_stddev,
+        py::arg("acc_bias_stddev") = default_noise.acc_bias_stddev,
+        py::arg("acc_noise_stddev") = default_noise.acc_noise_stddev,
+        py::arg("seed") = 0u,
+        py::arg("angular_vel_bias") = std::vector<double>{0.0, 0.0, 0.0},
+        py::arg("linear_acc_bias") = std::vector<double>{0.0, 0.0, 0.0}
+    );
+}
@@ -0,0 +1,182 @@
+/*
+ * @Description: offline forward filtering and out-of-core RTS smoothing of a recorded bag
+ * @Date: 2026-10-18 19:05:21
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <tuple>
+
+#include <ros/ros.h>
+#include <rosbag/bag.h>
+#include <rosbag/view.h>
+
+#include "imu_integration/estimator/error_state_filter.hpp"
+#include "imu_integration/estimator/rts_smoother.hpp"
+#include "imu_integration/sensor_data/synchronizer.hpp"
+#include "imu_integration/subscriber/wire_format.hpp"
+
+#include "glog/logging.h"
+
+using namespace imu_integration;
+using namespace imu_integration::estimator;
+
+namespace {
+
+struct Options {
+    std::string input_path;
+    std::string output_path;
+    std::string imu_topic = "/sim/sensor/imu";
+    std::string odom_topic = "/pose/ground_truth";
+    // position updates from odometry:
+    double correction_period = 0.1;
+    // states per spilled block:
+    size_t block_size = 1 << 16;
+};
+
+bool ParseOptions(int argc, char** argv, Options &options, ErrorStateFilter::Params &params) {
+    if (argc < 3) {
+        return false;
+    }
+
+    options.input_path = argv[1];
+    options.output_path = argv[2];
+
+    for (int i = 3; i < argc; ++i) {
+        const char *value = strchr(argv[i], '=');
+        if (strncmp(argv[i], "--", 2) != 0 || !value) {
+            return false;
+        }
+        const std::string key(argv[i] + 2, value - argv[i] - 2);
+        ++value;
+
+        if (key == "imu_topic") {
+            options.imu_topic = value;
+        } else if (key == "odom_topic") {
+            options.odom_topic = value;
+        } else if (key == "correction_period") {
+            options.correction_period = atof(value);
+        } else if (key == "block_size") {
+            options.block_size = strtoul(value, nullptr, 10);
+        } else if (key == "gravity_z") {
+            params.gravity.z() = atof(value);
+        } else if (key == "gyro_noise") {
+            params.gyro_noise_stddev = atof(value);
+        } else if (key == "acc_noise") {
+            params.acc_noise_stddev = atof(value);
+        } else if (key == "position_stddev") {
+            params.position_stddev = atof(value);
+        } else {
+            return false;
+        }
+    }
+
+    return options.block_size > 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    ErrorStateFilter::Params params;
+    if (!ParseOptions(argc, argv, options, params)) {
+        fprintf(
+            stderr, 
+            "usage: %s input.bag output.txt [--imu_topic=] [--odom_topic=] [--correction_period=] [--block_size=]\n"
+            "       [--gravity_z=] [--gyro_noise=] [--acc_noise=] [--position_stddev=]\n", 
+            argv[0]
+        );
+        return EXIT_FAILURE;
+    }
+
+    rosbag::Bag bag;
+    bag.open(options.input_path, rosbag::bagmode::Read);
+
+    std::vector<std::string> topics;
+    topics.push_back(options.imu_topic);
+    topics.push_back(options.odom_topic);
+    rosbag::View view(bag, rosbag::TopicQuery(topics));
+
+    RTSSmoother smoother(params, options.output_path + ".spill", options.block_size);
+    if (!smoother.Open()) {
+        return EXIT_FAILURE;
+    }
+
+    // a. forward pass, IMU measurements synchronized with ground truth odometry:
+    ErrorStateFilter filter(params);
+    ApproximateTimeSynchronizer<IMUData, OdomData> synchronizer(10000, 0.2, 1.0);
+    std::tuple<IMUData, OdomData> synced;
+    bool initialized = false;
+    double correction_time = 0.0;
+
+    for (const rosbag::MessageInstance &message: view) {
+        // decoded straight from the wire buffer:
+        if (message.getTopic() == options.imu_topic) {
+            boost::shared_ptr<IMUData> imu_data = message.instantiate<IMUData>();
+            if (imu_data) {
+                synchronizer.AddReference(*imu_data);
+            }
+        } else {
+            boost::shared_ptr<OdomData> odom_data = message.instantiate<OdomData>();
+            if (odom_data) {
+                synchronizer.Add<0>(*odom_data);
+            }
+        }
+
+        while (synchronizer.Pop(synced)) {
+            const IMUData &imu_data = std::get<0>(synced);
+            const OdomData &odom_data = std::get<1>(synced);
+
+            if (!initialized) {
+                filter.Init(odom_data, imu_data, 1.0e-6 * ErrorStateCovariance::Identity());
+                correction_time = imu_data.time;
+                initialized = true;
+            } else {
+                filter.Predict(imu_data);
+                if (imu_data.time - correction_time >= options.correction_period) {
+                    filter.Correct(odom_data.pose.block<3, 1>(0, 3));
+                    correction_time = imu_data.time;
+                }
+            }
+
+            if (!smoother.Add(filter.GetState(), filter.GetIMUData())) {
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    bag.close();
+
+    LOG(INFO) << "Forward pass: " << smoother.GetNumStates() << " states, "
+              << synchronizer.GetNumDropped() << " unsynchronized IMU measurements dropped";
+
+    // b. backward pass, smoothed trajectory in TUM format:
+    std::ofstream output(options.output_path.c_str(), std::ios::out | std::ios::trunc);
+    if (!output) {
+        LOG(WARNING) << "Failed to create output file: " << options.output_path;
+        return EXIT_FAILURE;
+    }
+    output.precision(9);
+
+    const bool success = smoother.Smooth(
+        [&output](const FilterState &state) {
+            Eigen::Quaterniond q(state.R);
+            output << std::fixed << state.time << " "
+                   << state.t.x() << " "
+                   << state.t.y() << " "
+                   << state.t.z() << " "
+                   << q.x() << " "
+                   << q.y() << " "
+                   << q.z() << " "
+                   << q.w() << '\n';
+        }
+    );
+    output.flush();
+    if (!output) {
+        LOG(WARNING) << "Failed to write output file: " << options.output_path;
+        return EXIT_FAILURE;
+    }
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -4,6 +4,7 @@
  * @Date: 2020-11-10 14:25:03
  */
 #include "imu_integration/subscriber/imu_subscriber.hpp"
+#include "imu_integration/subscriber/wire_format.hpp"
 #include "glog/logging.h"
 
 namespace imu_integration {
@@ -11,16 +12,19 @@ namespace imu_integration {
 IMUSubscriber::IMUSubscriber(
   ros::NodeHandle& nh, 
   std::string topic_name, 
-  size_t buff_size
+  size_t buff_size,
+  bool lightweight
 ) :nh_(nh) {
-  subscriber_ = nh_.subscribe(topic_name, buff_size, &IMUSubscriber::msg_callback, this);
+  if (lightweight) {
+    subscriber_ = nh_.subscribe(topic_name, buff_size, &IMUSubscriber::data_callback, this);
+  } else {
+    subscriber_ = nh_.subscribe(topic_name, buff_size, &IMUSubscriber::msg_callback, this);
+  }
 }
 
 void IMUSubscriber::msg_callback(
   const sensor_msgs::ImuConstPtr& imu_msg_ptr
 ) {
-    buff_mutex_.lock();
-
     // convert ROS IMU to GeographicLib compatible GNSS message:
     IMUData imu_data;
     imu_data.time = imu_msg_ptr->header.stamp.toSec();
@@ -37,8 +41,23 @@ void IMUSubscriber::msg_callback(
       imu_msg_ptr->angular_velocity.z
     );
 
+    AddData(imu_data);
+}
+
+void IMUSubscriber::data_callback(
+  const boost::shared_ptr<const IMUData>& imu_data_ptr
+) {
+    AddData(*imu_data_ptr);
+}
+
+void IMUSubscriber::AddData(const IMUData& imu_data) {
+    buff_mutex_.lock();
+
     // add new message to buffer:
     imu_data_.push_back(imu_data);
+
+    stats_.num_received.Add();
+    UpdateHighWaterMark(stats_.buffer_high_water_mark, imu_data_.size());
     
     buff_mutex_.unlock();
 }
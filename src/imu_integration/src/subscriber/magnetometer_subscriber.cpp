@@ -0,0 +1,54 @@
+/*
+ * @Description: Subscribe to ROS magnetic field message
+ * @Date: 2026-10-18 14:08:51
+ */
+#include "imu_integration/subscriber/magnetometer_subscriber.hpp"
+#include "glog/logging.h"
+
+namespace imu_integration {
+
+MagnetometerSubscriber::MagnetometerSubscriber(
+  ros::NodeHandle& nh, 
+  std::string topic_name, 
+  size_t buff_size
+) :nh_(nh) {
+    subscriber_ = nh_.subscribe(topic_name, buff_size, &MagnetometerSubscriber::msg_callback, this);
+}
+
+void MagnetometerSubscriber::msg_callback(
+  const sensor_msgs::MagneticFieldConstPtr& magnetic_field_msg_ptr
+) {
+    MagnetometerData magnetometer_data;
+    magnetometer_data.time = magnetic_field_msg_ptr->header.stamp.toSec();
+    magnetometer_data.magnetic_field = Eigen::Vector3d(
+      magnetic_field_msg_ptr->magnetic_field.x,
+      magnetic_field_msg_ptr->magnetic_field.y,
+      magnetic_field_msg_ptr->magnetic_field.z
+    );
+
+    buff_mutex_.lock();
+
+    // add new message to buffer:
+    magnetometer_data_.push_back(magnetometer_data);
+
+    stats_.num_received.Add();
+    UpdateHighWaterMark(stats_.buffer_high_water_mark, magnetometer_data_.size());
+
+    buff_mutex_.unlock();
+}
+
+void MagnetometerSubscriber::ParseData(
+  std::deque<MagnetometerData>& magnetometer_data
+) {
+    buff_mutex_.lock();
+
+    // pipe all available measurements to output buffer:
+    if (magnetometer_data_.size() > 0) {
+        magnetometer_data.insert(magnetometer_data.end(), magnetometer_data_.begin(), magnetometer_data_.end());
+        magnetometer_data_.clear();
+    }
+
+    buff_mutex_.unlock();
+}
+
+} // namespace imu_integration
@@ -4,6 +4,7 @@
  * @Date: 2020-11-10 14:25:03
  */
 #include "imu_integration/subscriber/odom_subscriber.hpp"
+#include "imu_integration/subscriber/wire_format.hpp"
 #include "glog/logging.h"
 #include <eigen3/Eigen/src/Geometry/RotationBase.h>
 
@@ -12,16 +13,19 @@ namespace imu_integration {
 OdomSubscriber::OdomSubscriber(
   ros::NodeHandle& nh, 
   std::string topic_name, 
-  size_t buff_size
+  size_t buff_size,
+  bool lightweight
 ) :nh_(nh) {
-  subscriber_ = nh_.subscribe(topic_name, buff_size, &OdomSubscriber::msg_callback, this);
+  if (lightweight) {
+    subscriber_ = nh_.subscribe(topic_name, buff_size, &OdomSubscriber::data_callback, this);
+  } else {
+    subscriber_ = nh_.subscribe(topic_name, buff_size, &OdomSubscriber::msg_callback, this);
+  }
 }
 
 void OdomSubscriber::msg_callback(
   const nav_msgs::OdometryConstPtr& odom_msg_ptr
 ) {
-    buff_mutex_.lock();
-
     // convert ROS IMU to GeographicLib compatible GNSS message:
     OdomData odom_data;
     odom_data.time = odom_msg_ptr->header.stamp.toSec();
@@ -47,8 +51,23 @@ void OdomSubscriber::msg_callback(
       odom_msg_ptr->twist.twist.linear.z 
     );
 
+    AddData(odom_data);
+}
+
+void OdomSubscriber::data_callback(
+  const boost::shared_ptr<const OdomData>& odom_data_ptr
+) {
+    AddData(*odom_data_ptr);
+}
+
+void OdomSubscriber::AddData(const OdomData& odom_data) {
+    buff_mutex_.lock();
+
     // add new message to buffer:
     odom_data_.push_back(odom_data);
+
+    stats_.num_received.Add();
+    UpdateHighWaterMark(stats_.buffer_high_water_mark, odom_data_.size());
     
     buff_mutex_.unlock();
 }
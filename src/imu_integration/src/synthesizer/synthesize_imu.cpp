@@ -0,0 +1,476 @@
+/*
+ * @Description: IMU measurement synthesis from a recorded TUM trajectory, streamed into a bag or binary dataset
+ * @Date: 2026-10-18 14:12:37
+ */
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include <ros/ros.h>
+#include <rosbag/bag.h>
+#include <sensor_msgs/Imu.h>
+#include <nav_msgs/Odometry.h>
+
+#include "imu_integration/generator/motion_model.hpp"
+#include "imu_integration/tools/bspline_trajectory.hpp"
+
+#include "glog/logging.h"
+
+using namespace imu_integration;
+
+namespace {
+
+struct Options {
+    std::string input_path;
+    std::string output_path;
+    // output rates in Hz, odometry is only written to bags:
+    double imu_rate = 100.0;
+    double odom_rate = 100.0;
+    // added to every output stamp, in seconds:
+    double time_offset = 0.0;
+    std::string imu_topic = "/sim/sensor/imu";
+    std::string imu_frame_id = "imu_link";
+    std::string odom_topic = "/pose/ground_truth";
+    std::string odom_frame_id = "inertial";
+    Eigen::Vector3d G = Eigen::Vector3d(0.0, 0.0, -9.7942164704);
+    // initial biases:
+    Eigen::Vector3d angular_vel_bias = Eigen::Vector3d::Zero();
+    Eigen::Vector3d linear_acc_bias = Eigen::Vector3d::Zero();
+    bool add_noise = true;
+    unsigned int seed = 0;
+};
+
+//
+// binary dataset layout, little endian:
+//   FileHeader
+//   Record x num_records, one per IMU stamp
+//
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    double imu_rate;
+    double gravity[3];
+    uint64_t num_records;
+};
+
+struct Record {
+    double time;
+    // measurements in IMU frame:
+    double angular_velocity[3];
+    double linear_acceleration[3];
+    // ground truth in navigation frame, orientation as x, y, z, w:
+    double position[3];
+    double orientation[4];
+    double velocity[3];
+    // biases applied to the measurements:
+    double angular_velocity_bias[3];
+    double linear_acceleration_bias[3];
+};
+
+bool ParseVector(const char *value, Eigen::Vector3d &v) {
+    return sscanf(value, "%lf,%lf,%lf", &v.x(), &v.y(), &v.z()) == 3;
+}
+
+bool ParseOptions(int argc, char** argv, Options &options, BSplineTrajectory::Params &spline, generator::IMUNoise &noise) {
+    if (argc < 3) {
+        return false;
+    }
+
+    options.input_path = argv[1];
+    options.output_path = argv[2];
+
+    for (int i = 3; i < argc; ++i) {
+        const char *value = strchr(argv[i], '=');
+        if (strncmp(argv[i], "--", 2) != 0 || !value) {
+            return false;
+        }
+        const std::string key(argv[i] + 2, value - argv[i] - 2);
+        ++value;
+
+        if (key == "imu_rate") {
+            options.imu_rate = atof(value);
+        } else if (key == "odom_rate") {
+            options.odom_rate = atof(value);
+        } else if (key == "time_offset") {
+            options.time_offset = atof(value);
+        } else if (key == "imu_topic") {
+            options.imu_topic = value;
+        } else if (key == "imu_frame_id") {
+            options.imu_frame_id = value;
+        } else if (key == "odom_topic") {
+            options.odom_topic = value;
+        } else if (key == "odom_frame_id") {
+            options.odom_frame_id = value;
+        } else if (key == "gravity_z") {
+            options.G.z() = atof(value);
+        } else if (key == "gyro_bias") {
+            if (!ParseVector(value, options.angular_vel_bias)) {
+                return false;
+            }
+        } else if (key == "acc_bias") {
+            if (!ParseVector(value, options.linear_acc_bias)) {
+                return false;
+            }
+        } else if (key == "gyro_noise") {
+            noise.gyro_noise_stddev = atof(value);
+        } else if (key == "gyro_bias_noise") {
+            noise.gyro_bias_stddev = atof(value);
+        } else if (key == "acc_noise") {
+            noise.acc_noise_stddev = atof(value);
+        } else if (key == "acc_bias_noise") {
+            noise.acc_bias_stddev = atof(value);
+        } else if (key == "noise") {
+            options.add_noise = (atoi(value) != 0);
+        } else if (key == "seed") {
+            options.seed = strtoul(value, nullptr, 10);
+        } else if (key == "knot_spacing") {
+            spline.knot_spacing = atof(value);
+        } else if (key == "max_gap") {
+            spline.max_gap = atof(value);
+        } else if (key == "interpolate") {
+            spline.interpolate = (atoi(value) != 0);
+        } else {
+            return false;
+        }
+    }
+
+    return options.imu_rate > 0.0 && options.odom_rate > 0.0 && spline.knot_spacing > 0.0;
+}
+
+/**
+ * @brief  parse one TUM trajectory line, time x y z qx qy qz qw
+ * @param  line, input line
+ * @param  time, output stamp
+ * @param  pose, output pose
+ * @return true if a pose was parsed false for comments, blank or malformed lines
+ */
+bool ParseTum(const std::string &line, double &time, Eigen::Matrix4d &pose) {
+    if (line.empty() || line[0] == '#') {
+        return false;
+    }
+
+    std::istringstream iss(line);
+    double x, y, z, qx, qy, qz, qw;
+    if (!(iss >> time >> x >> y >> z >> qx >> qy >> qz >> qw)) {
+        return false;
+    }
+
+    const Eigen::Quaterniond q(qw, qx, qy, qz);
+    if (q.norm() < 1.0e-6) {
+        return false;
+    }
+
+    pose = Eigen::Matrix4d::Identity();
+    pose.block<3, 3>(0, 0) = q.normalized().toRotationMatrix();
+    pose.block<3, 1>(0, 3) = Eigen::Vector3d(x, y, z);
+
+    return true;
+}
+
+//
+// output sinks, records are written as soon as they are synthesized so that memory use does not
+// grow with trajectory length
+//
+class Writer {
+  public:
+    virtual ~Writer(void) {}
+    virtual bool WriteIMU(const Record &record) = 0;
+    virtual bool WriteOdom(double time, const BSplineTrajectory::State &state) = 0;
+    virtual bool Close(void) = 0;
+};
+
+class BagWriter : public Writer {
+  public:
+    explicit BagWriter(const Options &options) : options_(options) {
+        bag_.open(options_.output_path, rosbag::bagmode::Write);
+    }
+
+    bool WriteIMU(const Record &record) override {
+        ros::Time stamp;
+        if (!GetStamp(record.time, stamp)) {
+            return false;
+        }
+
+        message_imu_.header.stamp = stamp;
+        message_imu_.header.frame_id = options_.imu_frame_id;
+        message_imu_.orientation.x = record.orientation[0];
+        message_imu_.orientation.y = record.orientation[1];
+        message_imu_.orientation.z = record.orientation[2];
+        message_imu_.orientation.w = record.orientation[3];
+        message_imu_.angular_velocity.x = record.angular_velocity[0];
+        message_imu_.angular_velocity.y = record.angular_velocity[1];
+        message_imu_.angular_velocity.z = record.angular_velocity[2];
+        message_imu_.linear_acceleration.x = record.linear_acceleration[0];
+        message_imu_.linear_acceleration.y = record.linear_acceleration[1];
+        message_imu_.linear_acceleration.z = record.linear_acceleration[2];
+
+        bag_.write(options_.imu_topic, stamp, message_imu_);
+
+        return true;
+    }
+
+    bool WriteOdom(double time, const BSplineTrajectory::State &state) override {
+        ros::Time stamp;
+        if (!GetStamp(time, stamp)) {
+            return false;
+        }
+
+        Eigen::Quaterniond q(state.R);
+        message_odom_.header.stamp = stamp;
+        message_odom_.header.frame_id = options_.odom_frame_id;
+        message_odom_.child_frame_id = options_.odom_frame_id;
+        message_odom_.pose.pose.orientation.x = q.x();
+        message_odom_.pose.pose.orientation.y = q.y();
+        message_odom_.pose.pose.orientation.z = q.z();
+        message_odom_.pose.pose.orientation.w = q.w();
+        message_odom_.pose.pose.position.x = state.t.x();
+        message_odom_.pose.pose.position.y = state.t.y();
+        message_odom_.pose.pose.position.z = state.t.z();
+        message_odom_.twist.twist.linear.x = state.v.x();
+        message_odom_.twist.twist.linear.y = state.v.y();
+        message_odom_.twist.twist.linear.z = state.v.z();
+
+        bag_.write(options_.odom_topic, stamp, message_odom_);
+
+        return true;
+    }
+
+    bool Close(void) override {
+        bag_.close();
+        return true;
+    }
+
+  private:
+    bool GetStamp(double time, ros::Time &stamp) const {
+        // bag stamps cannot be negative:
+        if (time + options_.time_offset <= 0.0) {
+            LOG(WARNING) << "Non-positive stamp " << time + options_.time_offset << ", set --time_offset.";
+            return false;
+        }
+        stamp.fromSec(time + options_.time_offset);
+        return true;
+    }
+
+    const Options &options_;
+    rosbag::Bag bag_;
+    sensor_msgs::Imu message_imu_;
+    nav_msgs::Odometry message_odom_;
+};
+
+class BinaryWriter : public Writer {
+  public:
+    explicit BinaryWriter(const Options &options) : options_(options) {
+        file_ = fopen(options_.output_path.c_str(), "wb");
+        if (!file_) {
+            LOG(WARNING) << "Failed to create output file: " << options_.output_path;
+            return;
+        }
+
+        memcpy(header_.magic, "IMUSYNT1", sizeof(header_.magic));
+        header_.version = 1;
+        header_.reserved = 0;
+        header_.imu_rate = options_.imu_rate;
+        header_.gravity[0] = options_.G.x();
+        header_.gravity[1] = options_.G.y();
+        header_.gravity[2] = options_.G.z();
+        header_.num_records = 0;
+
+        // record count is patched on close:
+        if (fwrite(&header_, sizeof(header_), 1, file_) != 1) {
+            fclose(file_);
+            file_ = nullptr;
+        }
+    }
+
+    ~BinaryWriter(void) {
+        if (file_) {
+            fclose(file_);
+        }
+    }
+
+    bool IsOpen(void) const { return file_ != nullptr; }
+
+    bool WriteIMU(const Record &record) override {
+        Record output = record;
+        output.time += options_.time_offset;
+        if (fwrite(&output, sizeof(output), 1, file_) != 1) {
+            return false;
+        }
+        ++header_.num_records;
+
+        return true;
+    }
+
+    bool WriteOdom(double, const BSplineTrajectory::State &) override {
+        // ground truth is part of every record:
+        return true;
+    }
+
+    bool Close(void) override {
+        const bool success = (
+            fseek(file_, 0, SEEK_SET) == 0 &&
+            fwrite(&header_, sizeof(header_), 1, file_) == 1
+        );
+        const bool closed = (fclose(file_) == 0);
+        file_ = nullptr;
+
+        return success && closed;
+    }
+
+  private:
+    const Options &options_;
+    FILE *file_ = nullptr;
+    FileHeader header_;
+};
+
+bool EndsWith(const std::string &s, const std::string &suffix) {
+    return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    BSplineTrajectory::Params spline_params;
+    generator::IMUNoise noise;
+    if (!ParseOptions(argc, argv, options, spline_params, noise)) {
+        fprintf(
+            stderr,
+            "usage: %s input.txt output.{bag,bin} [--imu_rate=] [--odom_rate=] [--time_offset=]\n"
+            "       [--imu_topic=] [--imu_frame_id=] [--odom_topic=] [--odom_frame_id=] [--gravity_z=]\n"
+            "       [--gyro_bias=x,y,z] [--acc_bias=x,y,z] [--gyro_noise=] [--gyro_bias_noise=] [--acc_noise=] [--acc_bias_noise=]\n"
+            "       [--noise=0|1] [--seed=] [--knot_spacing=] [--max_gap=] [--interpolate=0|1]\n",
+            argv[0]
+        );
+        return EXIT_FAILURE;
+    }
+
+    std::ifstream input(options.input_path.c_str());
+    if (!input) {
+        LOG(WARNING) << "Failed to open input file: " << options.input_path;
+        return EXIT_FAILURE;
+    }
+
+    std::unique_ptr<Writer> writer;
+    if (EndsWith(options.output_path, ".bag")) {
+        writer.reset(new BagWriter(options));
+    } else {
+        BinaryWriter *binary_writer = new BinaryWriter(options);
+        writer.reset(binary_writer);
+        if (!binary_writer->IsOpen()) {
+            return EXIT_FAILURE;
+        }
+    }
+
+    // only the intervals added by the latest sample are evaluated, plus the output period
+    // left over from the previous one and the three-knot lag of segment completion:
+    const double imu_period = 1.0 / options.imu_rate;
+    const double odom_period = 1.0 / options.odom_rate;
+    spline_params.max_segments = static_cast<size_t>(
+        std::ceil((spline_params.max_gap + std::max(imu_period, odom_period)) / spline_params.knot_spacing)
+    ) + 4;
+    BSplineTrajectory spline(spline_params);
+
+    std::default_random_engine engine(options.seed);
+    std::normal_distribution<double> distribution(0.0, 1.0);
+    Eigen::Vector3d angular_vel_bias = options.angular_vel_bias;
+    Eigen::Vector3d linear_acc_bias = options.linear_acc_bias;
+
+    // output stamps are kept on a grid anchored at the start of each continuous piece:
+    bool is_started = false;
+    double anchor_time = 0.0;
+    size_t imu_index = 0, odom_index = 0;
+    double imu_time_prev = 0.0;
+    size_t num_lines = 0, num_skipped = 0, num_imu = 0, num_odom = 0, num_restarts = 0;
+
+    std::string line;
+    while (std::getline(input, line)) {
+        ++num_lines;
+
+        double time;
+        Eigen::Matrix4d pose;
+        if (!ParseTum(line, time, pose)) {
+            continue;
+        }
+        if (!spline.AddPose(time, pose)) {
+            ++num_skipped;
+            continue;
+        }
+        if (0 == spline.GetNumSegments()) {
+            continue;
+        }
+
+        // new continuous piece, at start or once a gap has restarted the spline:
+        if (!is_started || anchor_time + imu_index * imu_period < spline.GetStartTime()) {
+            num_restarts += is_started ? 1 : 0;
+            is_started = true;
+            anchor_time = spline.GetStartTime();
+            imu_index = odom_index = 0;
+            imu_time_prev = anchor_time - imu_period;
+        }
+
+        // everything the spline covers by now:
+        BSplineTrajectory::State state;
+        for (double imu_time = anchor_time + imu_index * imu_period; spline.Evaluate(imu_time, state); imu_time = anchor_time + imu_index * imu_period) {
+            Eigen::Vector3d angular_vel = state.angular_vel;
+            Eigen::Vector3d linear_acc = state.R.transpose() * (state.a + options.G);
+            if (options.add_noise) {
+                generator::AddNoise(
+                    noise, imu_time - imu_time_prev, engine, distribution,
+                    angular_vel_bias, linear_acc_bias,
+                    angular_vel, linear_acc
+                );
+            }
+
+            Record record;
+            const Eigen::Quaterniond q(state.R);
+            record.time = imu_time;
+            for (int i = 0; i < 3; ++i) {
+                record.angular_velocity[i] = angular_vel(i);
+                record.linear_acceleration[i] = linear_acc(i);
+                record.position[i] = state.t(i);
+                record.velocity[i] = state.v(i);
+                record.angular_velocity_bias[i] = options.add_noise ? angular_vel_bias(i) : 0.0;
+                record.linear_acceleration_bias[i] = options.add_noise ? linear_acc_bias(i) : 0.0;
+            }
+            record.orientation[0] = q.x();
+            record.orientation[1] = q.y();
+            record.orientation[2] = q.z();
+            record.orientation[3] = q.w();
+
+            if (!writer->WriteIMU(record)) {
+                return EXIT_FAILURE;
+            }
+            imu_time_prev = imu_time;
+            ++imu_index;
+            ++num_imu;
+        }
+        for (double odom_time = anchor_time + odom_index * odom_period; spline.Evaluate(odom_time, state); odom_time = anchor_time + odom_index * odom_period) {
+            if (!writer->WriteOdom(odom_time, state)) {
+                return EXIT_FAILURE;
+            }
+            ++odom_index;
+            ++num_odom;
+        }
+    }
+
+    if (!writer->Close()) {
+        LOG(WARNING) << "Failed to finalize output file: " << options.output_path;
+        return EXIT_FAILURE;
+    }
+
+    LOG(INFO) << num_lines << " lines read, " << num_skipped << " out of order poses skipped, "
+              << num_restarts << " restarts on gaps, "
+              << num_imu << " IMU measurements and " << num_odom << " odometry written";
+
+    return num_imu > 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,185 @@
+/*
+ * @Description: continuous-time trajectory as a cumulative cubic B-spline, built from a pose stream
+ * @Date: 2026-10-18 09:26:14
+ */
+#include "imu_integration/tools/bspline_trajectory.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "imu_integration/estimator/so3.hpp"
+
+namespace imu_integration {
+
+namespace {
+
+// tolerance of knot placement against sample stamps, in seconds:
+const double kTimeTolerance = 1.0e-9;
+
+}  // namespace
+
+BSplineTrajectory::BSplineTrajectory(const Params &params) : params_(params) {
+}
+
+void BSplineTrajectory::Reset(void) {
+    has_sample_ = false;
+    num_knots_ = num_control_points_ = 0;
+    knots_.clear();
+    control_points_.clear();
+    segments_.clear();
+    first_segment_ = 0;
+}
+
+bool BSplineTrajectory::AddPose(double time, const Eigen::Matrix4d &pose) {
+    if (has_sample_ && time <= sample_time_) {
+        return false;
+    }
+
+    Knot sample;
+    sample.R = pose.block<3, 3>(0, 0);
+    sample.t = pose.block<3, 1>(0, 3);
+
+    if (has_sample_ && time - sample_time_ > params_.max_gap) {
+        Reset();
+    }
+
+    if (!has_sample_) {
+        // first knot at first sample:
+        start_time_ = time;
+        AddKnot(sample);
+    } else {
+        // knots up to the new sample, slerp and lerp from the previous one:
+        const double duration = time - sample_time_;
+        const Eigen::Vector3d delta_phi = estimator::Log(sample_.R.transpose() * sample.R);
+        const Eigen::Vector3d delta_t = sample.t - sample_.t;
+
+        for (double knot_time = GetKnotTime(num_knots_); knot_time <= time + kTimeTolerance; knot_time = GetKnotTime(num_knots_)) {
+            const double s = std::min((knot_time - sample_time_) / duration, 1.0);
+
+            Knot knot;
+            knot.R = sample_.R * estimator::Exp(s * delta_phi);
+            knot.t = sample_.t + s * delta_t;
+            AddKnot(knot);
+        }
+    }
+
+    has_sample_ = true;
+    sample_time_ = time;
+    sample_ = sample;
+
+    return true;
+}
+
+void BSplineTrajectory::AddKnot(const Knot &knot) {
+    ++num_knots_;
+    knots_.push_back(knot);
+
+    // knot 0 has no left neighbor and gets no control point, so the spline starts at knot 2:
+    if (knots_.size() < 3) {
+        return;
+    }
+
+    // quasi-interpolation, c = p - (p- - 2p + p+) / 6, with the second difference in tangent space at p:
+    const Knot &prev = knots_.at(0);
+    const Knot &curr = knots_.at(1);
+    const Knot &next = knots_.at(2);
+
+    Knot control_point = curr;
+    if (params_.interpolate) {
+        control_point.R = curr.R * estimator::Exp(
+            -(estimator::Log(curr.R.transpose() * prev.R) + estimator::Log(curr.R.transpose() * next.R)) / 6.0
+        );
+        control_point.t = curr.t - (prev.t - 2.0 * curr.t + next.t) / 6.0;
+    }
+    AddControlPoint(control_point);
+
+    knots_.pop_front();
+}
+
+void BSplineTrajectory::AddControlPoint(const Knot &control_point) {
+    ++num_control_points_;
+    control_points_.push_back(control_point);
+
+    if (control_points_.size() < 4) {
+        return;
+    }
+
+    // control points i - 1 to i + 2 define segment i, control point k is taken at knot k from 1 on:
+    Segment segment;
+    segment.R = control_points_.at(0).R;
+    segment.t = control_points_.at(0).t;
+    for (int j = 0; j < 3; ++j) {
+        const Knot &prev = control_points_.at(j);
+        const Knot &next = control_points_.at(j + 1);
+
+        segment.delta_t[j] = next.t - prev.t;
+        segment.delta_phi[j] = estimator::Log(prev.R.transpose() * next.R);
+    }
+
+    if (segments_.empty()) {
+        first_segment_ = num_control_points_ - 2;
+    }
+    segments_.push_back(segment);
+
+    if (params_.max_segments > 0 && segments_.size() > params_.max_segments) {
+        segments_.pop_front();
+        ++first_segment_;
+    }
+
+    control_points_.pop_front();
+}
+
+bool BSplineTrajectory::Evaluate(double time, State &state) const {
+    if (!IsInRange(time)) {
+        return false;
+    }
+
+    const double dt = params_.knot_spacing;
+
+    // locate knot interval, the end time belongs to the last one:
+    const double s = (time - start_time_) / dt;
+    size_t index = static_cast<size_t>(std::floor(s));
+    index = std::max(index, first_segment_);
+    index = std::min(index, first_segment_ + segments_.size() - 1);
+
+    const Segment &segment = segments_.at(index - first_segment_);
+    const double u = s - index;
+    const double u2 = u * u;
+    const double u3 = u2 * u;
+
+    // cumulative cubic basis and its derivatives by time:
+    const double B[3] = {
+        (5.0 + 3.0 * u - 3.0 * u2 + u3) / 6.0,
+        (1.0 + 3.0 * u + 3.0 * u2 - 2.0 * u3) / 6.0,
+        u3 / 6.0
+    };
+    const double dB[3] = {
+        (0.5 - u + 0.5 * u2) / dt,
+        (0.5 + u - u2) / dt,
+        0.5 * u2 / dt
+    };
+    const double ddB[3] = {
+        (u - 1.0) / (dt * dt),
+        (1.0 - 2.0 * u) / (dt * dt),
+        u / (dt * dt)
+    };
+
+    state.t = segment.t;
+    state.v = state.a = Eigen::Vector3d::Zero();
+    state.R = segment.R;
+    state.angular_vel = Eigen::Vector3d::Zero();
+    for (int j = 0; j < 3; ++j) {
+        state.t += B[j] * segment.delta_t[j];
+        state.v += dB[j] * segment.delta_t[j];
+        state.a += ddB[j] * segment.delta_t[j];
+
+        // R = R0 * prod(A_j), with body frame angular velocity propagated through each factor:
+        const Eigen::Matrix3d A = estimator::Exp(B[j] * segment.delta_phi[j]);
+        state.R = state.R * A;
+        state.angular_vel = A.transpose() * state.angular_vel + dB[j] * segment.delta_phi[j];
+    }
+
+    return true;
+}
+
+} // namespace imu_integration
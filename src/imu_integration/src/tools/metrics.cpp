@@ -0,0 +1,285 @@
+/*
+ * @Description: Prometheus text exposition of runtime counters and histograms
+ * @Date: 2026-10-18 11:21:05
+ */
+#include "imu_integration/tools/metrics.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "glog/logging.h"
+
+namespace imu_integration {
+
+namespace {
+
+// exported bucket bounds in seconds:
+const double kHistogramBounds[] = {
+    1.0e-6, 2.5e-6, 5.0e-6,
+    1.0e-5, 2.5e-5, 5.0e-5,
+    1.0e-4, 2.5e-4, 5.0e-4,
+    1.0e-3, 2.5e-3, 5.0e-3,
+    1.0e-2, 2.5e-2, 5.0e-2,
+    1.0e-1, 2.5e-1, 5.0e-1,
+    1.0
+};
+
+std::string GetSeriesName(const std::string &name, const std::string &labels) {
+    return labels.empty() ? name : name + "{" + labels + "}";
+}
+
+std::string JoinLabels(const std::string &labels, const std::string &label) {
+    return labels.empty() ? label : labels + "," + label;
+}
+
+} // namespace
+
+void MetricsRegistry::AddCounter(
+    const std::string &name, const std::string &help, const std::string &labels,
+    const ShardedCounter *counter
+) {
+    Metric metric;
+    metric.type = Type::COUNTER;
+    metric.name = name;
+    metric.help = help;
+    metric.labels = labels;
+    metric.counter = counter;
+    metrics_.push_back(metric);
+}
+
+void MetricsRegistry::AddGauge(
+    const std::string &name, const std::string &help, const std::string &labels,
+    const std::function<double(void)> &getter
+) {
+    Metric metric;
+    metric.type = Type::GAUGE;
+    metric.name = name;
+    metric.help = help;
+    metric.labels = labels;
+    metric.getter = getter;
+    metrics_.push_back(metric);
+}
+
+void MetricsRegistry::AddHistogram(
+    const std::string &name, const std::string &help, const std::string &labels,
+    const LatencyHistogram *histogram
+) {
+    Metric metric;
+    metric.type = Type::HISTOGRAM;
+    metric.name = name;
+    metric.help = help;
+    metric.labels = labels;
+    metric.histogram = histogram;
+    metrics_.push_back(metric);
+}
+
+std::string MetricsRegistry::Render(void) const {
+    std::ostringstream oss;
+    oss.precision(9);
+
+    LatencyHistogram::Snapshot snapshot;
+    std::string prev_name;
+    for (const Metric &metric: metrics_) {
+        // HELP and TYPE once per metric family, series of one family are registered consecutively:
+        if (metric.name != prev_name) {
+            static const char *kTypeNames[] = {"counter", "gauge", "histogram"};
+            oss << "# HELP " << metric.name << " " << metric.help << "\n"
+                << "# TYPE " << metric.name << " " << kTypeNames[static_cast<int>(metric.type)] << "\n";
+            prev_name = metric.name;
+        }
+
+        switch (metric.type) {
+            case Type::COUNTER:
+                oss << GetSeriesName(metric.name, metric.labels) << " " << metric.counter->Get() << "\n";
+                break;
+            case Type::GAUGE:
+                oss << GetSeriesName(metric.name, metric.labels) << " " << metric.getter() << "\n";
+                break;
+            case Type::HISTOGRAM: {
+                metric.histogram->GetSnapshot(snapshot);
+
+                // cumulative counts of fine buckets that end below each exported bound:
+                uint64_t cumulative = 0;
+                int index = 0;
+                for (const double bound: kHistogramBounds) {
+                    const uint64_t bound_ns = static_cast<uint64_t>(bound * 1.0e9);
+                    while (
+                        index + 1 < LatencyHistogram::kNumBuckets &&
+                        LatencyHistogram::GetBucketLowerBound(index + 1) <= bound_ns
+                    ) {
+                        cumulative += snapshot.counts[index++];
+                    }
+                    std::ostringstream le;
+                    le << "le=\"" << bound << "\"";
+                    oss << GetSeriesName(metric.name + "_bucket", JoinLabels(metric.labels, le.str()))
+                        << " " << cumulative << "\n";
+                }
+
+                const uint64_t total = snapshot.GetTotal();
+                oss << GetSeriesName(metric.name + "_bucket", JoinLabels(metric.labels, "le=\"+Inf\""))
+                    << " " << total << "\n"
+                    << GetSeriesName(metric.name + "_sum", metric.labels) << " " << 1.0e-9 * snapshot.sum << "\n"
+                    << GetSeriesName(metric.name + "_count", metric.labels) << " " << total << "\n";
+                break;
+            }
+        }
+    }
+
+    return oss.str();
+}
+
+MetricsExporter::MetricsExporter(const MetricsRegistry &registry)
+    : registry_(registry) {}
+
+MetricsExporter::~MetricsExporter(void) {
+    Stop();
+}
+
+bool MetricsExporter::Start(int port, const std::string &textfile_path, double period) {
+    if (running_) {
+        return true;
+    }
+
+    if (port > 0) {
+        listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+        if (listen_fd_ < 0) {
+            LOG(WARNING) << "Failed to create metrics socket.";
+            return false;
+        }
+
+        int enable = 1;
+        setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+        // localhost only:
+        struct sockaddr_in address;
+        address.sin_family = AF_INET;
+        address.sin_port = htons(static_cast<uint16_t>(port));
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        if (
+            bind(listen_fd_, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)) < 0 ||
+            listen(listen_fd_, 4) < 0
+        ) {
+            LOG(WARNING) << "Failed to serve metrics on 127.0.0.1:" << port;
+            close(listen_fd_);
+            listen_fd_ = -1;
+            return false;
+        }
+    }
+
+    textfile_path_ = textfile_path;
+    period_ = period;
+
+    if (listen_fd_ < 0 && textfile_path_.empty()) {
+        return false;
+    }
+
+    running_ = true;
+    thread_ = std::thread(&MetricsExporter::Loop, this);
+
+    return true;
+}
+
+void MetricsExporter::Stop(void) {
+    if (!running_) {
+        return;
+    }
+
+    running_ = false;
+    thread_.join();
+
+    if (listen_fd_ >= 0) {
+        close(listen_fd_);
+        listen_fd_ = -1;
+    }
+}
+
+void MetricsExporter::Loop(void) {
+    // wake up often enough to stop promptly:
+    const int timeout_ms = std::min(200, static_cast<int>(1000.0 * period_));
+    auto next_write = std::chrono::steady_clock::now();
+
+    while (running_) {
+        if (!textfile_path_.empty() && std::chrono::steady_clock::now() >= next_write) {
+            WriteTextfile();
+            next_write += std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(period_)
+            );
+        }
+
+        if (listen_fd_ < 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(timeout_ms));
+            continue;
+        }
+
+        struct pollfd fds;
+        fds.fd = listen_fd_;
+        fds.events = POLLIN;
+        if (poll(&fds, 1, timeout_ms) > 0 && (fds.revents & POLLIN)) {
+            int client_fd = accept(listen_fd_, nullptr, nullptr);
+            if (client_fd >= 0) {
+                ServeClient(client_fd);
+                close(client_fd);
+            }
+        }
+    }
+}
+
+void MetricsExporter::ServeClient(int client_fd) {
+    // bound the time a stalled client can block the exporter:
+    struct timeval timeout;
+    timeout.tv_sec = 0;
+    timeout.tv_usec = 200000;
+    setsockopt(client_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(client_fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    // every request gets the metrics page, only the request head is consumed:
+    char request[1024];
+    if (recv(client_fd, request, sizeof(request), 0) <= 0) {
+        return;
+    }
+
+    const std::string body = registry_.Render();
+    std::ostringstream response;
+    response << "HTTP/1.0 200 OK\r\n"
+             << "Content-Type: text/plain; version=0.0.4\r\n"
+             << "Content-Length: " << body.size() << "\r\n"
+             << "Connection: close\r\n\r\n"
+             << body;
+
+    const std::string data = response.str();
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = send(client_fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) {
+            return;
+        }
+        sent += static_cast<size_t>(n);
+    }
+}
+
+void MetricsExporter::WriteTextfile(void) {
+    // write then rename, so that the collector never reads a partial file:
+    const std::string tmp_path = textfile_path_ + ".tmp";
+    {
+        std::ofstream ofs(tmp_path.c_str(), std::ios::out | std::ios::trunc);
+        if (!ofs) {
+            LOG(WARNING) << "Failed to write metrics file: " << tmp_path;
+            return;
+        }
+        ofs << registry_.Render();
+    }
+    std::rename(tmp_path.c_str(), textfile_path_.c_str());
+}
+
+} // namespace imu_integration
@@ -0,0 +1,104 @@
+/*
+ * @Description: runtime reload of IMU bias, gravity and noise parameters
+ * @Date: 2026-10-18 16:45:30
+ */
+#include "imu_integration/tools/param_watcher.hpp"
+
+#include <sstream>
+
+#include "glog/logging.h"
+
+namespace imu_integration {
+
+IMUParamsWatcher::IMUParamsWatcher(
+  ros::NodeHandle& nh, 
+  const IMUParams& params
+) : nh_(nh), params_curr_(params), params_(params) {
+    // the initial parameters are already applied by the owner:
+    version_ = params_.GetVersion();
+
+    service_ = nh_.advertiseService("reload_imu_params", &IMUParamsWatcher::ReloadCallback, this);
+}
+
+bool IMUParamsWatcher::ReloadCallback(
+    std_srvs::Trigger::Request& request, 
+    std_srvs::Trigger::Response& response
+) {
+    IMUParams& params = params_curr_;
+
+    // a. gravity constant:
+    nh_.param("imu/gravity/x", params.gravity.x, params.gravity.x);
+    nh_.param("imu/gravity/y", params.gravity.y, params.gravity.y);
+    nh_.param("imu/gravity/z", params.gravity.z, params.gravity.z);
+
+    // b. angular velocity bias:
+    nh_.param("imu/bias/angular_velocity/x", params.bias.angular_velocity.x, params.bias.angular_velocity.x);
+    nh_.param("imu/bias/angular_velocity/y", params.bias.angular_velocity.y, params.bias.angular_velocity.y);
+    nh_.param("imu/bias/angular_velocity/z", params.bias.angular_velocity.z, params.bias.angular_velocity.z);
+
+    // c. linear acceleration bias:
+    nh_.param("imu/bias/linear_acceleration/x", params.bias.linear_acceleration.x, params.bias.linear_acceleration.x);
+    nh_.param("imu/bias/linear_acceleration/y", params.bias.linear_acceleration.y, params.bias.linear_acceleration.y);
+    nh_.param("imu/bias/linear_acceleration/z", params.bias.linear_acceleration.z, params.bias.linear_acceleration.z);
+
+    // d. random noises:
+    nh_.param("imu/gyro/sigma_bias", params.gyro_bias_stddev, params.gyro_bias_stddev);
+    nh_.param("imu/gyro/sigma_noise", params.gyro_noise_stddev, params.gyro_noise_stddev);
+    nh_.param("imu/acc/sigma_bias", params.acc_bias_stddev, params.acc_bias_stddev);
+    nh_.param("imu/acc/sigma_noise", params.acc_noise_stddev, params.acc_noise_stddev);
+
+    params_.Store(params);
+
+    std::ostringstream oss;
+    oss << "IMU params reloaded, version " << params_.GetVersion() / 2;
+    response.success = true;
+    response.message = oss.str();
+
+    LOG(INFO) << response.message;
+
+    return true;
+}
+
+IMUParams IMUParamsWatcher::GetParams(const IMUConfig& config) {
+    IMUParams params;
+
+    params.gravity.x = config.gravity.x;
+    params.gravity.y = config.gravity.y;
+    params.gravity.z = config.gravity.z;
+
+    params.bias.angular_velocity.x = config.bias.angular_velocity.x;
+    params.bias.angular_velocity.y = config.bias.angular_velocity.y;
+    params.bias.angular_velocity.z = config.bias.angular_velocity.z;
+
+    params.bias.linear_acceleration.x = config.bias.linear_acceleration.x;
+    params.bias.linear_acceleration.y = config.bias.linear_acceleration.y;
+    params.bias.linear_acceleration.z = config.bias.linear_acceleration.z;
+
+    params.gyro_bias_stddev = config.gyro_bias_stddev;
+    params.gyro_noise_stddev = config.gyro_noise_stddev;
+    params.acc_bias_stddev = config.acc_bias_stddev;
+    params.acc_noise_stddev = config.acc_noise_stddev;
+
+    return params;
+}
+
+void IMUParamsWatcher::SetParams(const IMUParams& params, IMUConfig& config) {
+    config.gravity.x = params.gravity.x;
+    config.gravity.y = params.gravity.y;
+    config.gravity.z = params.gravity.z;
+
+    config.bias.angular_velocity.x = params.bias.angular_velocity.x;
+    config.bias.angular_velocity.y = params.bias.angular_velocity.y;
+    config.bias.angular_velocity.z = params.bias.angular_velocity.z;
+
+    config.bias.linear_acceleration.x = params.bias.linear_acceleration.x;
+    config.bias.linear_acceleration.y = params.bias.linear_acceleration.y;
+    config.bias.linear_acceleration.z = params.bias.linear_acceleration.z;
+
+    config.gyro_bias_stddev = params.gyro_bias_stddev;
+    config.gyro_noise_stddev = params.gyro_noise_stddev;
+    config.acc_bias_stddev = params.acc_bias_stddev;
+    config.acc_noise_stddev = params.acc_noise_stddev;
+}
+
+} // namespace imu_integration
@@ -0,0 +1,114 @@
+/*
+ * @Description: hardware performance counters through perf_event_open
+ * @Date: 2026-10-18 09:40:12
+ */
+#include "imu_integration/tools/perf_counters.hpp"
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+namespace imu_integration {
+
+namespace {
+
+int OpenCounter(uint32_t type, uint64_t config, int group_fd) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = (group_fd < 0) ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+
+    // this thread, any cpu:
+    return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+
+uint64_t GetWallClock(void) {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()
+        ).count()
+    );
+}
+
+} // namespace
+
+PerfCounters::PerfCounters(void) {
+    static const uint64_t kConfigs[NUM_COUNTERS] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES
+    };
+
+    for (int i = 0; i < NUM_COUNTERS; ++i) {
+        fds_[i] = OpenCounter(PERF_TYPE_HARDWARE, kConfigs[i], group_fd_);
+
+        if (fds_[i] < 0) {
+            error_ = std::string("perf_event_open failed: ") + strerror(errno);
+            // release the partial group, fall back to wall clock only:
+            for (int j = 0; j < i; ++j) {
+                close(fds_[j]);
+                fds_[j] = -1;
+            }
+            group_fd_ = -1;
+            return;
+        }
+
+        if (0 == i) {
+            group_fd_ = fds_[i];
+        }
+    }
+}
+
+PerfCounters::~PerfCounters(void) {
+    if (IsAvailable()) {
+        for (int i = 0; i < NUM_COUNTERS; ++i) {
+            close(fds_[i]);
+        }
+    }
+}
+
+void PerfCounters::Start(void) {
+    if (IsAvailable()) {
+        ioctl(group_fd_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(group_fd_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+    start_ns_ = GetWallClock();
+}
+
+bool PerfCounters::Stop(PerfCounterValues &values) {
+    values = PerfCounterValues();
+    values.elapsed_ns = GetWallClock() - start_ns_;
+
+    if (!IsAvailable()) {
+        return false;
+    }
+
+    ioctl(group_fd_, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    // PERF_FORMAT_GROUP layout: nr, then one value per counter:
+    uint64_t buffer[1 + NUM_COUNTERS];
+    const ssize_t expected = sizeof(buffer);
+    if (read(group_fd_, buffer, sizeof(buffer)) != expected || NUM_COUNTERS != buffer[0]) {
+        return false;
+    }
+
+    values.cycles = buffer[1 + CYCLES];
+    values.instructions = buffer[1 + INSTRUCTIONS];
+    values.cache_misses = buffer[1 + CACHE_MISSES];
+    values.branch_misses = buffer[1 + BRANCH_MISSES];
+
+    return true;
+}
+
+} // namespace imu_integration
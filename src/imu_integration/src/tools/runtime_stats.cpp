@@ -0,0 +1,87 @@
+/*
+ * @Description: lock-free runtime counters and latency histograms
+ * @Date: 2026-10-18 15:02:27
+ */
+#include "imu_integration/tools/runtime_stats.hpp"
+
+namespace imu_integration {
+
+int ShardedCounter::GetShardIndex(void) {
+    static std::atomic<int> next_index{0};
+    static thread_local int index = next_index.fetch_add(1, std::memory_order_relaxed) % kNumShards;
+
+    return index;
+}
+
+LatencyHistogram::LatencyHistogram(void) {
+    for (int i = 0; i < kNumBuckets; ++i) {
+        counts_[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void LatencyHistogram::GetSnapshot(Snapshot &snapshot) const {
+    for (int i = 0; i < kNumBuckets; ++i) {
+        snapshot.counts[i] = counts_[i].load(std::memory_order_relaxed);
+    }
+    snapshot.sum = sum_.load(std::memory_order_relaxed);
+}
+
+int LatencyHistogram::GetBucketIndex(uint64_t duration_ns) {
+    if (duration_ns < 4) {
+        return static_cast<int>(duration_ns);
+    }
+
+    // position of the most significant bit, then the next two bits select the sub-bucket:
+    const int msb = 63 - __builtin_clzll(duration_ns);
+    const int sub = static_cast<int>((duration_ns >> (msb - 2)) & 3);
+
+    return 4*(msb - 1) + sub;
+}
+
+uint64_t LatencyHistogram::GetBucketLowerBound(int index) {
+    if (index < 4) {
+        return static_cast<uint64_t>(index);
+    }
+
+    const int msb = index / 4 + 1;
+    const uint64_t sub = static_cast<uint64_t>(index % 4);
+
+    return (4 + sub) << (msb - 2);
+}
+
+uint64_t LatencyHistogram::Snapshot::GetTotal(void) const {
+    uint64_t total = 0;
+    for (int i = 0; i < kNumBuckets; ++i) {
+        total += counts[i];
+    }
+    return total;
+}
+
+double LatencyHistogram::Snapshot::GetPercentile(double p) const {
+    const uint64_t total = GetTotal();
+    if (0 == total) {
+        return 0.0;
+    }
+
+    const double rank = p * total;
+    uint64_t cumulative = 0;
+    for (int i = 0; i < kNumBuckets; ++i) {
+        cumulative += counts[i];
+        if (cumulative > 0 && cumulative >= rank) {
+            return (i + 1 < kNumBuckets) ? GetBucketLowerBound(i + 1) : GetBucketLowerBound(i);
+        }
+    }
+
+    return GetBucketLowerBound(kNumBuckets - 1);
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::Snapshot::operator-(const Snapshot &prev) const {
+    Snapshot diff;
+    for (int i = 0; i < kNumBuckets; ++i) {
+        diff.counts[i] = counts[i] - prev.counts[i];
+    }
+    diff.sum = sum - prev.sum;
+    return diff;
+}
+
+} // namespace imu_integration
@@ -0,0 +1,66 @@
+/*
+ * @Description: latest navigation state broadcast through a shared memory seqlock
+ * @Date: 2026-10-18 09:41:18
+ */
+#include "imu_integration/tools/shared_state.hpp"
+
+#include <new>
+
+#include "glog/logging.h"
+
+namespace imu_integration {
+
+SharedStateWriter::SharedStateWriter(const std::string &name)
+    : name_(name) {}
+
+SharedStateWriter::~SharedStateWriter(void) {
+    if (segment_) {
+        munmap(segment_, sizeof(SharedStateSegment));
+        shm_unlink(name_.c_str());
+    }
+}
+
+bool SharedStateWriter::Open(void) {
+    if (segment_) {
+        return true;
+    }
+
+    // a stale segment from a previous run is replaced, not reused:
+    shm_unlink(name_.c_str());
+    const int fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        LOG(WARNING) << "Failed to create shared memory segment " << name_;
+        return false;
+    }
+    if (ftruncate(fd, sizeof(SharedStateSegment)) < 0) {
+        LOG(WARNING) << "Failed to size shared memory segment " << name_;
+        close(fd);
+        shm_unlink(name_.c_str());
+        return false;
+    }
+    void *address = mmap(nullptr, sizeof(SharedStateSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED) {
+        LOG(WARNING) << "Failed to map shared memory segment " << name_;
+        shm_unlink(name_.c_str());
+        return false;
+    }
+
+    SharedStateSegment *segment = static_cast<SharedStateSegment *>(address);
+    new (&segment->state) SeqLock<SharedNavState>();
+    if (!segment->state.IsLockFree()) {
+        LOG(WARNING) << "Shared memory seqlock needs lock-free 64-bit atomics.";
+        munmap(address, sizeof(SharedStateSegment));
+        shm_unlink(name_.c_str());
+        return false;
+    }
+    // readers accept the segment from now on:
+    new (&segment->magic) std::atomic<uint64_t>(0);
+    segment->magic.store(SharedStateSegment::kMagic, std::memory_order_release);
+
+    segment_ = segment;
+
+    return true;
+}
+
+} // namespace imu_integration
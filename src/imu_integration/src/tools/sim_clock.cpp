@@ -0,0 +1,179 @@
+/*
+ * @Description: lockstep simulated time, /clock server and consumer acknowledgement
+ * @Date: 2026-10-18 10:14:26
+ */
+#include "imu_integration/tools/sim_clock.hpp"
+
+#include <rosgraph_msgs/Clock.h>
+
+#include "glog/logging.h"
+
+namespace imu_integration {
+
+// stamps pass through ros::Time, allow for its nanosecond rounding:
+static const double kAckTolerance = 1.0e-6;
+
+SimClockServer::SimClockServer(
+    ros::NodeHandle &nh,
+    const Params &params
+) : params_(params), nh_(nh), time_(params.start_time) {
+    pub_clock_ = nh_.advertise<rosgraph_msgs::Clock>("/clock", 10);
+
+    ros::NodeHandle ack_nh;
+    ack_nh.setCallbackQueue(&ack_queue_);
+    sub_ack_ = ack_nh.subscribe(
+        params_.ack_topic, 1000, &SimClockServer::AckCallback, this, ros::TransportHints().tcpNoDelay()
+    );
+}
+
+bool SimClockServer::WaitForConsumers(const std::vector<ros::Publisher> &publishers) {
+    LOG(INFO) << "Simulated clock waiting for " << params_.consumers.size() << " consumers on " << params_.ack_topic;
+
+    while (ros::ok()) {
+        PublishClock();
+
+        ack_queue_.callAvailable(ros::WallDuration(0.1));
+
+        bool connected = true;
+        for (const ros::Publisher &publisher: publishers) {
+            connected = connected && (publisher.getNumSubscribers() > 0);
+        }
+
+        if (connected && HasAllConsumers()) {
+            LOG(INFO) << "Simulated clock started at " << params_.start_time << " s";
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void SimClockServer::Advance(double time) {
+    time_ = time;
+    num_steps_.Add();
+
+    PublishClock();
+}
+
+bool SimClockServer::WaitForAcks(void) {
+    const double start = ros::WallTime::now().toSec();
+
+    while (!HasAllAcks()) {
+        if (!ros::ok()) {
+            return false;
+        }
+
+        const double elapsed = ros::WallTime::now().toSec() - start;
+        if (params_.ack_timeout > 0.0 && elapsed > params_.ack_timeout) {
+            num_timeouts_.Add();
+            LOG(WARNING) << "Simulated clock step " << time_ << " s not acknowledged within "
+                         << params_.ack_timeout << " s, advancing anyway";
+            return false;
+        }
+
+        // returns as soon as an acknowledgement arrives:
+        ack_queue_.callAvailable(ros::WallDuration(0.001));
+    }
+
+    ack_wait_.Record(static_cast<uint64_t>(1.0e9 * (ros::WallTime::now().toSec() - start)));
+
+    return true;
+}
+
+void SimClockServer::PublishClock(void) {
+    rosgraph_msgs::Clock message_clock;
+    message_clock.clock = GetTime();
+
+    pub_clock_.publish(message_clock);
+}
+
+void SimClockServer::AckCallback(const std_msgs::HeaderConstPtr &ack_ptr) {
+    // node and topic names never contain ':'
+    const size_t separator = ack_ptr->frame_id.find(':');
+    if (separator == std::string::npos) {
+        LOG(WARNING) << "Simulated clock acknowledgement " << ack_ptr->frame_id << " is not <node name>:<topic>";
+        return;
+    }
+
+    const std::string consumer = ack_ptr->frame_id.substr(0, separator);
+    const std::string topic = ack_ptr->frame_id.substr(separator + 1);
+
+    if (acks_.find(consumer) == acks_.end()) {
+        LOG(INFO) << "Simulated clock consumer " << consumer << " registered";
+    }
+
+    std::map<std::string, double> &acks = acks_[consumer];
+    std::map<std::string, double>::iterator it = acks.find(topic);
+    if (it == acks.end()) {
+        acks[topic] = ack_ptr->stamp.toSec();
+    } else if (ack_ptr->stamp.toSec() > it->second) {
+        it->second = ack_ptr->stamp.toSec();
+    }
+}
+
+bool SimClockServer::HasAllConsumers(void) const {
+    for (const std::string &consumer: params_.consumers) {
+        if (acks_.find(consumer) == acks_.end()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool SimClockServer::HasAllAcks(void) const {
+    for (const std::string &consumer: params_.consumers) {
+        std::map<std::string, std::map<std::string, double>>::const_iterator acks = acks_.find(consumer);
+        if (acks == acks_.end()) {
+            return false;
+        }
+
+        for (const std::pair<const std::string, double> &ack: acks->second) {
+            std::map<std::string, double>::const_iterator published = published_.find(ack.first);
+            if (published != published_.end() && ack.second < published->second - kAckTolerance) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+SimClockAck::SimClockAck(
+    ros::NodeHandle &nh,
+    const std::string &ack_topic,
+    const std::vector<std::string> &topics,
+    double heartbeat_period
+) : heartbeat_period_(heartbeat_period) {
+    pub_ack_ = nh.advertise<std_msgs::Header>(ack_topic, 100);
+
+    acks_.resize(topics.size());
+    for (size_t i = 0; i < topics.size(); ++i) {
+        acks_.at(i).frame_id = ros::this_node::getName() + ":" + nh.resolveName(topics.at(i));
+    }
+}
+
+void SimClockAck::Update(size_t index, double time) {
+    std_msgs::Header &ack = acks_.at(index);
+
+    if (time > ack.stamp.toSec() + kAckTolerance) {
+        ack.stamp = ros::Time(time);
+        updated_ = true;
+    }
+}
+
+void SimClockAck::Publish(void) {
+    const double wall_time = ros::WallTime::now().toSec();
+
+    if (!updated_ && wall_time - last_publish_wall_time_ < heartbeat_period_) {
+        return;
+    }
+
+    for (const std_msgs::Header &ack: acks_) {
+        pub_ack_.publish(ack);
+    }
+    updated_ = false;
+    last_publish_wall_time_ = wall_time;
+}
+
+} // namespace imu_integration
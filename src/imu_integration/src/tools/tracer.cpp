@@ -0,0 +1,147 @@
+/*
+ * @Description: scoped trace points exported in Chrome trace-event format
+ * @Date: 2026-10-18 10:12:41
+ */
+#include "imu_integration/tools/tracer.hpp"
+
+#include <unistd.h>
+#include <iomanip>
+
+#include "glog/logging.h"
+
+namespace imu_integration {
+
+std::atomic<bool> Tracer::enabled_{false};
+
+Tracer &Tracer::GetInstance(void) {
+    static Tracer tracer;
+    return tracer;
+}
+
+Tracer::~Tracer(void) {
+    Stop();
+}
+
+bool Tracer::Start(const std::string &file_path, double flush_period) {
+    std::unique_lock<std::mutex> lock(flush_mutex_);
+
+    if (running_) {
+        return true;
+    }
+
+    ofs_.open(file_path.c_str(), std::ios::out | std::ios::trunc);
+    if (!ofs_) {
+        LOG(WARNING) << "Failed to create trace file: " << file_path;
+        return false;
+    }
+    ofs_ << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+    is_first_event_ = true;
+
+    flush_period_ = flush_period;
+    running_ = true;
+    flush_thread_ = std::thread(&Tracer::FlushLoop, this);
+
+    enabled_.store(true, std::memory_order_relaxed);
+
+    return true;
+}
+
+void Tracer::Stop(void) {
+    {
+        std::unique_lock<std::mutex> lock(flush_mutex_);
+        if (!running_) {
+            return;
+        }
+        enabled_.store(false, std::memory_order_relaxed);
+        running_ = false;
+    }
+    flush_cond_.notify_all();
+    flush_thread_.join();
+
+    // drain events recorded before the trace points observed the disabled flag:
+    Flush();
+
+    uint64_t dropped = 0;
+    {
+        std::unique_lock<std::mutex> lock(buffers_mutex_);
+        for (const auto &buffer: buffers_) {
+            dropped += buffer->GetDropped();
+        }
+    }
+    if (dropped > 0) {
+        LOG(WARNING) << "Tracer dropped " << dropped << " events because of full buffers.";
+    }
+
+    ofs_ << "]}" << std::endl;
+    ofs_.close();
+}
+
+void Tracer::Record(const char *name, uint64_t begin_ns, uint64_t end_ns) {
+    TraceEvent event;
+    event.name = name;
+    event.begin_ns = begin_ns;
+    event.end_ns = end_ns;
+
+    GetThreadBuffer()->Push(event);
+}
+
+TraceBuffer *Tracer::GetThreadBuffer(void) {
+    static thread_local TraceBuffer *buffer = nullptr;
+
+    if (!buffer) {
+        std::unique_lock<std::mutex> lock(buffers_mutex_);
+        buffers_.emplace_back(new TraceBuffer(static_cast<uint32_t>(buffers_.size() + 1)));
+        buffer = buffers_.back().get();
+    }
+
+    return buffer;
+}
+
+void Tracer::FlushLoop(void) {
+    const auto period = std::chrono::duration<double>(flush_period_);
+
+    std::unique_lock<std::mutex> lock(flush_mutex_);
+    while (running_) {
+        flush_cond_.wait_for(lock, period);
+
+        lock.unlock();
+        Flush();
+        lock.lock();
+    }
+}
+
+void Tracer::Flush(void) {
+    // snapshot registered buffers, new threads may register concurrently:
+    std::vector<TraceBuffer *> buffers;
+    {
+        std::unique_lock<std::mutex> lock(buffers_mutex_);
+        for (const auto &buffer: buffers_) {
+            buffers.push_back(buffer.get());
+        }
+    }
+
+    const int pid = static_cast<int>(getpid());
+    for (TraceBuffer *buffer: buffers) {
+        scratch_.clear();
+        buffer->Drain(scratch_);
+
+        for (const TraceEvent &event: scratch_) {
+            if (!is_first_event_) {
+                ofs_ << ",";
+            }
+            is_first_event_ = false;
+
+            // complete event, timestamps in microseconds:
+            ofs_ << "\n{\"name\":\"" << event.name << "\""
+                 << ",\"cat\":\"imu_integration\",\"ph\":\"X\""
+                 << ",\"ts\":" << 1.0e-3 * event.begin_ns
+                 << ",\"dur\":" << 1.0e-3 * (event.end_ns - event.begin_ns)
+                 << ",\"pid\":" << pid
+                 << ",\"tid\":" << buffer->GetTid() << "}";
+        }
+    }
+
+    ofs_.flush();
+}
+
+} // namespace imu_integration
@@ -0,0 +1,365 @@
+/*
+ * @Description: World Magnetic Model spherical harmonic evaluation with a spatial cache
+ * @Date: 2026-10-18 10:32:08
+ */
+#include "imu_integration/tools/world_magnetic_model.hpp"
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+#include "glog/logging.h"
+
+namespace imu_integration {
+
+namespace {
+
+// WGS-84 ellipsoid and geomagnetic reference radius in kilometers:
+const double kSemiMajorAxis = 6378.137;
+const double kSemiMinorAxis = 6356.7523142;
+const double kReferenceRadius = 6371.2;
+
+// mean earth radius in meters, for cache distances and local to geodetic coordinates:
+const double kEarthRadius = 6371.0e3;
+const double kSecondsPerYear = 365.25 * 86400.0;
+
+// gnss_ins_sim/geoparams/WMM.COF:
+const char *kWMM2015 =
+    "    2015.0            WMM-2015        12/15/2014\n"
+    "  1  0  -29438.5       0.0       10.7        0.0\n"
+    "  1  1   -1501.1    4796.2       17.9      -26.8\n"
+    "  2  0   -2445.3       0.0       -8.6        0.0\n"
+    "  2  1    3012.5   -2845.6       -3.3      -27.1\n"
+    "  2  2    1676.6    -642.0        2.4      -13.3\n"
+    "  3  0    1351.1       0.0        3.1        0.0\n"
+    "  3  1   -2352.3    -115.3       -6.2        8.4\n"
+    "  3  2    1225.6     245.0       -0.4       -0.4\n"
+    "  3  3     581.9    -538.3      -10.4        2.3\n"
+    "  4  0     907.2       0.0       -0.4        0.0\n"
+    "  4  1     813.7     283.4        0.8       -0.6\n"
+    "  4  2     120.3    -188.6       -9.2        5.3\n"
+    "  4  3    -335.0     180.9        4.0        3.0\n"
+    "  4  4      70.3    -329.5       -4.2       -5.3\n"
+    "  5  0    -232.6       0.0       -0.2        0.0\n"
+    "  5  1     360.1      47.4        0.1        0.4\n"
+    "  5  2     192.4     196.9       -1.4        1.6\n"
+    "  5  3    -141.0    -119.4        0.0       -1.1\n"
+    "  5  4    -157.4      16.1        1.3        3.3\n"
+    "  5  5       4.3     100.1        3.8        0.1\n"
+    "  6  0      69.5       0.0       -0.5        0.0\n"
+    "  6  1      67.4     -20.7       -0.2        0.0\n"
+    "  6  2      72.8      33.2       -0.6       -2.2\n"
+    "  6  3    -129.8      58.8        2.4       -0.7\n"
+    "  6  4     -29.0     -66.5       -1.1        0.1\n"
+    "  6  5      13.2       7.3        0.3        1.0\n"
+    "  6  6     -70.9      62.5        1.5        1.3\n"
+    "  7  0      81.6       0.0        0.2        0.0\n"
+    "  7  1     -76.1     -54.1       -0.2        0.7\n"
+    "  7  2      -6.8     -19.4       -0.4        0.5\n"
+    "  7  3      51.9       5.6        1.3       -0.2\n"
+    "  7  4      15.0      24.4        0.2       -0.1\n"
+    "  7  5       9.3       3.3       -0.4       -0.7\n"
+    "  7  6      -2.8     -27.5       -0.9        0.1\n"
+    "  7  7       6.7      -2.3        0.3        0.1\n"
+    "  8  0      24.0       0.0        0.0        0.0\n"
+    "  8  1       8.6      10.2        0.1       -0.3\n"
+    "  8  2     -16.9     -18.1       -0.5        0.3\n"
+    "  8  3      -3.2      13.2        0.5        0.3\n"
+    "  8  4     -20.6     -14.6       -0.2        0.6\n"
+    "  8  5      13.3      16.2        0.4       -0.1\n"
+    "  8  6      11.7       5.7        0.2       -0.2\n"
+    "  8  7     -16.0      -9.1       -0.4        0.3\n"
+    "  8  8      -2.0       2.2        0.3        0.0\n"
+    "  9  0       5.4       0.0        0.0        0.0\n"
+    "  9  1       8.8     -21.6       -0.1       -0.2\n"
+    "  9  2       3.1      10.8       -0.1       -0.1\n"
+    "  9  3      -3.1      11.7        0.4       -0.2\n"
+    "  9  4       0.6      -6.8       -0.5        0.1\n"
+    "  9  5     -13.3      -6.9       -0.2        0.1\n"
+    "  9  6      -0.1       7.8        0.1        0.0\n"
+    "  9  7       8.7       1.0        0.0       -0.2\n"
+    "  9  8      -9.1      -3.9       -0.2        0.4\n"
+    "  9  9     -10.5       8.5       -0.1        0.3\n"
+    " 10  0      -1.9       0.0        0.0        0.0\n"
+    " 10  1      -6.5       3.3        0.0        0.1\n"
+    " 10  2       0.2      -0.3       -0.1       -0.1\n"
+    " 10  3       0.6       4.6        0.3        0.0\n"
+    " 10  4      -0.6       4.4       -0.1        0.0\n"
+    " 10  5       1.7      -7.9       -0.1       -0.2\n"
+    " 10  6      -0.7      -0.6       -0.1        0.1\n"
+    " 10  7       2.1      -4.1        0.0       -0.1\n"
+    " 10  8       2.3      -2.8       -0.2       -0.2\n"
+    " 10  9      -1.8      -1.1       -0.1        0.1\n"
+    " 10 10      -3.6      -8.7       -0.2       -0.1\n"
+    " 11  0       3.1       0.0        0.0        0.0\n"
+    " 11  1      -1.5      -0.1        0.0        0.0\n"
+    " 11  2      -2.3       2.1       -0.1        0.1\n"
+    " 11  3       2.1      -0.7        0.1        0.0\n"
+    " 11  4      -0.9      -1.1        0.0        0.1\n"
+    " 11  5       0.6       0.7        0.0        0.0\n"
+    " 11  6      -0.7      -0.2        0.0        0.0\n"
+    " 11  7       0.2      -2.1        0.0        0.1\n"
+    " 11  8       1.7      -1.5        0.0        0.0\n"
+    " 11  9      -0.2      -2.5        0.0       -0.1\n"
+    " 11 10       0.4      -2.0       -0.1        0.0\n"
+    " 11 11       3.5      -2.3       -0.1       -0.1\n"
+    " 12  0      -2.0       0.0        0.1        0.0\n"
+    " 12  1      -0.3      -1.0        0.0        0.0\n"
+    " 12  2       0.4       0.5        0.0        0.0\n"
+    " 12  3       1.3       1.8        0.1       -0.1\n"
+    " 12  4      -0.9      -2.2       -0.1        0.0\n"
+    " 12  5       0.9       0.3        0.0        0.0\n"
+    " 12  6       0.1       0.7        0.1        0.0\n"
+    " 12  7       0.5      -0.1        0.0        0.0\n"
+    " 12  8      -0.4       0.3        0.0        0.0\n"
+    " 12  9      -0.4       0.2        0.0        0.0\n"
+    " 12 10       0.2      -0.9        0.0        0.0\n"
+    " 12 11      -0.9      -0.2        0.0        0.0\n"
+    " 12 12       0.0       0.7        0.0        0.0\n"
+    "999999999999999999999999999999999999999999999999\n";
+
+} // namespace
+
+WorldMagneticModel::WorldMagneticModel(void) {
+    std::istringstream cof(kWMM2015);
+    Load(cof);
+}
+
+bool WorldMagneticModel::Load(const std::string &cof_path) {
+    std::ifstream cof(cof_path);
+    if (!cof) {
+        LOG(WARNING) << "Cannot open magnetic model coefficients " << cof_path;
+        return false;
+    }
+
+    if (!Load(cof)) {
+        LOG(WARNING) << "Invalid magnetic model coefficients " << cof_path;
+        return false;
+    }
+
+    LOG(INFO) << "Loaded magnetic model " << name_ << ", epoch " << epoch_;
+
+    return true;
+}
+
+bool WorldMagneticModel::Load(std::istream &cof) {
+    std::string name;
+    double epoch = 0.0;
+    double g[kMaxDegree + 1][kMaxDegree + 1] = {};
+    double h[kMaxDegree + 1][kMaxDegree + 1] = {};
+    double dg[kMaxDegree + 1][kMaxDegree + 1] = {};
+    double dh[kMaxDegree + 1][kMaxDegree + 1] = {};
+
+    // header, epoch model release date:
+    std::string line;
+    if (!std::getline(cof, line)) {
+        return false;
+    }
+    std::istringstream header(line);
+    if (!(header >> epoch >> name)) {
+        return false;
+    }
+
+    // n m g h dg dh per line, terminated by a line of 9s:
+    int num_coeffs = 0;
+    while (std::getline(cof, line)) {
+        std::istringstream coeffs(line);
+        int n, m;
+        double g_nm, h_nm, dg_nm, dh_nm;
+        if (!(coeffs >> n >> m >> g_nm >> h_nm >> dg_nm >> dh_nm)) {
+            break;
+        }
+        if (n < 1 || n > kMaxDegree || m < 0 || m > n) {
+            return false;
+        }
+
+        g[n][m] = g_nm;
+        h[n][m] = h_nm;
+        dg[n][m] = dg_nm;
+        dh[n][m] = dh_nm;
+        ++num_coeffs;
+    }
+    if (0 == num_coeffs) {
+        return false;
+    }
+
+    name_ = name;
+    epoch_ = epoch;
+
+    // Schmidt semi-normalized to unnormalized:
+    double snorm[kMaxDegree + 1][kMaxDegree + 1] = {};
+    snorm[0][0] = 1.0;
+    for (int n = 0; n <= kMaxDegree; ++n) {
+        if (n > 0) {
+            snorm[n][0] = snorm[n - 1][0] * (2.0 * n - 1.0) / n;
+        }
+        for (int m = 0; m <= n; ++m) {
+            if (m > 0) {
+                const double j = (1 == m) ? 2.0 : 1.0;
+                snorm[n][m] = snorm[n][m - 1] * std::sqrt((n - m + 1.0) * j / (n + m));
+            }
+
+            g_[n][m] = snorm[n][m] * g[n][m];
+            h_[n][m] = snorm[n][m] * h[n][m];
+            dg_[n][m] = snorm[n][m] * dg[n][m];
+            dh_[n][m] = snorm[n][m] * dh[n][m];
+
+            k_[n][m] = (n > 1) ? ((n - 1.0) * (n - 1.0) - m * m) / ((2.0 * n - 1.0) * (2.0 * n - 3.0)) : 0.0;
+        }
+    }
+
+    return true;
+}
+
+Eigen::Vector3d WorldMagneticModel::Evaluate(
+    double latitude, double longitude, double altitude, double decimal_year
+) const {
+    const double dt = decimal_year - epoch_;
+    const double alt = 1.0e-3 * altitude;
+
+    const double srlat = std::sin(latitude * M_PI / 180.0);
+    const double crlat = std::cos(latitude * M_PI / 180.0);
+    const double srlat2 = srlat * srlat;
+    const double crlat2 = crlat * crlat;
+
+    // geodetic to geocentric spherical, co-latitude theta and radius r:
+    const double a2 = kSemiMajorAxis * kSemiMajorAxis;
+    const double b2 = kSemiMinorAxis * kSemiMinorAxis;
+    const double c2 = a2 - b2;
+    const double c4 = a2 * a2 - b2 * b2;
+    const double q = std::sqrt(a2 - c2 * srlat2);
+    const double q1 = alt * q;
+    const double q2 = ((q1 + a2) / (q1 + b2)) * ((q1 + a2) / (q1 + b2));
+    const double ct = srlat / std::sqrt(q2 * crlat2 + srlat2);
+    const double st = std::sqrt(1.0 - ct * ct);
+    const double r = std::sqrt(alt * alt + 2.0 * q1 + (a2 * a2 - c4 * srlat2) / (q * q));
+    const double d = std::sqrt(a2 * crlat2 + b2 * srlat2);
+    const double ca = (alt + d) / r;
+    const double sa = c2 * crlat * srlat / (r * d);
+
+    // sin(m * lon) and cos(m * lon):
+    double sp[kMaxDegree + 1], cp[kMaxDegree + 1];
+    sp[0] = 0.0;
+    cp[0] = 1.0;
+    sp[1] = std::sin(longitude * M_PI / 180.0);
+    cp[1] = std::cos(longitude * M_PI / 180.0);
+    for (int m = 2; m <= kMaxDegree; ++m) {
+        sp[m] = sp[1] * cp[m - 1] + cp[1] * sp[m - 1];
+        cp[m] = cp[1] * cp[m - 1] - sp[1] * sp[m - 1];
+    }
+
+    // unnormalized associated Legendre functions and derivatives w.r.t. theta:
+    double p[kMaxDegree + 1][kMaxDegree + 1] = {};
+    double dp[kMaxDegree + 1][kMaxDegree + 1] = {};
+    p[0][0] = 1.0;
+    // at the geographic poles, where the east component needs the limit of P(n, 1) / sin(theta):
+    double pp[kMaxDegree + 1];
+    pp[0] = 1.0;
+
+    const double aor = kReferenceRadius / r;
+    double ar = aor * aor;
+    double br = 0.0, bt = 0.0, bp = 0.0, bpp = 0.0;
+    for (int n = 1; n <= kMaxDegree; ++n) {
+        ar *= aor;
+
+        for (int m = 0; m <= n; ++m) {
+            if (n == m) {
+                p[n][m] = st * p[n - 1][m - 1];
+                dp[n][m] = st * dp[n - 1][m - 1] + ct * p[n - 1][m - 1];
+            } else if (1 == n) {
+                p[n][m] = ct * p[n - 1][m];
+                dp[n][m] = ct * dp[n - 1][m] - st * p[n - 1][m];
+            } else {
+                // P(n - 2, m) vanishes for m > n - 2:
+                const double p2 = (m > n - 2) ? 0.0 : p[n - 2][m];
+                const double dp2 = (m > n - 2) ? 0.0 : dp[n - 2][m];
+                p[n][m] = ct * p[n - 1][m] - k_[n][m] * p2;
+                dp[n][m] = ct * dp[n - 1][m] - st * p[n - 1][m] - k_[n][m] * dp2;
+            }
+
+            // time adjusted Gauss coefficients:
+            const double g = g_[n][m] + dt * dg_[n][m];
+            const double h = h_[n][m] + dt * dh_[n][m];
+
+            const double par = ar * p[n][m];
+            const double temp1 = g * cp[m] + h * sp[m];
+            const double temp2 = g * sp[m] - h * cp[m];
+
+            bt -= ar * temp1 * dp[n][m];
+            bp += m * temp2 * par;
+            br += (n + 1) * temp1 * par;
+
+            if (0.0 == st && 1 == m) {
+                pp[n] = (1 == n) ? pp[n - 1] : ct * pp[n - 1] - k_[n][m] * pp[n - 2];
+                bpp += m * temp2 * ar * pp[n];
+            }
+        }
+    }
+    bp = (0.0 == st) ? bpp : bp / st;
+
+    // spherical to geodetic north, east and down:
+    return Eigen::Vector3d(
+        -bt * ca - br * sa,
+        bp,
+        bt * sa - br * ca
+    );
+}
+
+MagneticFieldCache::MagneticFieldCache(
+    const WorldMagneticModel &model,
+    const Params &params
+) : model_(model), params_(params) {}
+
+const Eigen::Vector3d &MagneticFieldCache::GetField(
+    double latitude, double longitude, double altitude, double decimal_year
+) {
+    if (valid_) {
+        const double north = (latitude - latitude_) * M_PI / 180.0 * kEarthRadius;
+        const double east = (longitude - longitude_) * M_PI / 180.0 * kEarthRadius * cos_latitude_;
+
+        if (
+            north * north + east * east <= params_.max_distance * params_.max_distance &&
+            std::fabs(altitude - altitude_) <= params_.max_distance &&
+            std::fabs(decimal_year - decimal_year_) <= params_.max_time
+        ) {
+            num_hits_.Add();
+            return field_;
+        }
+    }
+
+    field_ = model_.Evaluate(latitude, longitude, altitude, decimal_year);
+    latitude_ = latitude;
+    cos_latitude_ = std::cos(latitude * M_PI / 180.0);
+    longitude_ = longitude;
+    altitude_ = altitude;
+    decimal_year_ = decimal_year;
+    valid_ = true;
+
+    num_evaluations_.Add();
+
+    return field_;
+}
+
+LocalMagneticField::LocalMagneticField(const Params &params)
+    : params_(params), cache_(model_, params.cache) {
+    if (!params_.cof_file.empty() && !model_.Load(params_.cof_file)) {
+        LOG(WARNING) << "Falling back to built-in magnetic model " << model_.GetName();
+    }
+}
+
+Eigen::Vector3d LocalMagneticField::GetField(const Eigen::Vector3d &position, double time) {
+    // spherical earth is accurate to well within cache distance over a local trajectory:
+    const double latitude = params_.latitude + position.y() / kEarthRadius * 180.0 / M_PI;
+    const double longitude = params_.longitude + position.x() / (
+        kEarthRadius * std::cos(params_.latitude * M_PI / 180.0)
+    ) * 180.0 / M_PI;
+    const double altitude = params_.altitude + position.z();
+    const double decimal_year = params_.decimal_year + time / kSecondsPerYear;
+
+    const Eigen::Vector3d &field_ned = cache_.GetField(latitude, longitude, altitude, decimal_year);
+
+    // north, east, down in nanotesla to east, north, up in tesla:
+    return 1.0e-9 * Eigen::Vector3d(field_ned.y(), field_ned.x(), -field_ned.z());
+}
+
+} // namespace imu_integration
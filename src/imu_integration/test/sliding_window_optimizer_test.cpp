@@ -0,0 +1,55 @@
+/*
+ * @Description: sliding window optimizer regression tests
+ * @Date: 2026-10-18 10:12:40
+ */
+#include <gtest/gtest.h>
+
+#include "imu_integration/estimator/sliding_window_optimizer.hpp"
+
+using namespace imu_integration;
+using namespace imu_integration::estimator;
+
+namespace {
+
+// stationary body, IMU and poses both at 100 Hz from the same start, as published by the generator:
+TEST(SlidingWindowOptimizer, EqualIMUAndPoseStamps) {
+    SlidingWindowOptimizer::Params params;
+    params.keyframe_period = 0.0;
+    params.window_size = 5;
+    SlidingWindowOptimizer optimizer(params);
+
+    size_t num_updates = 0;
+    for (int k = 0; k < 200; ++k) {
+        const double time = 0.01 * k;
+
+        IMUData imu_data;
+        imu_data.time = time;
+        imu_data.angular_velocity = Eigen::Vector3d::Zero();
+        imu_data.linear_acceleration = params.gravity;
+
+        OdomData odom_data;
+        odom_data.time = time;
+        odom_data.pose = Eigen::Matrix4d::Identity();
+        odom_data.vel = Eigen::Vector3d::Zero();
+
+        optimizer.AddIMUData(imu_data);
+        optimizer.AddPose(odom_data);
+        if (optimizer.Update()) {
+            ++num_updates;
+        }
+    }
+
+    // every pose but the last becomes a keyframe once the next IMU measurement arrives:
+    EXPECT_EQ(199u, num_updates);
+    ASSERT_TRUE(optimizer.HasKeyframe());
+
+    const SlidingWindowOptimizer::Keyframe &keyframe = optimizer.GetLatestKeyframe();
+    EXPECT_NEAR(1.98, keyframe.time, 1.0e-9);
+    EXPECT_TRUE(keyframe.R.allFinite());
+    EXPECT_TRUE(keyframe.t.allFinite());
+    EXPECT_TRUE(keyframe.v.allFinite());
+    EXPECT_LT(keyframe.t.norm(), 1.0e-6);
+    EXPECT_LT(keyframe.v.norm(), 1.0e-6);
+}
+
+} // namespace
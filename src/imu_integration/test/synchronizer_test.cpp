@@ -0,0 +1,205 @@
+/*
+ * @Description: approximate time synchronizer matching and drop tests
+ * @Date: 2026-10-18 19:26:51
+ */
+#include <algorithm>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "imu_integration/sensor_data/synchronizer.hpp"
+
+using namespace imu_integration;
+
+namespace {
+
+// values linear in time, so any bracket interpolates to the exact value at the reference stamp:
+template <int Slope>
+struct Sample {
+    double time = 0.0;
+    double value = 0.0;
+
+    static double GetValue(double time) { return Slope * time + 1.0; }
+
+    static Sample Interpolate(const Sample &front, const Sample &back, double time) {
+        Sample sample;
+        sample.time = time;
+        if (back.time == front.time) {
+            sample.value = front.value;
+        } else {
+            const double s = (time - front.time) / (back.time - front.time);
+            sample.value = (1.0 - s) * front.value + s * back.value;
+        }
+        return sample;
+    }
+};
+
+typedef Sample<0> Reference;
+typedef Sample<2> StreamA;
+typedef Sample<-3> StreamB;
+typedef ApproximateTimeSynchronizer<Reference, StreamA, StreamB> Synchronizer;
+
+const double kMaxGap = 0.05;
+const double kMaxLatency = 0.1;
+
+template <typename T>
+std::vector<T> GetStream(double start, double end, double period, double jitter, std::mt19937 &engine) {
+    std::uniform_real_distribution<double> distribution(-jitter, jitter);
+
+    std::vector<T> samples;
+    for (double time = start; time < end; time += period) {
+        T sample;
+        sample.time = time + distribution(engine);
+        sample.value = T::GetValue(sample.time);
+        samples.push_back(sample);
+    }
+    return samples;
+}
+
+template <typename T>
+void EraseRange(std::vector<T> &samples, double start, double end) {
+    samples.erase(
+        std::remove_if(
+            samples.begin(), samples.end(),
+            [start, end](const T &sample) { return sample.time > start && sample.time < end; }
+        ),
+        samples.end()
+    );
+}
+
+// whether the whole stream, once received, brackets time within max gap:
+template <typename T>
+bool IsBracketed(const std::vector<T> &samples, double time) {
+    for (size_t i = 0; i < samples.size(); ++i) {
+        if (samples.at(i).time == time) {
+            return true;
+        }
+        if (i > 0 && samples.at(i - 1).time < time && samples.at(i).time > time) {
+            return time - samples.at(i - 1).time <= kMaxGap && samples.at(i).time - time <= kMaxGap;
+        }
+    }
+    return false;
+}
+
+struct Event {
+    double arrival_time;
+    int channel;
+    size_t index;
+};
+
+// reference at 100 Hz, stream A at 30 Hz arriving late, stream B at 50 Hz with a gap:
+TEST(ApproximateTimeSynchronizer, InterleavedJitteredStreams) {
+    std::mt19937 engine(42);
+    const std::vector<Reference> references = GetStream<Reference>(0.0, 2.0, 0.01, 0.002, engine);
+    const std::vector<StreamA> stream_a = GetStream<StreamA>(0.02, 2.2, 1.0 / 30.0, 0.003, engine);
+    std::vector<StreamB> stream_b = GetStream<StreamB>(0.0, 2.2, 0.02, 0.002, engine);
+    EraseRange(stream_b, 1.0, 1.2);
+
+    // delivery order, each channel with its own transport delay:
+    std::vector<Event> events;
+    for (size_t i = 0; i < references.size(); ++i) {
+        events.push_back(Event{references.at(i).time + 0.002, 0, i});
+    }
+    for (size_t i = 0; i < stream_a.size(); ++i) {
+        events.push_back(Event{stream_a.at(i).time + 0.015, 1, i});
+    }
+    for (size_t i = 0; i < stream_b.size(); ++i) {
+        events.push_back(Event{stream_b.at(i).time + 0.005, 2, i});
+    }
+    std::stable_sort(
+        events.begin(), events.end(),
+        [](const Event &a, const Event &b) { return a.arrival_time < b.arrival_time; }
+    );
+
+    Synchronizer synchronizer(1000, kMaxGap, kMaxLatency);
+    std::vector<Synchronizer::Synced> emitted;
+    for (const Event &event: events) {
+        switch (event.channel) {
+            case 0: synchronizer.AddReference(references.at(event.index)); break;
+            case 1: synchronizer.Add<0>(stream_a.at(event.index)); break;
+            default: synchronizer.Add<1>(stream_b.at(event.index)); break;
+        }
+
+        Synchronizer::Synced synced;
+        while (synchronizer.Pop(synced)) {
+            emitted.push_back(synced);
+        }
+    }
+
+    // emitted in order, exactly the references both streams bracket within max gap:
+    std::vector<double> expected;
+    for (const Reference &reference: references) {
+        if (IsBracketed(stream_a, reference.time) && IsBracketed(stream_b, reference.time)) {
+            expected.push_back(reference.time);
+        }
+    }
+
+    ASSERT_EQ(expected.size(), emitted.size());
+    for (size_t i = 0; i < emitted.size(); ++i) {
+        const double time = std::get<0>(emitted.at(i)).time;
+        EXPECT_EQ(expected.at(i), time);
+        EXPECT_NEAR(StreamA::GetValue(time), std::get<1>(emitted.at(i)).value, 1.0e-9);
+        EXPECT_NEAR(StreamB::GetValue(time), std::get<2>(emitted.at(i)).value, 1.0e-9);
+    }
+
+    // the start before stream A and the gap in stream B are dropped, nothing else is lost:
+    EXPECT_GT(references.size() - expected.size(), 20u);
+    EXPECT_EQ(expected.size(), synchronizer.GetNumSynced());
+    EXPECT_EQ(references.size() - expected.size(), synchronizer.GetNumDropped());
+    EXPECT_EQ(0u, synchronizer.GetNumOverwritten());
+}
+
+TEST(ApproximateTimeSynchronizer, WaitsThenDropsOnLatency) {
+    typedef ApproximateTimeSynchronizer<Reference, StreamA> PairSynchronizer;
+    PairSynchronizer synchronizer(100, kMaxGap, kMaxLatency);
+    PairSynchronizer::Synced synced;
+
+    StreamA sample;
+    sample.time = 0.0;
+    synchronizer.Add<0>(sample);
+
+    // not bracketed yet, waits within max latency:
+    Reference reference;
+    reference.time = 0.01;
+    synchronizer.AddReference(reference);
+    reference.time = 0.1;
+    synchronizer.AddReference(reference);
+    EXPECT_FALSE(synchronizer.Pop(synced));
+    EXPECT_EQ(0u, synchronizer.GetNumDropped());
+
+    // the stream stays silent past max latency, the oldest reference is given up:
+    reference.time = 0.12;
+    synchronizer.AddReference(reference);
+    EXPECT_FALSE(synchronizer.Pop(synced));
+    EXPECT_EQ(1u, synchronizer.GetNumDropped());
+
+    // an exact stamp match needs no later measurement:
+    sample.time = 0.1;
+    sample.value = 7.0;
+    synchronizer.Add<0>(sample);
+    ASSERT_TRUE(synchronizer.Pop(synced));
+    EXPECT_EQ(0.1, std::get<0>(synced).time);
+    EXPECT_EQ(7.0, std::get<1>(synced).value);
+    EXPECT_FALSE(synchronizer.Pop(synced));
+    EXPECT_EQ(1u, synchronizer.GetNumSynced());
+}
+
+TEST(ApproximateTimeSynchronizer, CountsOverwrittenAndOutOfOrder) {
+    typedef ApproximateTimeSynchronizer<Reference, StreamA> PairSynchronizer;
+    PairSynchronizer synchronizer(4, kMaxGap, kMaxLatency);
+
+    StreamA sample;
+    for (int i = 0; i < 6; ++i) {
+        sample.time = 0.01 * i;
+        synchronizer.Add<0>(sample);
+    }
+    EXPECT_EQ(2u, synchronizer.GetNumOverwritten());
+
+    sample.time = 0.0;
+    synchronizer.Add<0>(sample);
+    EXPECT_EQ(3u, synchronizer.GetNumOverwritten());
+}
+
+} // namespace
@@ -0,0 +1,189 @@
+/*
+ * @Description: wire format decoding and pre-serialized odometry against the stock roscpp serializer
+ * @Date: 2026-10-18 19:02:14
+ */
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <ros/serialization.h>
+#include <nav_msgs/Odometry.h>
+#include <sensor_msgs/Imu.h>
+
+#include "imu_integration/subscriber/wire_format.hpp"
+#include "imu_integration/publisher/odom_publisher.hpp"
+
+using namespace imu_integration;
+
+namespace {
+
+template <typename M>
+std::vector<uint8_t> Serialize(const M &message) {
+    std::vector<uint8_t> buffer(ros::serialization::serializationLength(message));
+    ros::serialization::OStream stream(buffer.data(), static_cast<uint32_t>(buffer.size()));
+    ros::serialization::serialize(stream, message);
+
+    return buffer;
+}
+
+template <typename M>
+void Deserialize(std::vector<uint8_t> &buffer, M &message) {
+    ros::serialization::IStream stream(buffer.data(), static_cast<uint32_t>(buffer.size()));
+    ros::serialization::deserialize(stream, message);
+}
+
+Eigen::Matrix4d GetPose(double yaw, const Eigen::Vector3d &t) {
+    Eigen::Matrix4d pose = Eigen::Matrix4d::Identity();
+    pose.block<3, 3>(0, 0) = (
+        Eigen::AngleAxisd(yaw, Eigen::Vector3d::UnitZ()) *
+        Eigen::AngleAxisd(0.1, Eigen::Vector3d::UnitY()) *
+        Eigen::AngleAxisd(-0.2, Eigen::Vector3d::UnitX())
+    ).toRotationMatrix();
+    pose.block<3, 1>(0, 3) = t;
+
+    return pose;
+}
+
+// the message OdomPublisher is meant to put on the wire, zero angular velocity and covariances:
+nav_msgs::Odometry GetOdometry(
+    uint32_t seq, const ros::Time &stamp,
+    const std::string &frame_id, const std::string &child_frame_id,
+    const Eigen::Matrix4d &pose, const Eigen::Vector3d &vel
+) {
+    nav_msgs::Odometry message;
+
+    message.header.seq = seq;
+    message.header.stamp = stamp;
+    message.header.frame_id = frame_id;
+    message.child_frame_id = child_frame_id;
+
+    const Eigen::Quaterniond q(pose.block<3, 3>(0, 0));
+    message.pose.pose.position.x = pose(0, 3);
+    message.pose.pose.position.y = pose(1, 3);
+    message.pose.pose.position.z = pose(2, 3);
+    message.pose.pose.orientation.x = q.x();
+    message.pose.pose.orientation.y = q.y();
+    message.pose.pose.orientation.z = q.z();
+    message.pose.pose.orientation.w = q.w();
+
+    message.twist.twist.linear.x = vel.x();
+    message.twist.twist.linear.y = vel.y();
+    message.twist.twist.linear.z = vel.z();
+    message.twist.twist.angular.x = message.twist.twist.angular.y = message.twist.twist.angular.z = 0.0;
+
+    message.pose.covariance.fill(0.0);
+    message.twist.covariance.fill(0.0);
+
+    return message;
+}
+
+TEST(SerializedOdometry, MatchesStockSerializer) {
+    SerializedOdometry serialized;
+    serialized.Init("inertial", "imu_link");
+
+    // patched twice, the second patch must fully overwrite the first:
+    const Eigen::Matrix4d pose_0 = GetPose(0.3, Eigen::Vector3d(1.0, -2.0, 0.5));
+    const Eigen::Vector3d vel_0(0.4, -1.2, 0.05);
+    serialized.Patch(0, ros::Time(100, 250000000), pose_0, vel_0);
+
+    const Eigen::Matrix4d pose_1 = GetPose(-2.1, Eigen::Vector3d(-30.0, 7.5, 0.0));
+    const Eigen::Vector3d vel_1(-3.0, 0.2, 0.0);
+    serialized.Patch(1, ros::Time(100, 260000000), pose_1, vel_1);
+
+    const nav_msgs::Odometry message = GetOdometry(
+        1, ros::Time(100, 260000000), "inertial", "imu_link", pose_1, vel_1
+    );
+
+    EXPECT_EQ(
+        ros::serialization::serializationLength(message),
+        ros::serialization::serializationLength(serialized)
+    );
+    EXPECT_EQ(Serialize(message), Serialize(serialized));
+}
+
+TEST(SerializedOdometry, EmptyChildFrameId) {
+    SerializedOdometry serialized;
+    serialized.Init("map", "");
+
+    const Eigen::Matrix4d pose = GetPose(1.0, Eigen::Vector3d(0.1, 0.2, 0.3));
+    const Eigen::Vector3d vel(1.0, 2.0, 3.0);
+    serialized.Patch(7, ros::Time(1, 1), pose, vel);
+
+    const nav_msgs::Odometry message = GetOdometry(7, ros::Time(1, 1), "map", "", pose, vel);
+
+    EXPECT_EQ(
+        ros::serialization::serializationLength(message),
+        ros::serialization::serializationLength(serialized)
+    );
+    EXPECT_EQ(Serialize(message), Serialize(serialized));
+}
+
+TEST(SerializedOdometry, AnnouncesOdometry) {
+    EXPECT_EQ(
+        std::string(ros::message_traits::MD5Sum<nav_msgs::Odometry>::value()),
+        std::string(ros::message_traits::MD5Sum<SerializedOdometry>::value())
+    );
+    EXPECT_EQ(
+        std::string(ros::message_traits::DataType<nav_msgs::Odometry>::value()),
+        std::string(ros::message_traits::DataType<SerializedOdometry>::value())
+    );
+}
+
+// every skipped field set, so that a wrong skip shows up as a wrong decoded value:
+TEST(WireFormat, DecodeOdometry) {
+    const Eigen::Matrix4d pose = GetPose(0.7, Eigen::Vector3d(3.0, -4.0, 1.5));
+    const Eigen::Vector3d vel(0.5, -0.25, 0.125);
+
+    nav_msgs::Odometry message = GetOdometry(
+        3, ros::Time(42, 500000000), "inertial", "base_link_with_a_long_name", pose, vel
+    );
+    message.twist.twist.angular.x = 9.0;
+    message.twist.twist.angular.y = -9.0;
+    message.twist.twist.angular.z = 0.9;
+    for (size_t i = 0; i < message.pose.covariance.size(); ++i) {
+        message.pose.covariance[i] = 0.1 * i;
+        message.twist.covariance[i] = -0.1 * i;
+    }
+
+    std::vector<uint8_t> buffer = Serialize(message);
+    OdomData odom_data;
+    Deserialize(buffer, odom_data);
+
+    EXPECT_DOUBLE_EQ(42.5, odom_data.time);
+    EXPECT_TRUE(odom_data.pose.isApprox(pose, 1.0e-12));
+    EXPECT_TRUE(odom_data.vel.isApprox(vel, 1.0e-12));
+}
+
+TEST(WireFormat, DecodeIMU) {
+    sensor_msgs::Imu message;
+    message.header.seq = 11;
+    message.header.stamp = ros::Time(7, 10000000);
+    message.header.frame_id = "imu_link";
+    message.orientation.x = 0.5;
+    message.orientation.y = -0.5;
+    message.orientation.z = 0.5;
+    message.orientation.w = -0.5;
+    message.angular_velocity.x = 0.01;
+    message.angular_velocity.y = -0.02;
+    message.angular_velocity.z = 0.03;
+    message.linear_acceleration.x = 0.1;
+    message.linear_acceleration.y = 0.2;
+    message.linear_acceleration.z = 9.7942164704;
+    for (size_t i = 0; i < 9; ++i) {
+        message.orientation_covariance[i] = 1.0 + i;
+        message.angular_velocity_covariance[i] = 2.0 + i;
+        message.linear_acceleration_covariance[i] = 3.0 + i;
+    }
+
+    std::vector<uint8_t> buffer = Serialize(message);
+    IMUData imu_data;
+    Deserialize(buffer, imu_data);
+
+    EXPECT_DOUBLE_EQ(7.01, imu_data.time);
+    EXPECT_EQ(Eigen::Vector3d(0.01, -0.02, 0.03), imu_data.angular_velocity);
+    EXPECT_EQ(Eigen::Vector3d(0.1, 0.2, 9.7942164704), imu_data.linear_acceleration);
+}
+
+} // namespace